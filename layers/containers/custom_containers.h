@@ -23,6 +23,7 @@
 #include <cassert>
 #include <algorithm>
 #include <iterator>
+#include <memory>
 #include <utility>
 
 #ifdef USE_CUSTOM_HASH_MAP
@@ -43,11 +44,13 @@ namespace vvl {
 template <typename T>
 using hash = phmap::Hash<T>;
 
-template <typename Key, typename Hash = phmap::Hash<Key>, typename KeyEqual = std::equal_to<Key>>
-using unordered_set = phmap::flat_hash_set<Key, Hash, KeyEqual>;
+template <typename Key, typename Hash = phmap::Hash<Key>, typename KeyEqual = std::equal_to<Key>,
+          typename Allocator = std::allocator<Key>>
+using unordered_set = phmap::flat_hash_set<Key, Hash, KeyEqual, Allocator>;
 
-template <typename Key, typename T, typename Hash = phmap::Hash<Key>, typename KeyEqual = std::equal_to<Key>>
-using unordered_map = phmap::flat_hash_map<Key, T, Hash, KeyEqual>;
+template <typename Key, typename T, typename Hash = phmap::Hash<Key>, typename KeyEqual = std::equal_to<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, T>>>
+using unordered_map = phmap::flat_hash_map<Key, T, Hash, KeyEqual, Allocator>;
 
 template <typename Key, typename T>
 using map_entry = phmap::Pair<Key, T>;
@@ -56,11 +59,13 @@ using map_entry = phmap::Pair<Key, T>;
 template <typename T>
 using hash = std::hash<T>;
 
-template <typename Key, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
-using unordered_set = std::unordered_set<Key, Hash, KeyEqual>;
+template <typename Key, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>,
+          typename Allocator = std::allocator<Key>>
+using unordered_set = std::unordered_set<Key, Hash, KeyEqual, Allocator>;
 
-template <typename Key, typename T, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
-using unordered_map = std::unordered_map<Key, T, Hash, KeyEqual>;
+template <typename Key, typename T, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, T>>>
+using unordered_map = std::unordered_map<Key, T, Hash, KeyEqual, Allocator>;
 
 template <typename Key, typename T>
 using map_entry = std::pair<Key, T>;
@@ -0,0 +1,169 @@
+/* Copyright (c) 2025 The Khronos Group Inc.
+ * Copyright (c) 2025 Valve Corporation
+ * Copyright (c) 2025 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <cassert>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace vvl {
+
+// A type-erased callable, like std::function, with an inline store large enough for the callbacks recorded into command
+// buffers (a few handles, a Location and a pointer or two). Callables that don't fit are heap allocated.
+//
+// Kept in a std::vector, which keeps its capacity when cleared, re-recording a command buffer does not allocate for its
+// callbacks once the vector has grown to size.
+//
+// NOTE: Like std::function, the callable must be CopyConstructible
+template <typename Signature, size_t N = 64>
+class inline_function;
+
+template <typename R, typename... Args, size_t N>
+class inline_function<R(Args...), N> {
+  public:
+    static constexpr size_t kInlineSize = N;
+
+    inline_function() = default;
+    inline_function(std::nullptr_t) {}
+
+    template <typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, inline_function> &&
+                                                      std::is_invocable_r_v<R, std::decay_t<F> &, Args...>>>
+    inline_function(F &&f) {
+        using Callable = std::decay_t<F>;
+        if constexpr (FitsInline<Callable>()) {
+            new (storage_) Callable(std::forward<F>(f));
+            ops_ = &InlineOps<Callable>::kOps;
+        } else {
+            new (storage_) Callable *(new Callable(std::forward<F>(f)));
+            ops_ = &HeapOps<Callable>::kOps;
+        }
+    }
+
+    inline_function(const inline_function &other) {
+        if (other.ops_) {
+            other.ops_->copy(storage_, other.storage_);
+            ops_ = other.ops_;
+        }
+    }
+
+    inline_function(inline_function &&other) noexcept {
+        if (other.ops_) {
+            other.ops_->move(storage_, other.storage_);
+            ops_ = other.ops_;
+            other.ops_ = nullptr;
+        }
+    }
+
+    inline_function &operator=(const inline_function &other) {
+        if (this != &other) {
+            inline_function copy(other);
+            *this = std::move(copy);
+        }
+        return *this;
+    }
+
+    inline_function &operator=(inline_function &&other) noexcept {
+        if (this != &other) {
+            reset();
+            if (other.ops_) {
+                other.ops_->move(storage_, other.storage_);
+                ops_ = other.ops_;
+                other.ops_ = nullptr;
+            }
+        }
+        return *this;
+    }
+
+    ~inline_function() { reset(); }
+
+    void reset() {
+        if (ops_) {
+            ops_->destroy(storage_);
+            ops_ = nullptr;
+        }
+    }
+
+    explicit operator bool() const { return ops_ != nullptr; }
+
+    R operator()(Args... args) const {
+        assert(ops_);
+        return ops_->invoke(const_cast<unsigned char *>(storage_), std::forward<Args>(args)...);
+    }
+
+  private:
+    struct Ops {
+        R (*invoke)(void *storage, Args &&...args);
+        void (*copy)(void *dst, const void *src);
+        // Move constructs into dst and destroys src
+        void (*move)(void *dst, void *src);
+        void (*destroy)(void *storage);
+    };
+
+    template <typename Callable>
+    static constexpr bool FitsInline() {
+        return sizeof(Callable) <= N && alignof(Callable) <= alignof(std::max_align_t) &&
+               std::is_nothrow_move_constructible_v<Callable>;
+    }
+
+    template <typename Callable>
+    struct InlineOps {
+        static R Invoke(void *storage, Args &&...args) {
+            // Like std::function, a void signature discards what the callable returns
+            if constexpr (std::is_void_v<R>) {
+                (*static_cast<Callable *>(storage))(std::forward<Args>(args)...);
+            } else {
+                return (*static_cast<Callable *>(storage))(std::forward<Args>(args)...);
+            }
+        }
+        static void Copy(void *dst, const void *src) { new (dst) Callable(*static_cast<const Callable *>(src)); }
+        static void Move(void *dst, void *src) {
+            auto *callable = static_cast<Callable *>(src);
+            new (dst) Callable(std::move(*callable));
+            callable->~Callable();
+        }
+        static void Destroy(void *storage) { static_cast<Callable *>(storage)->~Callable(); }
+        static constexpr Ops kOps = {Invoke, Copy, Move, Destroy};
+    };
+
+    // The inline store only holds the pointer to the callable
+    template <typename Callable>
+    struct HeapOps {
+        static Callable *&Get(void *storage) { return *static_cast<Callable **>(storage); }
+        static R Invoke(void *storage, Args &&...args) {
+            if constexpr (std::is_void_v<R>) {
+                (*Get(storage))(std::forward<Args>(args)...);
+            } else {
+                return (*Get(storage))(std::forward<Args>(args)...);
+            }
+        }
+        static void Copy(void *dst, const void *src) {
+            new (dst) Callable *(new Callable(**static_cast<Callable *const *>(src)));
+        }
+        static void Move(void *dst, void *src) { new (dst) Callable *(Get(src)); }
+        static void Destroy(void *storage) { delete Get(storage); }
+        static constexpr Ops kOps = {Invoke, Copy, Move, Destroy};
+    };
+
+    static_assert(N >= sizeof(void *), "inline store must at least hold a pointer");
+
+    alignas(std::max_align_t) unsigned char storage_[N];
+    const Ops *ops_ = nullptr;
+};
+
+}  // namespace vvl
@@ -0,0 +1,212 @@
+/* Copyright (c) 2025 The Khronos Group Inc.
+ * Copyright (c) 2025 Valve Corporation
+ * Copyright (c) 2025 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace vvl {
+
+// Hands out fixed size blocks carved from slabs, with a free list for reuse. The block size is set by the first allocation,
+// other sizes are not served by the pool. Once every block is freed (ex: the container was cleared) the slabs go back to the
+// system, until then erased nodes are kept for reuse.
+//
+// Thread safe. The lock is only contended when a moved-from container, which shares the pool, is used next to the new owner.
+class NodePool {
+  public:
+    NodePool() = default;
+    NodePool(const NodePool &) = delete;
+    NodePool &operator=(const NodePool &) = delete;
+
+    // Returns null if the pool doesn't serve this size
+    void *Allocate(size_t size) {
+        std::lock_guard<std::mutex> guard(lock_);
+        if (node_size_ == 0) {
+            node_size_ = RoundUp(size);
+        } else if (node_size_ != RoundUp(size)) {
+            return nullptr;
+        }
+        ++live_count_;
+        if (free_list_) {
+            FreeNode *node = free_list_;
+            free_list_ = node->next;
+            if (node == first_node_) {
+                first_node_live_ = true;
+            }
+            return node;
+        }
+        if (slab_used_ == slab_capacity_) {
+            // Grow the slabs geometrically so small maps stay small and large ones don't do many allocations
+            slab_capacity_ = slabs_.empty() ? kFirstSlabNodes : std::min(slab_capacity_ * 2, kMaxSlabNodes);
+            slabs_.emplace_back(new std::byte[slab_capacity_ * node_size_]);
+            slab_used_ = 0;
+            if (slabs_.size() == 1) {
+                first_node_ = slabs_.front().get();
+                first_node_live_ = true;
+            }
+        }
+        return slabs_.back().get() + (slab_used_++ * node_size_);
+    }
+
+    // Returns false if the pool doesn't serve this size, in which case it didn't allocate p either
+    bool Free(void *p, size_t size) {
+        std::lock_guard<std::mutex> guard(lock_);
+        if (node_size_ != RoundUp(size)) {
+            return false;
+        }
+        --live_count_;
+        if (p == first_node_) {
+            first_node_live_ = false;
+        }
+        if (live_count_ == 0) {
+            ReleaseSlabs();
+        } else if (live_count_ == 1 && first_node_live_) {
+            // Only the MSVC sentinel node, which is allocated first and lives as long as the container, is left
+            slabs_.resize(1);
+            slab_capacity_ = kFirstSlabNodes;
+            slab_used_ = 1;
+            free_list_ = nullptr;
+        } else {
+            auto *node = static_cast<FreeNode *>(p);
+            node->next = free_list_;
+            free_list_ = node;
+        }
+        return true;
+    }
+
+    // Bytes held in slabs, free or not
+    size_t Capacity() const {
+        std::lock_guard<std::mutex> guard(lock_);
+        size_t node_count = 0;
+        for (size_t i = 0, nodes = kFirstSlabNodes; i < slabs_.size(); ++i, nodes = std::min(nodes * 2, kMaxSlabNodes)) {
+            node_count += nodes;
+        }
+        return node_count * node_size_;
+    }
+
+  private:
+    struct FreeNode {
+        FreeNode *next;
+    };
+    static constexpr size_t kFirstSlabNodes = 8;
+    static constexpr size_t kMaxSlabNodes = 256;
+
+    static size_t RoundUp(size_t size) {
+        constexpr size_t align = alignof(std::max_align_t);
+        return (std::max(size, sizeof(FreeNode)) + align - 1) & ~(align - 1);
+    }
+
+    void ReleaseSlabs() {
+        slabs_.clear();
+        slab_capacity_ = 0;
+        slab_used_ = 0;
+        free_list_ = nullptr;
+        first_node_ = nullptr;
+        first_node_live_ = false;
+    }
+
+    mutable std::mutex lock_;
+    size_t node_size_ = 0;
+    FreeNode *free_list_ = nullptr;
+    std::vector<std::unique_ptr<std::byte[]>> slabs_;
+    size_t slab_capacity_ = 0;
+    size_t slab_used_ = 0;
+    size_t live_count_ = 0;
+    // The first block of the first slab, kept while it is the only one in use
+    void *first_node_ = nullptr;
+    bool first_node_live_ = false;
+};
+
+// Allocator for node based containers (std::map and friends) that takes its nodes from a NodePool owned by the container.
+//
+// Split/infill/merge heavy maps (eg. the syncval access maps) otherwise go through malloc/free for every node. Nodes keep
+// their address, so iterators stay valid exactly as with std::allocator.
+//
+// Each default constructed allocator creates its own pool, which allocates no slabs until the first node, and allocators
+// compare equal only if they share a pool. The node size is the size of the first single object allocation: the only ones
+// node based containers make are their nodes (including the MSVC sentinel node), once the MSVC debug iterator proxy is
+// excluded.
+//
+// Copying a container gives the copy its own pool. Moving or swapping takes the pool along with the nodes, and the
+// moved-from container keeps sharing it, which the pool's lock makes safe.
+template <typename T>
+class node_pool_allocator {
+  public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    node_pool_allocator() : pool_(std::make_shared<NodePool>()) {}
+    // No move constructor on purpose, a moved-from container still needs a pool to allocate from
+    node_pool_allocator(const node_pool_allocator &) noexcept = default;
+    node_pool_allocator &operator=(const node_pool_allocator &) noexcept = default;
+    template <typename U>
+    node_pool_allocator(const node_pool_allocator<U> &other) noexcept : pool_(other.pool_) {}
+
+    node_pool_allocator select_on_container_copy_construction() const { return node_pool_allocator(); }
+
+    T *allocate(size_t n) {
+        if (n == 1 && IsPoolable()) {
+            if (void *p = pool_->Allocate(sizeof(T))) {
+                return static_cast<T *>(p);
+            }
+        }
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T *p, size_t n) {
+        if (n == 1 && IsPoolable() && pool_->Free(p, sizeof(T))) {
+            return;
+        }
+        std::allocator<T>().deallocate(p, n);
+    }
+
+    const NodePool &GetPool() const { return *pool_; }
+
+    template <typename U>
+    bool operator==(const node_pool_allocator<U> &other) const {
+        return pool_ == other.pool_;
+    }
+    template <typename U>
+    bool operator!=(const node_pool_allocator<U> &other) const {
+        return pool_ != other.pool_;
+    }
+
+  private:
+    template <typename U>
+    friend class node_pool_allocator;
+
+    static constexpr bool IsPoolable() {
+#if defined(_MSVC_STL_VERSION)
+        // Allocated before the first node, it would set the node size of the pool
+        if (std::is_same_v<T, std::_Container_proxy>) {
+            return false;
+        }
+#endif
+        return alignof(T) <= alignof(std::max_align_t);
+    }
+
+    std::shared_ptr<NodePool> pool_;
+};
+
+}  // namespace vvl
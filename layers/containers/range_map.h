@@ -1876,28 +1876,28 @@ bool update_range_value(Map &map, const Range &range, MapValue &&value, value_pr
 }
 
 //  combines directly adjacent ranges with equal RangeMap::mapped_type .
+//  The map is only written to where ranges are merged, which keeps copy on write storage (see segmented_map) shared.
 template <typename RangeMap>
 void consolidate(RangeMap &map) {
     using Value = typename RangeMap::value_type;
     using Key = typename RangeMap::key_type;
-    using It = typename RangeMap::iterator;
+    using It = typename RangeMap::const_iterator;
 
-    It current = map.begin();
-    const It map_end = map.end();
+    It current = map.cbegin();
 
     // To be included in a merge range there must be no gap in the Key space, and the mapped_type values must match
     auto can_merge = [](const It &last, const It &cur) {
         return cur->first.begin == last->first.end && cur->second == last->second;
     };
 
-    while (current != map_end) {
+    while (current != map.cend()) {
         // Establish a trival merge range at the current location, advancing current. Merge range is inclusive of merge_last
         const It merge_first = current;
         It merge_last = current;
         ++current;
 
         // Expand the merge range as much as possible
-        while (current != map_end && can_merge(merge_last, current)) {
+        while (current != map.cend() && can_merge(merge_last, current)) {
             merge_last = current;
             ++current;
         }
@@ -1907,9 +1907,11 @@ void consolidate(RangeMap &map) {
             // IFF there is more than one range in (merge_first, merge_last)  <- again noting the *inclusive* last
             // Create a new Val spanning (first, last), substitute it for the multiple entries.
             Value merged_value = std::make_pair(Key(merge_first->first.begin, merge_last->first.end), merge_last->second);
-            // Note that current points to merge_last + 1, and is valid even if at map_end for these operations
-            map.erase(merge_first, current);
-            map.insert(current, std::move(merged_value));
+            // The entries exactly cover the merged range, nothing is split. Continue from the write results, as writing
+            // can invalidate the const iterators
+            auto next = map.erase_range(merged_value.first);
+            current = map.insert(next, std::move(merged_value));
+            ++current;
         }
     }
 }
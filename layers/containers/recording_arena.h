@@ -0,0 +1,148 @@
+/* Copyright (c) 2025 The Khronos Group Inc.
+ * Copyright (c) 2025 Valve Corporation
+ * Copyright (c) 2025 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace vvl {
+
+// Bump allocator for state that lives for one recording of a command buffer. Nothing is freed individually, Rewind() makes
+// all of the memory available again once everything allocated from the arena is gone.
+//
+// If a recording needed more than one chunk, Rewind() replaces them with a single chunk of their total size, so re-recording
+// a command buffer of the same size does not allocate at all. Not thread safe.
+class RecordingArena {
+  public:
+    RecordingArena() = default;
+    RecordingArena(const RecordingArena &) = delete;
+    RecordingArena &operator=(const RecordingArena &) = delete;
+
+    void *Allocate(size_t size) {
+        size = RoundUp(size);
+        while (current_ < chunks_.size()) {
+            Chunk &chunk = chunks_[current_];
+            if (chunk.size - offset_ >= size) {
+                void *p = chunk.data.get() + offset_;
+                offset_ += size;
+                return p;
+            }
+            // The rest of the chunk is wasted until the next Rewind()
+            ++current_;
+            offset_ = 0;
+        }
+        const size_t chunk_size = std::max(size, chunks_.empty() ? kFirstChunkSize : chunks_.back().size * 2);
+        chunks_.push_back({std::make_unique<std::byte[]>(chunk_size), chunk_size});
+        current_ = chunks_.size() - 1;
+        offset_ = size;
+        return chunks_.back().data.get();
+    }
+
+    // Everything allocated from the arena must have been destroyed
+    void Rewind() {
+        if (chunks_.size() > 1) {
+            size_t total_size = 0;
+            for (const Chunk &chunk : chunks_) {
+                total_size += chunk.size;
+            }
+            chunks_.clear();
+            chunks_.push_back({std::make_unique<std::byte[]>(total_size), total_size});
+        }
+        current_ = 0;
+        offset_ = 0;
+    }
+
+    size_t Capacity() const {
+        size_t capacity = 0;
+        for (const Chunk &chunk : chunks_) {
+            capacity += chunk.size;
+        }
+        return capacity;
+    }
+
+  private:
+    struct Chunk {
+        std::unique_ptr<std::byte[]> data;
+        size_t size;
+    };
+    static constexpr size_t kFirstChunkSize = 4096;
+
+    static size_t RoundUp(size_t size) {
+        constexpr size_t align = alignof(std::max_align_t);
+        return (size + align - 1) & ~(align - 1);
+    }
+
+    std::vector<Chunk> chunks_;
+    size_t current_ = 0;
+    size_t offset_ = 0;
+};
+
+// Allocator for containers that are emptied when a command buffer is reset. Deallocation is a no-op, the memory comes back
+// when the arena is rewound.
+//
+// A default constructed allocator (ex: a local copy of the container type in a validation function) uses the heap, as do
+// copies of an arena backed container, so nothing allocated from the arena can outlive a recording by being copied out.
+// Move assignment takes the allocator along, which is how a container is re-pointed at the arena after a Rewind().
+template <typename T>
+class recording_arena_allocator {
+  public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    recording_arena_allocator() noexcept = default;
+    explicit recording_arena_allocator(RecordingArena *arena) noexcept : arena_(arena) {}
+    template <typename U>
+    recording_arena_allocator(const recording_arena_allocator<U> &other) noexcept : arena_(other.arena_) {}
+
+    recording_arena_allocator select_on_container_copy_construction() const { return recording_arena_allocator(); }
+
+    T *allocate(size_t n) {
+        if (arena_ && alignof(T) <= alignof(std::max_align_t)) {
+            return static_cast<T *>(arena_->Allocate(n * sizeof(T)));
+        }
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T *p, size_t n) {
+        if (arena_ && alignof(T) <= alignof(std::max_align_t)) {
+            return;
+        }
+        std::allocator<T>().deallocate(p, n);
+    }
+
+    template <typename U>
+    bool operator==(const recording_arena_allocator<U> &other) const {
+        return arena_ == other.arena_;
+    }
+    template <typename U>
+    bool operator!=(const recording_arena_allocator<U> &other) const {
+        return arena_ != other.arena_;
+    }
+
+  private:
+    template <typename U>
+    friend class recording_arena_allocator;
+
+    RecordingArena *arena_ = nullptr;
+};
+
+}  // namespace vvl
@@ -0,0 +1,312 @@
+/* Copyright (c) 2025 The Khronos Group Inc.
+ * Copyright (c) 2025 Valve Corporation
+ * Copyright (c) 2025 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace sparse_container {
+
+// Ordered map of range keys stored in two levels, for use as the range_map "ImplMap" as an alternate to std::map.
+//
+// The high bits of the range begin select a segment, and each segment is an ordered map of its own. Keys order on begin
+// first, so all keys of a segment come before the keys of the following segments and iteration visits the entries in the
+// same order as a single map would. Entries are not split at segment boundaries: a range belongs to the segment of its
+// begin, even when it extends into the following ones.
+//
+// Lookups only search the segment of the key. Empty segments are removed, iterators never stop on them.
+//
+// Segments are copied on write: copying the map only copies the segment references, and a segment is copied the first
+// time a mutable iterator points into it while another map still shares it. So copies of large maps cost in proportion to
+// the segments they later change, and not to their size. The consequences for users:
+// - Getting a mutable iterator, even for reading, unshares its segment. Read through const iterators when possible.
+// - Unsharing invalidates the const iterators of this map that point into the segment (as erasing them would).
+// - Maps sharing segments can be used from different threads, as long as each map is only used by one thread at a time.
+template <typename RangeKey, typename T, unsigned SegmentShift, typename SegmentMap = std::map<RangeKey, T>>
+class segmented_map {
+  public:
+    using key_type = RangeKey;
+    using mapped_type = T;
+    using value_type = std::pair<const key_type, mapped_type>;
+    using index_type = typename key_type::index_type;
+    using size_type = size_t;
+
+  private:
+    using SegmentId = index_type;
+    using SegmentPtr = std::shared_ptr<SegmentMap>;
+    using Segments = std::map<SegmentId, SegmentPtr>;
+
+  public:
+    class const_iterator;
+
+  private:
+    template <typename Map, typename Value, typename OuterIterator, typename InnerIterator>
+    class IteratorImpl {
+      public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = typename segmented_map::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Value *;
+        using reference = Value &;
+
+        IteratorImpl() = default;
+
+        Value &operator*() const { return *inner_; }
+        Value *operator->() const { return &*inner_; }
+
+        IteratorImpl &operator++() {
+            ++inner_;
+            if (inner_ == outer_->second->end()) {
+                ++outer_;
+                SetInnerToSegmentBegin();
+            }
+            return *this;
+        }
+
+        IteratorImpl &operator--() {
+            if (outer_ == map_->segments_.end() || inner_ == outer_->second->begin()) {
+                --outer_;
+                UnshareIfMutable();
+                inner_ = outer_->second->end();
+            }
+            --inner_;
+            return *this;
+        }
+
+        // The inner iterator of end() is value initialized, and inner iterators are only compared within the same segment
+        bool operator==(const IteratorImpl &rhs) const { return (outer_ == rhs.outer_) && (inner_ == rhs.inner_); }
+        bool operator!=(const IteratorImpl &rhs) const { return !(*this == rhs); }
+
+      protected:
+        friend segmented_map;
+        friend const_iterator;
+
+        // Points to the first entry of the segment (or end)
+        IteratorImpl(Map *map, const OuterIterator &outer) : map_(map), outer_(outer) { SetInnerToSegmentBegin(); }
+        IteratorImpl(Map *map, const OuterIterator &outer, const InnerIterator &inner) : map_(map), outer_(outer), inner_(inner) {}
+
+        void SetInnerToSegmentBegin() {
+            if (outer_ == map_->segments_.end()) {
+                inner_ = InnerIterator();
+                return;
+            }
+            UnshareIfMutable();
+            inner_ = outer_->second->begin();
+        }
+
+        void UnshareIfMutable() {
+            if constexpr (!std::is_const_v<Map>) {
+                map_->Unshare(outer_);
+            }
+        }
+
+        Map *map_ = nullptr;
+        OuterIterator outer_;
+        InnerIterator inner_;
+    };
+
+  public:
+    using iterator = IteratorImpl<segmented_map, value_type, typename Segments::iterator, typename SegmentMap::iterator>;
+
+    // The const iterator must be derived to allow the conversion from iterator, which iterator doesn't support
+    class const_iterator : public IteratorImpl<const segmented_map, const value_type, typename Segments::const_iterator,
+                                               typename SegmentMap::const_iterator> {
+        using Base = IteratorImpl<const segmented_map, const value_type, typename Segments::const_iterator,
+                                  typename SegmentMap::const_iterator>;
+        friend segmented_map;
+
+      public:
+        const_iterator() = default;
+        const_iterator(const iterator &it) : Base(it.map_, it.outer_, it.inner_) {}
+
+      private:
+        using Base::Base;
+    };
+
+    segmented_map() = default;
+    segmented_map(const segmented_map &) = default;
+    segmented_map(segmented_map &&other) noexcept : segments_(std::move(other.segments_)), size_(other.size_) { other.clear(); }
+    segmented_map &operator=(const segmented_map &) = default;
+    segmented_map &operator=(segmented_map &&other) noexcept {
+        if (this != &other) {
+            segments_ = std::move(other.segments_);
+            size_ = other.size_;
+            other.clear();
+        }
+        return *this;
+    }
+
+    iterator begin() { return iterator(this, segments_.begin()); }
+    const_iterator begin() const { return cbegin(); }
+    const_iterator cbegin() const { return const_iterator(this, segments_.cbegin()); }
+    iterator end() { return iterator(this, segments_.end()); }
+    const_iterator end() const { return cend(); }
+    const_iterator cend() const { return const_iterator(this, segments_.cend()); }
+
+    bool empty() const { return segments_.empty(); }
+    size_type size() const { return size_; }
+    void clear() {
+        segments_.clear();
+        size_ = 0;
+    }
+
+    iterator lower_bound(const key_type &key) { return LowerBoundImpl<iterator>(*this, key); }
+    const_iterator lower_bound(const key_type &key) const { return LowerBoundImpl<const_iterator>(*this, key); }
+    iterator upper_bound(const key_type &key) { return UpperBoundImpl<iterator>(*this, key); }
+    const_iterator upper_bound(const key_type &key) const { return UpperBoundImpl<const_iterator>(*this, key); }
+    iterator find(const key_type &key) { return FindImpl<iterator>(*this, key); }
+    const_iterator find(const key_type &key) const { return FindImpl<const_iterator>(*this, key); }
+
+    template <typename Value>
+    iterator emplace_hint(const const_iterator &hint, Value &&value) {
+        auto segment = GetOrCreateSegment(SegmentOf(value.first));
+        const bool copied = Unshare(segment);
+        SegmentMap &segment_map = *segment->second;
+        // A hint from another segment says nothing about the position in this one, and a hint into the copied segment
+        // points to the old copy
+        const auto inner_hint = (hint.outer_ == segment && !copied) ? hint.inner_ : segment_map.cend();
+        const size_t old_size = segment_map.size();
+        auto inner = segment_map.emplace_hint(inner_hint, std::forward<Value>(value));
+        size_ += segment_map.size() - old_size;
+        return iterator(this, segment, inner);
+    }
+    iterator insert(const const_iterator &hint, const value_type &value) { return emplace_hint(hint, value); }
+
+    std::pair<iterator, bool> insert(const value_type &value) {
+        auto segment = GetOrCreateSegment(SegmentOf(value.first));
+        Unshare(segment);
+        auto inserted = segment->second->insert(value);
+        if (inserted.second) {
+            ++size_;
+        }
+        return std::make_pair(iterator(this, segment, inserted.first), inserted.second);
+    }
+
+    iterator erase(const const_iterator &pos) {
+        // An empty erase turns the const iterators into mutable ones in constant time
+        auto segment = segments_.erase(pos.outer_, pos.outer_);
+        const bool copied = Unshare(segment);
+        SegmentMap &segment_map = *segment->second;
+        // When the segment had to be copied pos points into the old copy
+        auto next = segment_map.erase(copied ? segment_map.find(pos->first) : pos.inner_);
+        --size_;
+        if (next != segment_map.end()) {
+            return iterator(this, segment, next);
+        }
+        if (segment_map.empty()) {
+            segment = segments_.erase(segment);
+        } else {
+            ++segment;
+        }
+        return iterator(this, segment);
+    }
+    iterator erase(const iterator &pos) { return erase(const_iterator(pos)); }
+
+    size_type segment_count() const { return segments_.size(); }
+    // Number of segments also referenced by other maps
+    size_type shared_segment_count() const {
+        size_type count = 0;
+        for (const auto &segment : segments_) {
+            count += (segment.second.use_count() > 1) ? 1 : 0;
+        }
+        return count;
+    }
+
+  private:
+    static SegmentId SegmentOf(const key_type &key) { return key.begin >> SegmentShift; }
+
+    typename Segments::iterator GetOrCreateSegment(SegmentId id) {
+        auto segment = segments_.lower_bound(id);
+        if (segment == segments_.end() || segment->first != id) {
+            segment = segments_.emplace_hint(segment, id, std::make_shared<SegmentMap>());
+        }
+        return segment;
+    }
+
+    // Make the segment owned by this map only, returns true when it had to be copied
+    bool Unshare(const typename Segments::iterator &segment) {
+        if (segment->second.use_count() == 1) {
+            // use_count() is a relaxed load, order it with the release of the last other owner (possibly another thread)
+            // before writing to the segment
+            std::atomic_thread_fence(std::memory_order_acquire);
+            return false;
+        }
+        segment->second = std::make_shared<SegmentMap>(*segment->second);
+        return true;
+    }
+
+    // Keys of earlier segments are all less than a key of segment id, and keys of later segments all greater, so only
+    // the segment of the key needs a search. When the key is past the end of its segment the bound is the next segment.
+    template <typename Iterator, typename ThisType, typename SegmentBound>
+    static Iterator BoundImpl(ThisType &that, const key_type &key, SegmentBound &&segment_bound) {
+        if (!key.valid()) {
+            // Invalid keys order before all valid keys
+            return Iterator(&that, that.segments_.begin());
+        }
+        const SegmentId id = SegmentOf(key);
+        auto segment = that.segments_.lower_bound(id);
+        if (segment != that.segments_.end() && segment->first == id) {
+            UnshareIfMutable(that, segment);
+            auto inner = segment_bound(*segment->second, key);
+            if (inner != segment->second->end()) {
+                return Iterator(&that, segment, inner);
+            }
+            ++segment;
+        }
+        return Iterator(&that, segment);
+    }
+
+    template <typename Iterator, typename ThisType>
+    static Iterator LowerBoundImpl(ThisType &that, const key_type &key) {
+        return BoundImpl<Iterator>(that, key, [](auto &segment_map, const key_type &k) { return segment_map.lower_bound(k); });
+    }
+
+    template <typename Iterator, typename ThisType>
+    static Iterator UpperBoundImpl(ThisType &that, const key_type &key) {
+        return BoundImpl<Iterator>(that, key, [](auto &segment_map, const key_type &k) { return segment_map.upper_bound(k); });
+    }
+
+    template <typename ThisType, typename OuterIterator>
+    static void UnshareIfMutable(ThisType &that, const OuterIterator &segment) {
+        if constexpr (!std::is_const_v<ThisType>) {
+            that.Unshare(segment);
+        }
+    }
+
+    template <typename Iterator, typename ThisType>
+    static Iterator FindImpl(ThisType &that, const key_type &key) {
+        auto segment = that.segments_.find(SegmentOf(key));
+        if (segment != that.segments_.end()) {
+            UnshareIfMutable(that, segment);
+            auto inner = segment->second->find(key);
+            if (inner != segment->second->end()) {
+                return Iterator(&that, segment, inner);
+            }
+        }
+        return Iterator(&that, that.segments_.end());
+    }
+
+    Segments segments_;
+    size_type size_ = 0;
+};
+
+}  // namespace sparse_container
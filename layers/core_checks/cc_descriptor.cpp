@@ -825,7 +825,8 @@ bool CoreChecks::PreCallValidateGetDescriptorSetLayoutSupportKHR(VkDevice device
 // Return true if state is acceptable, or false and write an error message into error string
 bool CoreChecks::ValidateDrawState(const vvl::DescriptorSet &descriptor_set, uint32_t set_index,
                                    const BindingVariableMap &binding_req_map, const vvl::CommandBuffer &cb_state,
-                                   const vvl::DrawDispatchVuid &vuids, const VulkanTypedHandle &shader_handle) const {
+                                   const vvl::DrawDispatchVuid &vuids, const VulkanTypedHandle &shader_handle,
+                                   std::optional<uint64_t> validated_change_count) const {
     bool result = false;
     const Location &loc = vuids.loc();
     const VkFramebuffer framebuffer = cb_state.activeFramebuffer ? cb_state.activeFramebuffer->VkHandle() : VK_NULL_HANDLE;
@@ -848,6 +849,11 @@ bool CoreChecks::ValidateDrawState(const vvl::DescriptorSet &descriptor_set, uin
             return result;
         }
 
+        // Already validated for this command buffer and not updated since
+        if (validated_change_count && binding->change_count <= *validated_change_count) {
+            continue;
+        }
+
         if (descriptor_set.ValidateBindingOnGPU(*binding, resource_variable)) {
             continue;
         }
@@ -337,32 +337,29 @@ void CoreChecks::FinishDeviceSetup(const VkDeviceCreateInfo *pCreateInfo, const
     BaseClass::FinishDeviceSetup(pCreateInfo, loc);
 
     AdjustValidatorOptions(extensions, enabled_features, spirv_val_options, &spirv_val_option_hash);
+    validation_cache_device_hash =
+        GetValidationCacheDeviceStateHash(api_version, extensions, enabled_features, phys_dev_props, phys_dev_props_core11,
+                                          phys_dev_props_core12, phys_dev_ext_props, device_state->has_format_feature2);
 
     // Allocate shader validation cache
     if (!disabled[shader_validation_caching] && !disabled[shader_validation] && !core_validation_cache) {
-        auto tmp_path = GetTempFilePath();
-        validation_cache_path = tmp_path + "/shader_validation_cache";
+        const std::string cache_dir =
+            global_settings.shader_validation_cache_path.empty() ? GetTempFilePath() : global_settings.shader_validation_cache_path;
+        std::string validation_cache_path = cache_dir + "/shader_validation_cache";
 #if defined(__linux__) || defined(__FreeBSD__) || defined(__OpenBSD__) || defined(__GNU__)
         validation_cache_path += "-" + std::to_string(getuid());
 #endif
-        validation_cache_path += ".bin";
-
-        std::vector<char> validation_cache_data;
-        std::ifstream read_file(validation_cache_path.c_str(), std::ios::in | std::ios::binary);
-
-        if (read_file) {
-            std::copy(std::istreambuf_iterator<char>(read_file), {}, std::back_inserter(validation_cache_data));
-            read_file.close();
-        } else {
-            LogInfo("WARNING-cache-file-error", device, loc,
-                    "Cannot open shader validation cache at %s for reading (it may not exist yet)", validation_cache_path.c_str());
-        }
 
         VkValidationCacheCreateInfoEXT cacheCreateInfo = vku::InitStructHelper();
-        cacheCreateInfo.initialDataSize = validation_cache_data.size();
-        cacheCreateInfo.pInitialData = validation_cache_data.data();
-        cacheCreateInfo.flags = 0;
         CoreLayerCreateValidationCacheEXT(device, &cacheCreateInfo, nullptr, &core_validation_cache);
+
+        // Modules are added to the file as they pass validation, not only when the device is destroyed
+        validation_cache_file = std::make_shared<ValidationCacheFile>(validation_cache_path);
+        if (!validation_cache_file->Attach(*CastFromHandle<ValidationCache *>(core_validation_cache))) {
+            LogInfo("WARNING-cache-file-error", device, loc, "Cannot open shader validation cache at %s",
+                    validation_cache_file->Path().c_str());
+            validation_cache_file.reset();
+        }
     }
 }
 
@@ -374,37 +371,13 @@ void CoreChecks::PreCallRecordDestroyDevice(VkDevice device, const VkAllocationC
 
     if (core_validation_cache) {
         Location loc(Func::vkDestroyDevice);
-        size_t validation_cache_size = 0;
-        void *validation_cache_data = nullptr;
-
-        CoreLayerGetValidationCacheDataEXT(device, core_validation_cache, &validation_cache_size, nullptr);
-
-        validation_cache_data = (char *)malloc(sizeof(char) * validation_cache_size);
-        if (!validation_cache_data) {
-            LogInfo("WARNING-cache-memory-error", device, loc, "Validation Cache Memory Error");
-            return;
-        }
-
-        VkResult result =
-            CoreLayerGetValidationCacheDataEXT(device, core_validation_cache, &validation_cache_size, validation_cache_data);
-
-        if (result != VK_SUCCESS) {
-            LogInfo("WARNING-cache-retrieval-error", device, loc, "Validation Cache Retrieval Error");
-            free(validation_cache_data);
-            return;
-        }
-
-        if (validation_cache_path.size() > 0) {
-            std::ofstream write_file(validation_cache_path.c_str(), std::ios::out | std::ios::binary);
-            if (write_file) {
-                write_file.write(static_cast<char *>(validation_cache_data), validation_cache_size);
-                write_file.close();
-            } else {
-                LogInfo("WARNING-cache-write-error", device, loc, "Cannot open shader validation cache at %s for writing",
-                        validation_cache_path.c_str());
+        if (validation_cache_file) {
+            if (!validation_cache_file->Detach(*CastFromHandle<ValidationCache *>(core_validation_cache))) {
+                LogInfo("WARNING-cache-write-error", device, loc, "Cannot write shader validation cache at %s",
+                        validation_cache_file->Path().c_str());
             }
+            validation_cache_file.reset();
         }
-        free(validation_cache_data);
         CoreLayerDestroyValidationCacheEXT(device, core_validation_cache, NULL);
     }
 }
@@ -549,7 +522,7 @@ VkFormatProperties3KHR CoreChecks::GetPDFormatProperties(const VkFormat format)
 VkResult CoreChecks::CoreLayerCreateValidationCacheEXT(VkDevice device, const VkValidationCacheCreateInfoEXT *pCreateInfo,
                                                        const VkAllocationCallbacks *pAllocator,
                                                        VkValidationCacheEXT *pValidationCache) {
-    *pValidationCache = ValidationCache::Create(pCreateInfo, spirv_val_option_hash);
+    *pValidationCache = ValidationCache::Create(pCreateInfo, spirv_val_option_hash, validation_cache_device_hash);
     return *pValidationCache ? VK_SUCCESS : VK_ERROR_INITIALIZATION_FAILED;
 }
 
@@ -1325,13 +1325,26 @@ bool CoreChecks::ValidateActionState(const vvl::CommandBuffer &cb_state, const V
 // any dynamic descriptors, always revalidate rather than caching the values. We currently only
 // apply this optimization if IsManyDescriptors is true, to avoid the overhead of copying the
 // binding_req_map which could potentially be expensive.
-static bool NeedDrawStateValidated(const vvl::CommandBuffer &cb_state, const vvl::DescriptorSet *descriptor_set,
-                                   const LastBound::DescriptorSetSlot &ds_slot, bool disabled_image_layout_validation) {
-    return ds_slot.dynamic_offsets.size() > 0 ||
-           // Revalidate if descriptor set (or contents) has changed
-           ds_slot.validated_set != descriptor_set || ds_slot.validated_set_change_count != descriptor_set->GetChangeCount() ||
-           (!disabled_image_layout_validation &&
-            ds_slot.validated_set_image_layout_change_count != cb_state.image_layout_change_count);
+// If only the contents of the set changed, each binding remembers the set change count of its last update, so only the
+// bindings updated since the last validation need to be looked at again.
+enum class DrawStateValidation { kNone, kChangedBindings, kAll };
+
+static DrawStateValidation NeedDrawStateValidated(const vvl::CommandBuffer &cb_state, const vvl::DescriptorSet *descriptor_set,
+                                                  const BindingVariableMap &binding_req_map,
+                                                  const LastBound::DescriptorSetSlot &ds_slot,
+                                                  bool disabled_image_layout_validation) {
+    // Revalidate if descriptor set, or the pipeline (or shader objects) using it, has changed
+    if (ds_slot.dynamic_offsets.size() > 0 || ds_slot.validated_set_id != descriptor_set->GetId() ||
+        ds_slot.validated_binding_req_map != &binding_req_map ||
+        (!disabled_image_layout_validation &&
+         ds_slot.validated_set_image_layout_change_count != cb_state.image_layout_change_count)) {
+        return DrawStateValidation::kAll;
+    }
+    // Revalidate the updated bindings if the contents have changed
+    if (ds_slot.validated_set_change_count != descriptor_set->GetChangeCount()) {
+        return DrawStateValidation::kChangedBindings;
+    }
+    return DrawStateValidation::kNone;
 }
 
 bool CoreChecks::ValidateActionStateDescriptorsPipeline(const LastBound &last_bound_state, const VkPipelineBindPoint bind_point,
@@ -1417,10 +1430,13 @@ bool CoreChecks::ValidateActionStateDescriptorsPipeline(const LastBound &last_bo
                 const auto *descriptor_set = ds_slot.ds_state.get();
                 ASSERT_AND_CONTINUE(descriptor_set);
 
-                const bool need_validate =
-                    NeedDrawStateValidated(cb_state, descriptor_set, ds_slot, disabled[image_layout_validation]);
-                if (need_validate) {
+                const DrawStateValidation need_validate =
+                    NeedDrawStateValidated(cb_state, descriptor_set, binding_req_map, ds_slot, disabled[image_layout_validation]);
+                if (need_validate == DrawStateValidation::kAll) {
                     skip |= ValidateDrawState(*descriptor_set, set_index, binding_req_map, cb_state, vuid, pipeline.Handle());
+                } else if (need_validate == DrawStateValidation::kChangedBindings) {
+                    skip |= ValidateDrawState(*descriptor_set, set_index, binding_req_map, cb_state, vuid, pipeline.Handle(),
+                                              ds_slot.validated_set_change_count);
                 }
             }
         }
@@ -1469,11 +1485,14 @@ bool CoreChecks::ValidateActionStateDescriptorsShaderObject(const LastBound &las
                     const auto *descriptor_set = ds_slot.ds_state.get();
                     ASSERT_AND_CONTINUE(descriptor_set);
 
-                    const bool need_validate =
-                        NeedDrawStateValidated(cb_state, descriptor_set, ds_slot, disabled[image_layout_validation]);
-                    if (need_validate) {
+                    const DrawStateValidation need_validate = NeedDrawStateValidated(cb_state, descriptor_set, binding_req_map,
+                                                                                     ds_slot, disabled[image_layout_validation]);
+                    if (need_validate == DrawStateValidation::kAll) {
                         skip |=
                             ValidateDrawState(*descriptor_set, set_index, binding_req_map, cb_state, vuid, shader_state->Handle());
+                    } else if (need_validate == DrawStateValidation::kChangedBindings) {
+                        skip |= ValidateDrawState(*descriptor_set, set_index, binding_req_map, cb_state, vuid,
+                                                  shader_state->Handle(), ds_slot.validated_set_change_count);
                     }
                 }
             }
@@ -192,39 +192,67 @@ struct GlobalLayoutUpdater {
     }
 };
 
-// This validates that the initial layout specified in the command buffer for the IMAGE is the same as the global IMAGE layout
-bool CoreChecks::ValidateCmdBufImageLayouts(const Location &loc, const vvl::CommandBuffer &cb_state,
-                                            GlobalImageLayoutMap &global_image_layout_map) const {
-    if (disabled[image_layout_validation]) return false;
-    bool skip = false;
-    // Iterate over the layout maps for each referenced image
-    GlobalImageLayoutRangeMap empty_map(1);
-    for (const auto &[image, image_layout_registry] : cb_state.image_layout_map) {
-        if (!image_layout_registry) continue;
-        const auto image_state = Get<vvl::Image>(image);
-        if (!image_state) continue;
-
-        // TODO - things like ANGLE might have external images which have their layouts transitioned implicitly
-        // https://github.com/KhronosGroup/Vulkan-ValidationLayers/issues/8940
-        if (image_state->external_memory_handle_types != 0) {
-            continue;
+// Below this many images, submit time layout validation is not worth splitting across threads
+static constexpr size_t kParallelImageLayoutThreshold = 32;
+
+namespace {
+// Per image state of ValidateCmdBufImageLayouts. The walk over the layouts runs in parallel, errors are reported
+// afterwards in image order so the output does not depend on scheduling.
+struct ImageLayoutCheck {
+    std::shared_ptr<const vvl::Image> image_state;
+    const ImageLayoutRegistry::LayoutMap *layout_map = nullptr;
+    GlobalImageLayoutRangeMap *overlay_map = nullptr;
+    bool has_overlay = false;
+
+    struct Mismatch {
+        ImageLayoutRegistry::RangeType range;
+        VkImageLayout initial_layout;
+        VkImageLayout image_layout;
+    };
+    std::vector<Mismatch> mismatches;
+    // Set when the image passed and its result can be cached
+    std::optional<uint64_t> validated_version;
+};
+}  // namespace
+
+// Compare the initial layouts recorded in the command buffer with the current layouts (overlay of the earlier command buffers of
+// this submission, or global image state) and then apply the command buffer's layout changes to the overlay.
+// Only touches state of this one image, so it can run concurrently for different images.
+static void CheckImageLayouts(ImageLayoutCheck &check, const vvl::CommandBuffer::ImageLayoutValidationCache *cache,
+                              bool cache_hit) {
+    const auto &layout_map = *check.layout_map;
+    const auto *global_range_map = check.image_state->layout_range_map.get();
+    auto global_range_map_guard = global_range_map->ReadLock();
+    const uint64_t global_version = global_range_map->Version();
+
+    if (cache_hit && !check.has_overlay) {
+        auto cached = cache->layout_map_versions.find(global_range_map);
+        if (cached != cache->layout_map_versions.end() && cached->second == global_version) {
+            check.validated_version.emplace(global_version);
+            sparse_container::splice(*check.overlay_map, layout_map, GlobalLayoutUpdater());
+            return;
         }
+    }
 
-        const auto &layout_map = image_layout_registry->GetLayoutMap();
-        // Validate the initial_uses for each subresource referenced
-        if (layout_map.empty()) continue;
-
-        auto *overlay_map = GetLayoutRangeMap(global_image_layout_map, *image_state);
-        const auto *global_range_map = image_state->layout_range_map.get();
-        ASSERT_AND_CONTINUE(global_range_map);
-        auto global_range_map_guard = global_range_map->ReadLock();
-
-        // Note: don't know if it would matter
-        // if (global_range_map->empty() && overlay_map->empty()) // skip this next loop...;
-
+    // Nothing earlier in the submission touched the image and it is in a single layout, so each entry of the command buffer is
+    // compared against that one layout without walking the global map
+    const auto uniform_layout = check.overlay_map->empty() ? global_range_map->UniformLayout() : std::nullopt;
+    if (uniform_layout) {
+        for (const auto &[range, entry] : layout_map) {
+            const VkImageLayout initial_layout = entry.initial_layout;
+            if (initial_layout == image_layout_map::kInvalidLayout || initial_layout == VK_IMAGE_LAYOUT_UNDEFINED ||
+                initial_layout == *uniform_layout) {
+                continue;
+            }
+            const auto aspect_mask = check.image_state->subresource_encoder.Decode(range.begin).aspectMask;
+            if (!ImageLayoutMatches(aspect_mask, *uniform_layout, initial_layout)) {
+                check.mismatches.emplace_back(ImageLayoutCheck::Mismatch{range, initial_layout, *uniform_layout});
+            }
+        }
+    } else {
         auto pos = layout_map.begin();
         const auto end = layout_map.end();
-        sparse_container::parallel_iterator<const GlobalImageLayoutRangeMap> current_layout(*overlay_map, *global_range_map,
+        sparse_container::parallel_iterator<const GlobalImageLayoutRangeMap> current_layout(*check.overlay_map, *global_range_map,
                                                                                             pos->first.begin);
         while (pos != end) {
             VkImageLayout initial_layout = pos->second.initial_layout;
@@ -244,22 +272,10 @@ bool CoreChecks::ValidateCmdBufImageLayouts(const Location &loc, const vvl::Comm
             if (initial_layout == VK_IMAGE_LAYOUT_UNDEFINED) {
                 // TODO: Set memory invalid which is in mem_tracker currently
             } else if (image_layout != initial_layout) {
-                const auto aspect_mask = image_state->subresource_encoder.Decode(intersected_range.begin).aspectMask;
+                const auto aspect_mask = check.image_state->subresource_encoder.Decode(intersected_range.begin).aspectMask;
                 const bool matches = ImageLayoutMatches(aspect_mask, image_layout, initial_layout);
                 if (!matches) {
-                    // We can report all the errors for the intersected range directly
-                    for (auto index : vvl::range_view<decltype(intersected_range)>(intersected_range)) {
-                        const auto subresource = image_state->subresource_encoder.Decode(index);
-                        const LogObjectList objlist(cb_state.Handle(), image_state->Handle());
-                        // TODO - We need a way to map the action command to which caused this error
-                        const vvl::DrawDispatchVuid &vuid = GetDrawDispatchVuid(vvl::Func::vkCmdDraw);
-                        skip |= LogError(
-                            vuid.image_layout_09600, objlist, loc,
-                            "command buffer %s expects %s (subresource: %s) to be in layout %s--instead, current layout is %s.",
-                            FormatHandle(cb_state).c_str(), FormatHandle(*image_state).c_str(),
-                            string_VkImageSubresource(subresource).c_str(), string_VkImageLayout(initial_layout),
-                            string_VkImageLayout(image_layout));
-                    }
+                    check.mismatches.emplace_back(ImageLayoutCheck::Mismatch{intersected_range, initial_layout, image_layout});
                 }
             }
             if (pos->first.includes(intersected_range.end)) {
@@ -271,20 +287,122 @@ bool CoreChecks::ValidateCmdBufImageLayouts(const Location &loc, const vvl::Comm
                 }
             }
         }
-        // Update all layout set operations (which will be a subset of the initial_layouts)
-        sparse_container::splice(*overlay_map, layout_map, GlobalLayoutUpdater());
     }
+    if (cache && !check.has_overlay && check.mismatches.empty()) {
+        check.validated_version.emplace(global_version);
+    }
+    // Update all layout set operations (which will be a subset of the initial_layouts)
+    sparse_container::splice(*check.overlay_map, layout_map, GlobalLayoutUpdater());
+}
 
+// This validates that the initial layout specified in the command buffer for the IMAGE is the same as the global IMAGE layout
+bool CoreChecks::ValidateCmdBufImageLayouts(const Location &loc, const vvl::CommandBuffer &cb_state,
+                                            GlobalImageLayoutMap &global_image_layout_map) const {
+    if (disabled[image_layout_validation]) return false;
+    bool skip = false;
+
+    // With command buffer fingerprinting, an image doesn't need to be checked again if an identical recording of this command
+    // buffer already passed this validation and the global layouts of the image did not change since
+    std::unique_lock<std::mutex> cache_lock;
+    vvl::CommandBuffer::ImageLayoutValidationCache *cache = nullptr;
+    if (global_settings.command_buffer_fingerprinting && cb_state.fingerprint != 0) {
+        cache_lock = std::unique_lock<std::mutex>(cb_state.image_layout_validation_cache_lock);
+        cache = &cb_state.image_layout_validation_cache;
+    }
+    const bool cache_hit = cache && cache->fingerprint == cb_state.fingerprint;
+
+    // Gather the referenced images. Overlay maps are created here, so that the per image checks don't modify
+    // global_image_layout_map itself and can run in parallel
+    std::vector<ImageLayoutCheck> checks;
+    checks.reserve(cb_state.image_layout_map.size());
+    for (const auto &[image, image_layout_registry] : cb_state.image_layout_map) {
+        if (!image_layout_registry) continue;
+        auto image_state = Get<vvl::Image>(image);
+        if (!image_state) continue;
+
+        // TODO - things like ANGLE might have external images which have their layouts transitioned implicitly
+        // https://github.com/KhronosGroup/Vulkan-ValidationLayers/issues/8940
+        if (image_state->external_memory_handle_types != 0) {
+            continue;
+        }
+
+        const auto &layout_map = image_layout_registry->GetLayoutMap();
+        // Validate the initial_uses for each subresource referenced
+        if (layout_map.empty()) continue;
+        ASSERT_AND_CONTINUE(image_state->layout_range_map);
+
+        ImageLayoutCheck &check = checks.emplace_back();
+        // Earlier command buffers of this submission may have changed the layouts, the cached result does not account for that
+        check.has_overlay = global_image_layout_map.find(image_state.get()) != global_image_layout_map.end();
+        check.overlay_map = GetLayoutRangeMap(global_image_layout_map, *image_state);
+        check.layout_map = &layout_map;
+        check.image_state = std::move(image_state);
+    }
+
+    if (checks.size() >= kParallelImageLayoutThreshold) {
+        device_state->validation_thread_pool.ParallelFor(
+            checks.size(), [&checks, cache, cache_hit](size_t i) { CheckImageLayouts(checks[i], cache, cache_hit); });
+    } else {
+        for (ImageLayoutCheck &check : checks) {
+            CheckImageLayouts(check, cache, cache_hit);
+        }
+    }
+
+    vvl::unordered_map<const GlobalImageLayoutRangeMap *, uint64_t> validated_versions;
+    for (const ImageLayoutCheck &check : checks) {
+        const vvl::Image &image_state = *check.image_state;
+        if (check.validated_version) {
+            validated_versions.emplace(image_state.layout_range_map.get(), *check.validated_version);
+        }
+        for (const ImageLayoutCheck::Mismatch &mismatch : check.mismatches) {
+            // We can report all the errors for the intersected range directly
+            for (auto index : vvl::range_view<decltype(mismatch.range)>(mismatch.range)) {
+                const auto subresource = image_state.subresource_encoder.Decode(index);
+                const LogObjectList objlist(cb_state.Handle(), image_state.Handle());
+                // TODO - We need a way to map the action command to which caused this error
+                const vvl::DrawDispatchVuid &vuid = GetDrawDispatchVuid(vvl::Func::vkCmdDraw);
+                skip |= LogError(
+                    vuid.image_layout_09600, objlist, loc,
+                    "command buffer %s expects %s (subresource: %s) to be in layout %s--instead, current layout is %s.",
+                    FormatHandle(cb_state).c_str(), FormatHandle(image_state).c_str(),
+                    string_VkImageSubresource(subresource).c_str(), string_VkImageLayout(mismatch.initial_layout),
+                    string_VkImageLayout(mismatch.image_layout));
+            }
+        }
+    }
+
+    if (cache) {
+        // Only a fully clean recording is worth remembering
+        cache->fingerprint = skip ? 0 : cb_state.fingerprint;
+        cache->layout_map_versions = std::move(validated_versions);
+    }
     return skip;
 }
 
 void CoreChecks::UpdateCmdBufImageLayouts(const vvl::CommandBuffer &cb_state) {
-    for (const auto &[image, image_layout_registry] : cb_state.image_layout_map) {
+    auto update_image = [this](VkImage image, const std::shared_ptr<ImageLayoutRegistry> &image_layout_registry) {
         const auto image_state = Get<vvl::Image>(image);
         if (image_state && image_layout_registry && image_state->GetId() == image_layout_registry->GetImageId()) {
             auto guard = image_state->layout_range_map->WriteLock();
-            sparse_container::splice(*image_state->layout_range_map, image_layout_registry->GetLayoutMap(), GlobalLayoutUpdater());
+            if (sparse_container::splice(*image_state->layout_range_map, image_layout_registry->GetLayoutMap(),
+                                         GlobalLayoutUpdater())) {
+                image_state->layout_range_map->UpdateVersion();
+            }
         }
+    };
+    // Each image has its own global layout map and lock, so they can be updated in parallel
+    if (cb_state.image_layout_map.size() >= kParallelImageLayoutThreshold) {
+        std::vector<const vvl::CommandBuffer::ImageLayoutMap::value_type *> entries;
+        entries.reserve(cb_state.image_layout_map.size());
+        for (const auto &entry : cb_state.image_layout_map) {
+            entries.emplace_back(&entry);
+        }
+        device_state->validation_thread_pool.ParallelFor(
+            entries.size(), [&entries, &update_image](size_t i) { update_image(entries[i]->first, entries[i]->second); });
+        return;
+    }
+    for (const auto &[image, image_layout_registry] : cb_state.image_layout_map) {
+        update_image(image, image_layout_registry);
     }
 }
 
@@ -18,6 +18,7 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <string>
 #include <vector>
 
@@ -299,6 +300,26 @@ bool CoreChecks::PreCallValidateDestroyPipeline(VkDevice device, VkPipeline pipe
     return skip;
 }
 
+void CoreChecks::PreCallRecordDestroyPipeline(VkDevice device, VkPipeline pipeline, const VkAllocationCallbacks *pAllocator,
+                                              const RecordObject &record_obj) {
+    auto pipeline_state = Get<vvl::Pipeline>(pipeline);
+    if (pipeline_state && (pipeline_state->create_flags & VK_PIPELINE_CREATE_LIBRARY_BIT_KHR)) {
+        // Ids are never reused, so this only keeps the set from growing with every library the application ever linked
+        const uint32_t library_id = pipeline_state->GetId();
+        WriteLockGuard guard(validated_linked_libraries_lock);
+        std::vector<LinkedLibrariesKey> stale_keys;
+        for (const auto &key : validated_linked_libraries) {
+            if (std::find(key.begin(), key.end(), library_id) != key.end()) {
+                stale_keys.emplace_back(key);
+            }
+        }
+        for (const auto &key : stale_keys) {
+            validated_linked_libraries.erase(key);
+        }
+    }
+    BaseClass::PreCallRecordDestroyPipeline(device, pipeline, pAllocator, record_obj);
+}
+
 bool CoreChecks::ValidateCmdBindPipelineRenderPassMultisample(const vvl::CommandBuffer &cb_state,
                                                               const vvl::Pipeline &pipeline_state, const vvl::RenderPass &rp_state,
                                                               const Location &loc) const {
@@ -374,6 +374,11 @@ bool CoreChecks::ValidateRenderPassCompatibility(const VulkanTypedHandle &rp1_ob
                                                  const Location &loc, const char *vuid) const {
     bool skip = false;
 
+    // Same canonical Id means every field compared below is the same, only walk them when there is something to report
+    if (rp1_state.compatibility_id && rp1_state.compatibility_id == rp2_state.compatibility_id) {
+        return skip;
+    }
+
     // createInfo flags must be identical for the renderpasses to be compatible.
     if (rp1_state.create_info.flags != rp2_state.create_info.flags) {
         const LogObjectList objlist(rp1_object, rp1_state.Handle(), rp2_object, rp2_state.Handle());
@@ -17,7 +17,9 @@
  * limitations under the License.
  */
 
+#include <array>
 #include <cassert>
+#include <optional>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -681,6 +683,28 @@ bool CoreChecks::ValidatePipelineTessellationStages(const spirv::Module &tesc_mo
     return skip;
 }
 
+// Only set for pipelines where all the sub states come from linked libraries, as everything the shader state checks look at then
+// depends on the libraries alone
+static std::optional<CoreChecks::LinkedLibrariesKey> GetLinkedLibrariesKey(const vvl::Pipeline &pipeline) {
+    if (!pipeline.library_create_info) {
+        return std::nullopt;
+    }
+    const std::array<const PipelineSubState *, 4> sub_states = {pipeline.vertex_input_state.get(), pipeline.pre_raster_state.get(),
+                                                                pipeline.fragment_shader_state.get(),
+                                                                pipeline.fragment_output_state.get()};
+    CoreChecks::LinkedLibrariesKey key = {};
+    for (size_t i = 0; i < sub_states.size(); ++i) {
+        if (!sub_states[i]) {
+            continue;
+        }
+        if (&sub_states[i]->parent == &pipeline) {
+            return std::nullopt;
+        }
+        key[i] = sub_states[i]->parent.GetId();
+    }
+    return key;
+}
+
 // Validate that the shaders used by the given pipeline and store the active_slots
 //  that are actually used by the pipeline into pPipeline->active_slots
 bool CoreChecks::ValidateGraphicsPipelineShaderState(const vvl::Pipeline &pipeline, const Location &create_info_loc) const {
@@ -691,6 +715,17 @@ bool CoreChecks::ValidateGraphicsPipelineShaderState(const vvl::Pipeline &pipeli
         return skip;
     }
 
+    // Failures are not cached so they are reported again for every pipeline linking the same libraries
+    const auto linked_libraries_key = GetLinkedLibrariesKey(pipeline);
+    if (linked_libraries_key) {
+        ReadLockGuard guard(validated_linked_libraries_lock);
+        if (validated_linked_libraries.find(*linked_libraries_key) != validated_linked_libraries.end()) {
+            return skip;
+        }
+    }
+    // Errors that are logged but don't set skip (e.g. filtered out or allowed by the application) must not be cached either
+    const uint64_t logged_before = LoggedMessageCount();
+
     const ShaderStageState *vertex_stage = nullptr, *tesc_stage = nullptr, *tese_stage = nullptr, *fragment_stage = nullptr;
     for (uint32_t i = 0; i < pipeline.stage_states.size(); i++) {
         auto &stage_state = pipeline.stage_states[i];
@@ -801,5 +836,9 @@ bool CoreChecks::ValidateGraphicsPipelineShaderState(const vvl::Pipeline &pipeli
                                                    *tese_stage->entrypoint, create_info_loc);
     }
 
+    if (linked_libraries_key && !skip && LoggedMessageCount() == logged_before) {
+        WriteLockGuard guard(validated_linked_libraries_lock);
+        validated_linked_libraries.insert(*linked_libraries_key);
+    }
     return skip;
 }
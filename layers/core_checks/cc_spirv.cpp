@@ -2068,8 +2068,10 @@ void CoreChecks::PreCallRecordCreateShaderModule(VkDevice device, const VkShader
     // This is on the stack, we don't have to worry about threading hazards and this could be moved and used const_cast
     BaseClass::PreCallRecordCreateShaderModule(device, pCreateInfo, pAllocator, pShaderModule, record_obj,
                                                             chassis_state);
+    if (!chassis_state.module_state) return;
     chassis_state.skip |=
-        stateless_spirv_validator.Validate(*chassis_state.module_state, chassis_state.stateless_data, record_obj.location);
+        RunStatelessSpirvValidation(*chassis_state.module_state, chassis_state.stateless_data, pCreateInfo->pCode,
+                                    pCreateInfo->codeSize, GetShaderModuleValidationCache(*pCreateInfo), record_obj.location);
 }
 
 void CoreChecks::PreCallRecordCreateShadersEXT(VkDevice device, uint32_t createInfoCount, const VkShaderCreateInfoEXT *pCreateInfos,
@@ -2077,14 +2079,55 @@ void CoreChecks::PreCallRecordCreateShadersEXT(VkDevice device, uint32_t createI
                                                const RecordObject &record_obj, chassis::ShaderObject &chassis_state) {
     BaseClass::PreCallRecordCreateShadersEXT(device, createInfoCount, pCreateInfos, pAllocator, pShaders, record_obj,
                                                           chassis_state);
+    // Currently we don't provide a way for apps to supply their own cache for shader object
+    ValidationCache *cache = CastFromHandle<ValidationCache *>(core_validation_cache);
     for (uint32_t i = 0; i < createInfoCount; ++i) {
         if (chassis_state.module_states[i]) {
-            chassis_state.skip |= stateless_spirv_validator.Validate(
-                *chassis_state.module_states[i], chassis_state.stateless_data[i], record_obj.location.dot(Field::pCreateInfos, i));
+            const VkShaderCreateInfoEXT &create_info = pCreateInfos[i];
+            chassis_state.skip |= RunStatelessSpirvValidation(
+                *chassis_state.module_states[i], chassis_state.stateless_data[i], static_cast<const uint32_t *>(create_info.pCode),
+                create_info.codeSize, cache, record_obj.location.dot(Field::pCreateInfos, i));
         }
     }
 }
 
+ValidationCache *CoreChecks::GetShaderModuleValidationCache(const VkShaderModuleCreateInfo &create_info) const {
+    const auto validation_cache_ci = vku::FindStructInPNextChain<VkShaderModuleValidationCacheCreateInfoEXT>(create_info.pNext);
+    ValidationCache *cache =
+        validation_cache_ci ? CastFromHandle<ValidationCache *>(validation_cache_ci->validationCache) : nullptr;
+    // If app isn't using a shader validation cache, use the default one from CoreChecks
+    if (!cache) {
+        cache = CastFromHandle<ValidationCache *>(core_validation_cache);
+    }
+    return cache;
+}
+
+// The stateless SPIR-V checks only depend on the module and the device creation state, so a module that passed them on a previous
+// run (or earlier in this one) with the same device state can skip them
+bool CoreChecks::RunStatelessSpirvValidation(const spirv::Module &module_state, const spirv::StatelessData &stateless_data,
+                                             const uint32_t *code, size_t code_size, ValidationCache *cache,
+                                             const Location &loc) const {
+    bool skip = false;
+    ValidationCache::Key key = 0;
+    if (cache && code) {
+        key = cache->MakeKey(code, code_size);
+        if (cache->Contains(key, ValidationCache::kStatelessSpirv)) {
+            return skip;
+        }
+    }
+
+    const uint64_t logged_before = LoggedMessageCount();
+    skip |= stateless_spirv_validator.Validate(module_state, stateless_data, loc);
+
+    // Only a module that was actually parsed can be marked as passing. |skip| is also false for errors that were muted by the
+    // message filter, the duplicate limit or a callback returning VK_FALSE, so only a run that logged nothing is cached (a message
+    // logged by another thread meanwhile just means the module is checked again next time)
+    if (cache && code && module_state.valid_spirv && LoggedMessageCount() == logged_before) {
+        cache->Insert(key, ValidationCache::kStatelessSpirv);
+    }
+    return skip;
+}
+
 bool CoreChecks::RunSpirvValidation(spv_const_binary_t &binary, const Location &loc, ValidationCache *cache) const {
     bool skip = false;
 
@@ -2092,10 +2135,10 @@ bool CoreChecks::RunSpirvValidation(spv_const_binary_t &binary, const Location &
         return skip;
     }
 
-    uint32_t hash = 0;
+    ValidationCache::Key key = 0;
     if (cache) {
-        hash = hash_util::Hash32((void *)binary.code, binary.wordCount * sizeof(uint32_t));
-        if (cache->Contains(hash)) {
+        key = cache->MakeKey(binary.code, binary.wordCount * sizeof(uint32_t));
+        if (cache->Contains(key, ValidationCache::kSpirvVal)) {
             return skip;
         }
     }
@@ -2144,7 +2187,7 @@ bool CoreChecks::RunSpirvValidation(spv_const_binary_t &binary, const Location &
         }
     } else if (cache) {
         // No point to cache anything that is not valid, or it will get supressed on the next run
-        cache->Insert(hash);
+        cache->Insert(key, ValidationCache::kSpirvVal);
     }
 
     spvDiagnosticDestroy(diag);
@@ -2174,16 +2217,8 @@ bool CoreChecks::ValidateShaderModuleCreateInfo(const VkShaderModuleCreateInfo &
     } else {
         // if pCode is garbage, don't pass along to spirv-val
 
-        const auto validation_cache_ci = vku::FindStructInPNextChain<VkShaderModuleValidationCacheCreateInfoEXT>(create_info.pNext);
-        ValidationCache *cache =
-            validation_cache_ci ? CastFromHandle<ValidationCache *>(validation_cache_ci->validationCache) : nullptr;
-        // If app isn't using a shader validation cache, use the default one from CoreChecks
-        if (!cache) {
-            cache = CastFromHandle<ValidationCache *>(core_validation_cache);
-        }
-
         spv_const_binary_t binary{create_info.pCode, create_info.codeSize / sizeof(uint32_t)};
-        skip |= RunSpirvValidation(binary, create_info_loc, cache);
+        skip |= RunSpirvValidation(binary, create_info_loc, GetShaderModuleValidationCache(create_info));
     }
 
     return skip;
@@ -27,6 +27,8 @@
 #include "error_message/record_object.h"
 #include "containers/qfo_transfer.h"
 #include "containers/custom_containers.h"
+#include "utils/hash_util.h"
+#include <array>
 #include <spirv-tools/libspirv.hpp>
 
 // TODO - Get to work with non-STL custom hashmap
@@ -196,15 +198,26 @@ class CoreChecks : public vvl::DeviceProxy {
     GlobalQFOTransferBarrierMap<QFOImageTransferBarrier> qfo_release_image_barrier_map;
     GlobalQFOTransferBarrierMap<QFOBufferTransferBarrier> qfo_release_buffer_barrier_map;
     VkValidationCacheEXT core_validation_cache = VK_NULL_HANDLE;
-    std::string validation_cache_path;
+    std::shared_ptr<ValidationCacheFile> validation_cache_file;
 
     // The options are set from extensions/features only, so only need ot create once.
     // This also is needed for shader caching (You can have the same SPIR-V, but different Vulkan features making it legal/illegal
     // the second time).
     spvtools::ValidatorOptions spirv_val_options;
     uint32_t spirv_val_option_hash;
+    // Seeds the ValidationCache keys, as cached module-level checks also depend on features/properties spirv-val ignores
+    uint64_t validation_cache_device_hash;
     stateless::SpirvValidator stateless_spirv_validator;
 
+    // Ids of the graphics pipeline libraries providing the vertex input, pre-raster, fragment shader and fragment output state
+    // (0 if absent) of a pipeline that only links libraries
+    using LinkedLibrariesKey = std::array<uint32_t, 4>;
+    // Library combinations that already linked without shader interface errors. Linking the same libraries again gives the same
+    // results, so the cross stage interface checks are skipped for them. Entries are dropped once one of their libraries is
+    // destroyed.
+    mutable std::shared_mutex validated_linked_libraries_lock;
+    mutable vvl::unordered_set<LinkedLibrariesKey, hash_util::IsOrderedContainer<LinkedLibrariesKey>> validated_linked_libraries;
+
     CoreChecks(vvl::dispatch::Device* dev, core::Instance* instance_vo)
         : BaseClass(dev, instance_vo, LayerObjectTypeCoreValidation),
           stateless_spirv_validator(dev->debug_report, dev->stateless_device_data) {}
@@ -718,9 +731,10 @@ class CoreChecks : public vvl::DeviceProxy {
     VkResult CoreLayerGetValidationCacheDataEXT(VkDevice device, VkValidationCacheEXT validationCache, size_t* pDataSize,
                                                 void* pData) override;
     // For given bindings validate state at time of draw is correct, returning false on error and writing error details into string*
+    // If validated_change_count is set, only bindings updated after that set change count are validated
     bool ValidateDrawState(const vvl::DescriptorSet& descriptor_set, uint32_t set_index, const BindingVariableMap& binding_req_map,
                            const vvl::CommandBuffer& cb_state, const vvl::DrawDispatchVuid& vuid,
-                           const VulkanTypedHandle& shader_handle) const;
+                           const VulkanTypedHandle& shader_handle, std::optional<uint64_t> validated_change_count = {}) const;
 
     bool ImmutableSamplersAreEqual(const VkDescriptorSetLayoutBinding& b1, const VkDescriptorSetLayoutBinding& b2,
                                    bool& out_exception) const;
@@ -856,6 +870,9 @@ class CoreChecks : public vvl::DeviceProxy {
                                        const VkAllocationCallbacks* pAllocator, VkShaderEXT* pShaders,
                                        const RecordObject& record_obj, chassis::ShaderObject& chassis_state) override;
     bool RunSpirvValidation(spv_const_binary_t& binary, const Location& loc, ValidationCache* cache) const;
+    ValidationCache* GetShaderModuleValidationCache(const VkShaderModuleCreateInfo& create_info) const;
+    bool RunStatelessSpirvValidation(const spirv::Module& module_state, const spirv::StatelessData& stateless_data,
+                                     const uint32_t* code, size_t code_size, ValidationCache* cache, const Location& loc) const;
     bool ValidateShaderModuleCreateInfo(const VkShaderModuleCreateInfo& create_info, const Location& create_info_loc) const;
     bool PreCallValidateCreateShaderModule(VkDevice device, const VkShaderModuleCreateInfo* pCreateInfo,
                                            const VkAllocationCallbacks* pAllocator, VkShaderModule* pShaderModule,
@@ -1542,6 +1559,8 @@ class CoreChecks : public vvl::DeviceProxy {
     bool GetPhysicalDeviceImageFormatProperties(vvl::Image& image_state, const char* vuid_string, const Location& loc) const;
     bool PreCallValidateDestroyPipeline(VkDevice device, VkPipeline pipeline, const VkAllocationCallbacks* pAllocator,
                                         const ErrorObject& error_obj) const override;
+    void PreCallRecordDestroyPipeline(VkDevice device, VkPipeline pipeline, const VkAllocationCallbacks* pAllocator,
+                                      const RecordObject& record_obj) override;
     bool PreCallValidateDestroySampler(VkDevice device, VkSampler sampler, const VkAllocationCallbacks* pAllocator,
                                        const ErrorObject& error_obj) const override;
     bool PreCallValidateDestroyDescriptorPool(VkDevice device, VkDescriptorPool descriptorPool,
@@ -118,6 +118,8 @@ bool DebugReport::LogMessage(VkFlags msg_flags, std::string_view vuid_text, cons
     VkDebugUtilsMessageTypeFlagsEXT msg_type;
     DebugReportFlagsToAnnotFlags(msg_flags, &msg_severity, &msg_type);
 
+    logged_message_count.fetch_add(1, std::memory_order_relaxed);
+
     std::unique_lock<std::mutex> lock(debug_output_mutex);
 
     // Avoid logging cost if msg is to be ignored
@@ -18,6 +18,7 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <cstdarg>
 #include <mutex>
 #include <string>
@@ -202,6 +203,9 @@ class DebugReport {
     bool force_default_log_callback{false};
     uint32_t device_created = 0;
     MessageFormatSettings message_format_settings;
+    // Every message passed to LogMessage, counted before the severity, filter and duplicate limit checks can drop it, so callers
+    // caching a validation result can tell if anything was reported while it ran
+    std::atomic<uint64_t> logged_message_count{0};
 
     void SetUtilsObjectName(const VkDebugUtilsObjectNameInfoEXT *pNameInfo);
     void SetMarkerObjectName(const VkDebugMarkerObjectNameInfoEXT *pNameInfo);
@@ -268,6 +272,8 @@ class Logger {
         return debug_report->FormatHandle(std::forward<T>(h));
     }
 
+    uint64_t LoggedMessageCount() const { return debug_report->logged_message_count.load(std::memory_order_relaxed); }
+
     // Debug Logging Helpers
     bool DECORATE_PRINTF(5, 6)
         LogError(std::string_view vuid_text, const LogObjectList &objlist, const Location &loc, const char *format, ...) const {
@@ -81,7 +81,13 @@ using CHECK_ENABLED = std::array<bool, kMaxEnableFlags>;
 struct GlobalSettings {
     bool fine_grained_locking = true;
 
+    // Fingerprint recorded command buffers so unchanged re-recordings can reuse clean submit time results
+    bool command_buffer_fingerprinting = false;
+
     bool debug_disable_spirv_val = false;
+
+    // Directory of the shader validation cache file, the temp directory if empty
+    std::string shader_validation_cache_path;
 };
 
 class DebugReport;
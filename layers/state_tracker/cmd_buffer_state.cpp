@@ -25,6 +25,7 @@
 #include "state_tracker/buffer_state.h"
 #include "state_tracker/image_state.h"
 #include "state_tracker/queue_state.h"
+#include "utils/hash_util.h"
 #include "utils/vk_layer_utils.h"
 
 static ShaderObjectStage inline ConvertToShaderObjectStage(VkShaderStageFlagBits stage) {
@@ -215,12 +216,32 @@ void CommandBuffer::RemoveChild(std::shared_ptr<StateObject> &child_node) {
 
 // Reset the command buffer state
 // Maintain the createInfo and set state to CB_NEW, but clear all other state
+template <typename Container>
+static void ResetWithArena(Container &container, vvl::RecordingArena *arena) {
+    container = Container(typename Container::allocator_type(arena));
+}
+
+// Swapping in empty containers releases the arena memory, the allocator goes along with the move assignment
+void CommandBuffer::ResetRecordingContainers(vvl::RecordingArena *arena) {
+    ResetWithArena(object_bindings, arena);
+    ResetWithArena(waitedEvents, arena);
+    ResetWithArena(activeQueries, arena);
+    ResetWithArena(startedQueries, arena);
+    ResetWithArena(renderPassQueries, arena);
+    ResetWithArena(image_layout_map, arena);
+    ResetWithArena(aliased_image_layout_map, arena);
+    ResetWithArena(current_vertex_buffer_binding_info, arena);
+}
+
 void CommandBuffer::ResetCBState() {
     // Remove object bindings
     for (const auto &obj : object_bindings) {
         obj->RemoveParent(this);
     }
-    object_bindings.clear();
+    // The containers are moved off the arena before it is rewound, nothing can be left pointing into it
+    ResetRecordingContainers(nullptr);
+    recording_arena.Rewind();
+    ResetRecordingContainers(&recording_arena);
     broken_bindings.clear();
 
     // Reset CB state (note that createInfo is not cleared)
@@ -237,6 +258,8 @@ void CommandBuffer::ResetCBState() {
     command_count = 0;
     submitCount = 0;
     image_layout_change_count = 1;  // Start at 1. 0 is insert value for validation cache versions, s.t. new == dirty
+    command_stream_hash = 0;
+    fingerprint = 0;
 
     dynamic_state_status.cb.reset();
     dynamic_state_status.pipeline.reset();
@@ -273,15 +296,8 @@ void CommandBuffer::ResetCBState() {
     active_subpass_contents = VK_SUBPASS_CONTENTS_INLINE;
     SetActiveSubpass(0);
     rendering_attachments.Reset();
-    waitedEvents.clear();
     events.clear();
     writeEventsBeforeWait.clear();
-    activeQueries.clear();
-    startedQueries.clear();
-    renderPassQueries.clear();
-    image_layout_map.clear();
-    aliased_image_layout_map.clear();
-    current_vertex_buffer_binding_info.clear();
     primaryCommandBuffer = VK_NULL_HANDLE;
     linkedCommandBuffers.clear();
     queue_submit_functions.clear();
@@ -329,6 +345,9 @@ void CommandBuffer::ResetCBState() {
 }
 
 void CommandBuffer::Reset(const Location &loc) {
+    for (auto &item : sub_states_) {
+        item.second->PreReset();
+    }
     ResetCBState();
     // Remove reverse command buffer links.
     Invalidate(true);
@@ -360,6 +379,9 @@ void CommandBuffer::ResetPushConstantRangesLayoutIfIncompatible(const vvl::Pipel
 }
 
 void CommandBuffer::Destroy() {
+    for (auto &item : sub_states_) {
+        item.second->PreDestroy();
+    }
     // Remove the cb debug labels
     dev_data.debug_report->EraseCmdDebugUtilsLabel(VkHandle());
     {
@@ -1093,9 +1115,43 @@ void CommandBuffer::Begin(const VkCommandBufferBeginInfo *pBeginInfo) {
 void CommandBuffer::End(VkResult result) {
     if (VK_SUCCESS == result) {
         state = CbState::Recorded;
+        if (dev_data.global_settings.command_buffer_fingerprinting) {
+            fingerprint = ComputeFingerprint();
+        }
     }
 }
 
+// The fingerprint covers the sequence of recorded commands, the objects referenced by the command buffer and the image layout
+// transitions and expectations that submit time validation checks. Objects are identified by their unique id since, unlike
+// handles, those are never reused.
+uint64_t CommandBuffer::ComputeFingerprint() const {
+    hash_util::HashCombiner hc(command_stream_hash);
+    hc << command_count;
+
+    // Order independent combination, the containers are unordered
+    size_t objects_hash = 0;
+    for (const auto &obj : object_bindings) {
+        objects_hash ^= hash_util::HashCombiner().Combine(obj->GetId()).Value();
+    }
+    hc << objects_hash;
+
+    size_t layouts_hash = 0;
+    for (const auto &[image, image_layout_registry] : image_layout_map) {
+        if (!image_layout_registry) continue;
+        hash_util::HashCombiner image_hc;
+        image_hc << image_layout_registry->GetImageId();
+        for (const auto &[range, entry] : image_layout_registry->GetLayoutMap()) {
+            image_hc << range.begin << range.end << entry.initial_layout << entry.current_layout;
+        }
+        layouts_hash ^= image_hc.Value();
+    }
+    hc << layouts_hash;
+
+    // 0 is reserved for "no fingerprint"
+    const uint64_t result = hc.Value();
+    return result ? result : 1;
+}
+
 void CommandBuffer::ExecuteCommands(vvl::span<const VkCommandBuffer> secondary_command_buffers) {
     RecordCmd(Func::vkCmdExecuteCommands);
     for (const VkCommandBuffer sub_command_buffer : secondary_command_buffers) {
@@ -1266,20 +1322,28 @@ void CommandBuffer::UpdatePipelineState(Func command, const VkPipelineBindPoint
 
             // We can skip updating the state if "nothing" has changed since the last validation.
             // See CoreChecks::ValidateActionState for more details.
-            const bool need_update =  // Update if descriptor set (or contents) has changed
-                ds_slot.validated_set != descriptor_set.get() ||
-                ds_slot.validated_set_change_count != descriptor_set->GetChangeCount() ||
-                (!dev_data.disabled[image_layout_validation] &&
-                 ds_slot.validated_set_image_layout_change_count != image_layout_change_count);
+            const bool same_set = ds_slot.validated_set_id == descriptor_set->GetId();
+            const bool same_image_layouts = dev_data.disabled[image_layout_validation] ||
+                                            ds_slot.validated_set_image_layout_change_count == image_layout_change_count;
+            const bool same_bindings_used = ds_slot.validated_binding_req_map == &binding_req_map;
+            const bool need_update =  // Update if descriptor set (or contents, or the bindings used) has changed
+                !same_set || ds_slot.validated_set_change_count != descriptor_set->GetChangeCount() || !same_image_layouts ||
+                !same_bindings_used;
             if (need_update) {
                 if (!dev_data.disabled[command_buffer_state] && !descriptor_set->IsPushDescriptor()) {
                     AddChild(descriptor_set);
                 }
 
                 // Bind this set and its active descriptor resources to the command buffer
-                descriptor_set->UpdateImageLayoutDrawStates(&dev_data, *this, binding_req_map);
+                // If only the set contents changed, just the bindings updated since the last draw need to be revisited
+                std::optional<uint64_t> validated_change_count;
+                if (same_set && same_image_layouts && same_bindings_used) {
+                    validated_change_count = ds_slot.validated_set_change_count;
+                }
+                descriptor_set->UpdateImageLayoutDrawStates(&dev_data, *this, binding_req_map, validated_change_count);
 
-                ds_slot.validated_set = descriptor_set.get();
+                ds_slot.validated_set_id = descriptor_set->GetId();
+                ds_slot.validated_binding_req_map = &binding_req_map;
                 ds_slot.validated_set_change_count = descriptor_set->GetChangeCount();
                 ds_slot.validated_set_image_layout_change_count = image_layout_change_count;
             }
@@ -1516,6 +1580,9 @@ void CommandBuffer::SetImageViewLayout(const vvl::ImageView &view_state, VkImage
 
 void CommandBuffer::RecordCmd(Func command) {
     command_count++;
+    if (dev_data.global_settings.command_buffer_fingerprinting) {
+        command_stream_hash = hash_util::HashCombiner(command_stream_hash).Combine(command).Value();
+    }
     for (auto &item : sub_states_) {
         item.second->RecordCmd(command);
     }
@@ -23,9 +23,13 @@
 #include "state_tracker/pipeline_state.h"
 #include "state_tracker/query_state.h"
 #include "state_tracker/vertex_index_buffer_state.h"
+#include "containers/inline_function.h"
 #include "containers/qfo_transfer.h"
+#include "containers/recording_arena.h"
 #include "generated/dynamic_state_helper.h"
 
+#include <mutex>
+
 namespace vvl {
 class Bindable;
 class Buffer;
@@ -165,8 +169,15 @@ struct LabelCommand {
 class CommandBuffer : public RefcountedStateObject, public SubStateManager<CommandBufferSubState> {
     using Func = vvl::Func;
   public:
-    using ImageLayoutMap = vvl::unordered_map<VkImage, std::shared_ptr<ImageLayoutRegistry>>;
-    using AliasedLayoutMap = vvl::unordered_map<const GlobalImageLayoutRangeMap *, std::shared_ptr<ImageLayoutRegistry>>;
+    // Containers that are refilled by every recording, their memory comes from recording_arena
+    template <typename Key>
+    using RecordingSet = vvl::unordered_set<Key, vvl::hash<Key>, std::equal_to<Key>, vvl::recording_arena_allocator<Key>>;
+    template <typename Key, typename T>
+    using RecordingMap =
+        vvl::unordered_map<Key, T, vvl::hash<Key>, std::equal_to<Key>, vvl::recording_arena_allocator<std::pair<const Key, T>>>;
+
+    using ImageLayoutMap = RecordingMap<VkImage, std::shared_ptr<ImageLayoutRegistry>>;
+    using AliasedLayoutMap = RecordingMap<const GlobalImageLayoutRangeMap *, std::shared_ptr<ImageLayoutRegistry>>;
 
     VkCommandBufferAllocateInfo allocate_info;
     VkCommandBufferBeginInfo beginInfo;
@@ -192,6 +203,19 @@ class CommandBuffer : public RefcountedStateObject, public SubStateManager<Comma
     typedef uint64_t ImageLayoutUpdateCount;
     ImageLayoutUpdateCount image_layout_change_count;  // The sequence number for changes to image layout (for cached validation)
 
+    // Command stream fingerprinting, only done with the command_buffer_fingerprinting setting
+    uint64_t command_stream_hash;  // Running hash of the recorded commands
+    uint64_t fingerprint;          // Identifies the contents of the last completed recording (0 if not computed)
+
+    // The last recording that passed submit time image layout validation, along with the version of each global image layout
+    // map it was validated against. This is not cleared on reset, so an identical re-recording can reuse it.
+    struct ImageLayoutValidationCache {
+        uint64_t fingerprint = 0;
+        vvl::unordered_map<const GlobalImageLayoutRangeMap *, uint64_t> layout_map_versions;
+    };
+    mutable std::mutex image_layout_validation_cache_lock;
+    mutable ImageLayoutValidationCache image_layout_validation_cache;
+
     // Track status of all vkCmdSet* calls, if 1, means it was set
     struct DynamicStateStatus {
         CBDynamicFlags cb;        // for lifetime of CommandBuffer (invalidated if static pipeline is bound)
@@ -462,9 +486,12 @@ class CommandBuffer : public RefcountedStateObject, public SubStateManager<Comma
         active_subpass_sample_count_ = rasterization_sample_count;
     }
     std::shared_ptr<vvl::Framebuffer> activeFramebuffer;
+    // Rewound when the command buffer is reset, after the RecordingSet/RecordingMap members (declared below it, so they are
+    // destroyed first) have let go of their memory. Keeps the memory of the largest recording so far.
+    vvl::RecordingArena recording_arena;
     // Unified data structs to track objects bound to this command buffer as well as object
     //  dependencies that have been broken : either destroyed objects, or updated descriptor sets
-    vvl::unordered_set<std::shared_ptr<StateObject>> object_bindings;
+    RecordingSet<std::shared_ptr<StateObject>> object_bindings;
     vvl::unordered_map<VulkanTypedHandle, LogObjectList> broken_bindings;
 
     QFOTransferBarrierSets<QFOBufferTransferBarrier> qfo_transfer_buffer_barriers;
@@ -488,39 +515,42 @@ class CommandBuffer : public RefcountedStateObject, public SubStateManager<Comma
         }
     } rendering_attachments;
 
-    vvl::unordered_set<VkEvent> waitedEvents;
+    RecordingSet<VkEvent> waitedEvents;
     std::vector<VkEvent> writeEventsBeforeWait;
     std::vector<VkEvent> events;
-    vvl::unordered_set<QueryObject> activeQueries;
-    vvl::unordered_set<QueryObject> startedQueries;
+    RecordingSet<QueryObject> activeQueries;
+    RecordingSet<QueryObject> startedQueries;
     vvl::unordered_set<QueryObject> updatedQueries;
-    vvl::unordered_set<QueryObject> renderPassQueries;
+    RecordingSet<QueryObject> renderPassQueries;
     ImageLayoutMap image_layout_map;
     AliasedLayoutMap aliased_image_layout_map;  // storage for potentially aliased images
 
-    vvl::unordered_map<uint32_t, vvl::VertexBufferBinding> current_vertex_buffer_binding_info;
+    RecordingMap<uint32_t, vvl::VertexBufferBinding> current_vertex_buffer_binding_info;
     vvl::IndexBufferBinding index_buffer_binding;
 
     VkCommandBuffer primaryCommandBuffer;
     // If primary, the secondary command buffers we will call.
     vvl::unordered_set<CommandBuffer *> linkedCommandBuffers;
+    // The deferred callbacks below are stored inline (see vvl::inline_function), so once the vectors have grown, re-recording
+    // the command buffer after a reset does not allocate for them.
     // Validation functions run at primary CB queue submit time
-    using QueueCallback = std::function<bool(const class vvl::Queue &queue_state, const CommandBuffer &cb_state)>;
+    using QueueCallback = vvl::inline_function<bool(const class vvl::Queue &queue_state, const CommandBuffer &cb_state)>;
     std::vector<QueueCallback> queue_submit_functions;
     // Used by some layers to defer actions until vkCmdEndRenderPass time.
     // Layers using this are responsible for inserting the callbacks into queue_submit_functions.
     std::vector<QueueCallback> queue_submit_functions_after_render_pass;
     // Validation functions run when secondary CB is executed in primary
-    std::vector<std::function<bool(const CommandBuffer &secondary, const CommandBuffer *primary, const vvl::Framebuffer *)>>
-        cmd_execute_commands_functions;
+    using ExecuteCommandsCallback =
+        vvl::inline_function<bool(const CommandBuffer &secondary, const CommandBuffer *primary, const vvl::Framebuffer *)>;
+    std::vector<ExecuteCommandsCallback> cmd_execute_commands_functions;
 
-    using EventCallback = std::function<bool(CommandBuffer &cb_state, bool do_validate, EventMap &local_event_signal_info,
-                                             VkQueue waiting_queue, const Location &loc)>;
+    using EventCallback = vvl::inline_function<bool(CommandBuffer &cb_state, bool do_validate, EventMap &local_event_signal_info,
+                                                    VkQueue waiting_queue, const Location &loc)>;
     std::vector<EventCallback> event_updates;
 
-    std::vector<std::function<bool(CommandBuffer &cb_state, bool do_validate, VkQueryPool &firstPerfQueryPool,
-                                   uint32_t perfQueryPass, QueryMap *localQueryToStateMap)>>
-        query_updates;
+    using QueryCallback = vvl::inline_function<bool(CommandBuffer &cb_state, bool do_validate, VkQueryPool &firstPerfQueryPool,
+                                                    uint32_t perfQueryPass, QueryMap *localQueryToStateMap)>;
+    std::vector<QueryCallback> query_updates;
     bool performance_lock_acquired = false;
     bool performance_lock_released = false;
 
@@ -727,6 +757,8 @@ class CommandBuffer : public RefcountedStateObject, public SubStateManager<Comma
 
   private:
     void ResetCBState();
+    void ResetRecordingContainers(vvl::RecordingArena *arena);
+    uint64_t ComputeFingerprint() const;
 
     // Keep track of how many CmdBeginDebugUtilsLabelEXT calls have been made without a matching CmdEndDebugUtilsLabelEXT.
     // Negative value for a secondary command buffer indicates invalid state.
@@ -754,6 +786,9 @@ class CommandBufferSubState {
     CommandBufferSubState &operator=(const CommandBufferSubState &) = delete;
     virtual ~CommandBufferSubState() {}
     virtual void Destroy() {}
+    // Called before the base state is cleared by Reset/Destroy, while it still holds what was recorded
+    virtual void PreReset() {}
+    virtual void PreDestroy() {}
 
     virtual void Reset(const Location &loc) {}
     virtual void RecordCmd(Func command) {}
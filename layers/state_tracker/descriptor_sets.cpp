@@ -19,7 +19,9 @@
 #include "state_tracker/descriptor_sets.h"
 #include <vulkan/vk_enum_string_helper.h>
 #include <vulkan/vulkan_core.h>
+#include <algorithm>
 #include <cstdint>
+#include <new>
 #include "state_tracker/image_state.h"
 #include "state_tracker/buffer_state.h"
 #include "state_tracker/cmd_buffer_state.h"
@@ -49,7 +51,8 @@ vvl::DescriptorPool::DescriptorPool(vvl::DeviceState &dev, const VkDescriptorPoo
       max_descriptor_type_count(GetMaxTypeCounts(pCreateInfo)),
       available_sets_(pCreateInfo->maxSets),
       available_counts_(max_descriptor_type_count),
-      dev_data_(dev) {}
+      dev_data_(dev),
+      set_arena_(std::make_shared<DescriptorSetArena>()) {}
 
 void vvl::DescriptorPool::Allocate(const VkDescriptorSetAllocateInfo *alloc_info, const VkDescriptorSet *descriptor_sets,
                                    const vvl::AllocateDescriptorSetsData &ds_data) {
@@ -136,6 +139,58 @@ void vvl::DescriptorPool::Destroy() {
     StateObject::Destroy();
 }
 
+vvl::DescriptorSetArena::~DescriptorSetArena() {
+    for (std::max_align_t *chunk : chunks_) {
+        delete[] chunk;
+    }
+}
+
+uint32_t vvl::DescriptorSetArena::SizeClass(size_t size) {
+    uint32_t size_class = 0;
+    while ((kMinBlockSize << size_class) < size) {
+        ++size_class;
+    }
+    return size_class;
+}
+
+void *vvl::DescriptorSetArena::Allocate(size_t size) {
+    if (size > kMaxBlockSize) {
+        return ::operator new(size);
+    }
+    const uint32_t size_class = SizeClass(size);
+    if (!free_lists_[size_class]) {
+        free_lists_[size_class] = released_[size_class].exchange(nullptr, std::memory_order_acquire);
+    }
+    if (FreeBlock *block = free_lists_[size_class]) {
+        free_lists_[size_class] = block->next;
+        return block;
+    }
+    const size_t block_size = kMinBlockSize << size_class;
+    if (static_cast<size_t>(bump_end_ - bump_) < block_size) {
+        // What is left of the current chunk is dropped, it is less than one of the largest blocks
+        std::max_align_t *chunk = new std::max_align_t[next_chunk_size_ / sizeof(std::max_align_t)];
+        chunks_.emplace_back(chunk);
+        bump_ = reinterpret_cast<uint8_t *>(chunk);
+        bump_end_ = bump_ + next_chunk_size_;
+        next_chunk_size_ = std::min(next_chunk_size_ * 2, kMaxChunkSize);
+    }
+    void *block = bump_;
+    bump_ += block_size;
+    return block;
+}
+
+void vvl::DescriptorSetArena::Deallocate(void *ptr, size_t size) {
+    if (size > kMaxBlockSize) {
+        ::operator delete(ptr);
+        return;
+    }
+    // Only whole lists are ever taken off released_, so pushing with a CAS is not subject to ABA
+    auto &released = released_[SizeClass(size)];
+    FreeBlock *block = new (ptr) FreeBlock{released.load(std::memory_order_relaxed)};
+    while (!released.compare_exchange_weak(block->next, block, std::memory_order_release, std::memory_order_relaxed)) {
+    }
+}
+
 // ExtendedBinding collects a VkDescriptorSetLayoutBinding and any extended
 // state that comes from a different array/structure so they can stay together
 // while being sorted by binding number.
@@ -308,11 +363,23 @@ vvl::DescriptorSetLayoutDef::DescriptorSetLayoutDef(const VkDescriptorSetLayoutC
     binding_count_ = static_cast<uint32_t>(sorted_bindings.size());
     bindings_.reserve(binding_count_);
     binding_flags_.reserve(binding_count_);
-    binding_to_index_map_.reserve(binding_count_);
+    // Dense lookup as long as it costs at most a few times the number of bindings
+    const uint32_t max_binding_num = sorted_bindings.empty() ? 0 : sorted_bindings.rbegin()->layout_binding->binding;
+    const bool dense_binding_lookup = !sorted_bindings.empty() && max_binding_num < 4 * binding_count_ + 16;
+    if (dense_binding_lookup) {
+        binding_to_index_.resize(max_binding_num + 1, binding_count_);
+    } else {
+        binding_to_index_map_.reserve(binding_count_);
+    }
+    dynamic_offset_starts_.reserve(binding_count_);
     for (const auto &input_binding : sorted_bindings) {
         // Add to binding and map, s.t. it is robust to invalid duplication of binding_num
         const auto binding_num = input_binding.layout_binding->binding;
-        binding_to_index_map_[binding_num] = index++;
+        if (dense_binding_lookup) {
+            binding_to_index_[binding_num] = index;
+        } else {
+            binding_to_index_map_[binding_num] = index;
+        }
         bindings_.emplace_back(input_binding.layout_binding);
         auto &binding_info = bindings_.back();
         binding_flags_.emplace_back(input_binding.binding_flags);
@@ -325,9 +392,14 @@ vvl::DescriptorSetLayoutDef::DescriptorSetLayoutDef(const VkDescriptorSetLayoutC
         non_inline_descriptor_count_ +=
             (binding_info.descriptorType == VK_DESCRIPTOR_TYPE_INLINE_UNIFORM_BLOCK) ? 1 : binding_info.descriptorCount;
 
+        dynamic_offset_starts_.emplace_back(dynamic_descriptor_count_);
         if (IsDynamicDescriptor(binding_info.descriptorType)) {
             dynamic_descriptor_count_ += binding_info.descriptorCount;
+            for (uint32_t di = 0; di < binding_info.descriptorCount; ++di) {
+                dynamic_offset_descriptors_.emplace_back(index, di);
+            }
         }
+        index++;
 
         // Get stats depending on descriptor type for caching later
         if (IsBufferDescriptor(binding_info.descriptorType)) {
@@ -365,6 +437,9 @@ size_t vvl::DescriptorSetLayoutDef::hash() const {
 // The asserts in "Get" are reduced to the set where no valid answer(like null or 0) could be given
 // Common code for all binding lookups.
 uint32_t vvl::DescriptorSetLayoutDef::GetIndexFromBinding(uint32_t binding) const {
+    if (!binding_to_index_.empty()) {
+        return binding < binding_to_index_.size() ? binding_to_index_[binding] : GetBindingCount();
+    }
     const auto &bi_itr = binding_to_index_map_.find(binding);
     if (bi_itr != binding_to_index_map_.cend()) return bi_itr->second;
     return GetBindingCount();
@@ -488,6 +563,7 @@ vvl::DescriptorSet::DescriptorSet(const VkDescriptorSet handle, vvl::DescriptorP
       some_update_(false),
       pool_state_(pool_state),
       layout_(layout),
+      bindings_store_(DescriptorSetArenaAllocator<BindingBackingStore>(pool_state ? pool_state->GetSetArena() : nullptr)),
       state_data_(state_data),
       variable_count_(variable_count),
       change_count_(0) {
@@ -548,13 +624,7 @@ vvl::DescriptorSet::DescriptorSet(const VkDescriptorSet handle, vvl::DescriptorP
                 break;
             }
             case DescriptorClass::GeneralBuffer: {
-                auto binding = MakeBinding<BufferBinding>(free_binding++, *create_info, descriptor_count, flags);
-                if (IsDynamicDescriptor(type)) {
-                    for (uint32_t di = 0; di < descriptor_count; ++di) {
-                        dynamic_offset_idx_to_descriptor_list_.emplace_back(i, di);
-                    }
-                }
-                bindings_.push_back(std::move(binding));
+                bindings_.push_back(MakeBinding<BufferBinding>(free_binding++, *create_info, descriptor_count, flags));
                 break;
             }
             case DescriptorClass::InlineUniform: {
@@ -597,13 +667,7 @@ uint32_t vvl::DescriptorSet::GetDynamicOffsetIndexFromBinding(uint32_t dynamic_b
         return vvl::kU32Max;
     }
     assert(IsDynamicDescriptor(bindings_[index]->type));
-    uint32_t dynamic_offset_index = 0;
-    for (uint32_t i = 0; i < index; i++) {
-        if (IsDynamicDescriptor(bindings_[i]->type)) {
-            dynamic_offset_index += bindings_[i]->count;
-        }
-    }
-    return dynamic_offset_index;
+    return layout_->GetDynamicOffsetStartFromIndex(index);
 }
 
 std::pair<uint32_t, uint32_t> vvl::DescriptorSet::GetBindingAndIndex(const uint32_t global_descriptor_index) const {
@@ -653,6 +717,8 @@ void vvl::DescriptorSet::PerformWriteUpdate(const VkWriteDescriptorSet &update)
     auto iter = FindDescriptor(update.dstBinding, update.dstArrayElement);
     ASSERT_AND_RETURN(!iter.AtEnd());
     auto &orig_binding = iter.CurrentBinding();
+    // Every binding this update rolls over is stamped with the change count it produces
+    const uint64_t change_count = change_count_ + 1;
 
     // Verify next consecutive binding matches type, stage flags & immutable sampler use and if AtEnd
     for (uint32_t i = 0; i < descriptors_remaining; ++i, ++iter) {
@@ -661,6 +727,7 @@ void vvl::DescriptorSet::PerformWriteUpdate(const VkWriteDescriptorSet &update)
         }
         iter->WriteUpdate(*this, *state_data_, update, i, IsBindless(iter.CurrentBinding().binding_flags));
         iter.updated(true);
+        iter.CurrentBinding().change_count = change_count;
     }
     if (update.descriptorCount) {
         some_update_ = true;
@@ -688,7 +755,7 @@ void vvl::DescriptorSet::PerformCopyUpdate(const VkCopyDescriptorSet &update, co
             }
             dst.CopyUpdate(*this, *state_data_, src, IsBindless(src_iter.CurrentBinding().binding_flags), type);
             some_update_ = true;
-            ++change_count_;
+            dst_iter.CurrentBinding().change_count = ++change_count_;
             dst_iter.updated(true);
         } else {
             dst_iter.updated(false);
@@ -709,7 +776,8 @@ void vvl::DescriptorSet::PerformCopyUpdate(const VkCopyDescriptorSet &update, co
 // Prereq: This should be called for a set that has been confirmed to be active for the given cb_state, meaning it's going
 //   to be used in a draw by the given cb_state
 void vvl::DescriptorSet::UpdateImageLayoutDrawStates(vvl::DeviceState *device_data, vvl::CommandBuffer &cb_state,
-                                                     const BindingVariableMap &binding_req_map) {
+                                                     const BindingVariableMap &binding_req_map,
+                                                     std::optional<uint64_t> validated_change_count) {
     // Descriptor UpdateImageLayoutDrawState only call image layout validation callbacks. If it is disabled, skip the entire loop.
     if (device_data->disabled[image_layout_validation]) return;
 
@@ -719,6 +787,11 @@ void vvl::DescriptorSet::UpdateImageLayoutDrawStates(vvl::DeviceState *device_da
         auto *binding = GetBinding(binding_req_pair.first);
         ASSERT_AND_CONTINUE(binding);
 
+        // Bindings that were not touched since the last draw already have their layouts recorded in this command buffer
+        if (validated_change_count && binding->change_count <= *validated_change_count) {
+            continue;
+        }
+
         // core validation doesn't handle descriptor indexing, that is only done by GPU-AV
         if (ValidateBindingOnGPU(*binding, *binding_req_pair.second.variable)) {
             continue;
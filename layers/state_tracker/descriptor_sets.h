@@ -21,11 +21,18 @@
 #include "state_tracker/state_object.h"
 #include "utils/hash_util.h"
 #include "state_tracker/shader_stage_state.h"
+#include "containers/limits.h"
 #include "containers/small_vector.h"
 #include "generated/vk_object_types.h"
 #include "generated/error_location_helper.h"
 #include <vulkan/utility/vk_safe_struct.hpp>
+#include <array>
+#include <atomic>
+#include <cstddef>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <set>
 #include <vector>
 
@@ -52,6 +59,79 @@ static inline bool IsBindless(VkDescriptorBindingFlags flags) {
     return (flags & (VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT | VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT)) != 0;
 }
 
+// Recycles the memory of the DescriptorSet objects, and of their binding storage, allocated from one pool.
+// Sets are reference counted and can outlive vkFreeDescriptorSets/vkResetDescriptorPool (ex: still bound in a command buffer), so
+// the memory can't be released wholesale at reset. Instead blocks are bump allocated from chunks, go back to the free list of their
+// size class as the sets are released, and are reused by the next allocations from the pool, which for transient per-frame pools
+// are the same sets over and over. The chunks are only freed once the pool and all the sets allocated from it are gone.
+//
+// Allocate() is only called while the pool's write lock is held (vkAllocateDescriptorSets), so it doesn't need a lock of its own.
+// The last reference to a set can go away on any thread though, so Deallocate() pushes onto a lock-free list per size class,
+// which Allocate() takes over as a whole once its own list is empty.
+class DescriptorSetArena {
+  public:
+    ~DescriptorSetArena();
+    void *Allocate(size_t size);
+    void Deallocate(void *ptr, size_t size);
+
+  private:
+    struct FreeBlock {
+        FreeBlock *next;
+    };
+    // Size classes are powers of two from kMinBlockSize, larger requests go to the heap
+    static constexpr size_t kMinBlockSize = 64;
+    static constexpr uint32_t kSizeClassCount = 7;
+    static constexpr size_t kMaxBlockSize = kMinBlockSize << (kSizeClassCount - 1);
+    static constexpr size_t kMaxChunkSize = 64 * 1024;
+    static uint32_t SizeClass(size_t size);
+
+    // Only used by Allocate()
+    std::array<FreeBlock *, kSizeClassCount> free_lists_{};
+    uint8_t *bump_{nullptr};
+    uint8_t *bump_end_{nullptr};
+    size_t next_chunk_size_{2 * kMaxBlockSize};
+    std::vector<std::max_align_t *> chunks_;
+    // Blocks given back by Deallocate(), from any thread
+    std::array<std::atomic<FreeBlock *>, kSizeClassCount> released_{};
+};
+
+// Allocator for std::allocate_shared and the binding storage. The control block keeps a copy so the arena lives as long as any
+// set allocated from it. Without an arena (push descriptor sets) it uses the heap.
+template <typename T>
+class DescriptorSetArenaAllocator {
+  public:
+    using value_type = T;
+
+    explicit DescriptorSetArenaAllocator(std::shared_ptr<DescriptorSetArena> arena) : arena_(std::move(arena)) {}
+    template <typename U>
+    DescriptorSetArenaAllocator(const DescriptorSetArenaAllocator<U> &other) : arena_(other.arena_) {}
+
+    T *allocate(size_t n) {
+        return static_cast<T *>(arena_ ? arena_->Allocate(n * sizeof(T)) : ::operator new(n * sizeof(T)));
+    }
+    void deallocate(T *ptr, size_t n) {
+        if (arena_) {
+            arena_->Deallocate(ptr, n * sizeof(T));
+        } else {
+            ::operator delete(ptr);
+        }
+    }
+
+    template <typename U>
+    bool operator==(const DescriptorSetArenaAllocator<U> &other) const {
+        return arena_ == other.arena_;
+    }
+    template <typename U>
+    bool operator!=(const DescriptorSetArenaAllocator<U> &other) const {
+        return arena_ != other.arena_;
+    }
+
+  private:
+    template <typename U>
+    friend class DescriptorSetArenaAllocator;
+    std::shared_ptr<DescriptorSetArena> arena_;
+};
+
 class DescriptorPool : public StateObject {
   public:
     DescriptorPool(DeviceState &dev, const VkDescriptorPool handle, const VkDescriptorPoolCreateInfo *pCreateInfo);
@@ -95,6 +175,12 @@ class DescriptorPool : public StateObject {
         auto guard = ReadLock();
         return freed_count;
     }
+
+    DescriptorSetArenaAllocator<DescriptorSet> GetSetAllocator() const {
+        return DescriptorSetArenaAllocator<DescriptorSet>(set_arena_);
+    }
+    const std::shared_ptr<DescriptorSetArena> &GetSetArena() const { return set_arena_; }
+
   protected:
     ReadLockGuard ReadLock() const { return ReadLockGuard(lock_); }
     WriteLockGuard WriteLock() { return WriteLockGuard(lock_); }
@@ -104,6 +190,7 @@ class DescriptorPool : public StateObject {
     DeviceState &dev_data_;
     mutable std::shared_mutex lock_;
     uint32_t freed_count{0};
+    const std::shared_ptr<DescriptorSetArena> set_arena_;
 };
 
 class DescriptorUpdateTemplate : public StateObject {
@@ -178,7 +265,7 @@ class DescriptorSetLayoutDef {
     // For a given binding, return the number of descriptors in that binding and all successive bindings
     uint32_t GetBindingCount() const { return binding_count_; };
     // Return true if given binding is present in this layout
-    bool HasBinding(const uint32_t binding) const { return binding_to_index_map_.count(binding) > 0; };
+    bool HasBinding(const uint32_t binding) const { return GetIndexFromBinding(binding) < binding_count_; };
     // Return true if binding 1 beyond given exists and has same type, stageFlags & immutable sampler use
     uint32_t GetIndexFromBinding(uint32_t binding) const;
     // Various Get functions that can either be passed a binding#, which will
@@ -227,6 +314,15 @@ class DescriptorSetLayoutDef {
     };
     const BindingTypeStats &GetBindingTypeStats() const { return binding_type_stats_; }
 
+    // The def is shared (through the DescriptorSetLayoutDict) by every set allocated from an identical layout, so the per binding
+    // data that only depends on the layout is computed once here instead of by each set.
+    // Index into the dynamic offset array (vkCmdBindDescriptorSets::pDynamicOffsets) of the first descriptor of the binding
+    uint32_t GetDynamicOffsetStartFromIndex(uint32_t index) const {
+        return index < dynamic_offset_starts_.size() ? dynamic_offset_starts_[index] : vvl::kU32Max;
+    }
+    // For a given dynamic offset index, the {binding index, descriptor index} it applies to
+    const std::vector<std::pair<uint32_t, uint32_t>> &GetDynamicOffsetDescriptors() const { return dynamic_offset_descriptors_; }
+
     std::string DescribeDifference(uint32_t index, const DescriptorSetLayoutDef &other) const;
 
   private:
@@ -240,7 +336,12 @@ class DescriptorSetLayoutDef {
 
     // Convenience data structures for rapid lookup of various descriptor set layout properties
     std::set<uint32_t> non_empty_bindings_;  // Containing non-emtpy bindings in numerical order
+    // Binding numbers are usually small and packed, so they directly index binding_to_index_ (with binding_count_ for holes).
+    // Layouts with sparse binding numbers use the map instead.
+    std::vector<uint32_t> binding_to_index_;
     vvl::unordered_map<uint32_t, uint32_t> binding_to_index_map_;
+    std::vector<uint32_t> dynamic_offset_starts_;
+    std::vector<std::pair<uint32_t, uint32_t>> dynamic_offset_descriptors_;
     // The following map allows an non-iterative lookup of a binding from a global index...
     std::vector<IndexRange> global_index_range_;  // range is exclusive of .end
 
@@ -376,6 +477,10 @@ class DescriptorSetLayout : public StateObject {
 
     using BindingTypeStats = DescriptorSetLayoutDef::BindingTypeStats;
     const BindingTypeStats &GetBindingTypeStats() const { return layout_id_->GetBindingTypeStats(); }
+    uint32_t GetDynamicOffsetStartFromIndex(uint32_t index) const { return layout_id_->GetDynamicOffsetStartFromIndex(index); }
+    const std::vector<std::pair<uint32_t, uint32_t>> &GetDynamicOffsetDescriptors() const {
+        return layout_id_->GetDynamicOffsetDescriptors();
+    }
 
   private:
     DescriptorSetLayoutId layout_id_{};
@@ -723,6 +828,8 @@ class DescriptorBinding {
     const uint32_t count;
     const bool has_immutable_samplers;
     small_vector<bool, 1, uint32_t> updated;
+    // Value of the owning set's change count produced by the last write or copy into this binding (0 if never updated)
+    uint64_t change_count{0};
 };
 
 template <typename T>
@@ -863,7 +970,9 @@ class DescriptorSet : public StateObject, public SubStateManager<DescriptorSetSu
     VkDescriptorSet VkHandle() const { return handle_.Cast<VkDescriptorSet>(); };
     // Bind given cmd_buffer to this descriptor set and
     // update CB image layout map with image/imagesampler descriptor image layouts
-    void UpdateImageLayoutDrawStates(DeviceState *, vvl::CommandBuffer &cb_state, const BindingVariableMap &);
+    // If validated_change_count is set, only bindings updated after that change count are visited
+    void UpdateImageLayoutDrawStates(DeviceState *, vvl::CommandBuffer &cb_state, const BindingVariableMap &,
+                                     std::optional<uint64_t> validated_change_count = {});
 
     // For a particular binding, get the global index
     const IndexRange GetGlobalIndexRangeFromBinding(const uint32_t binding, bool actual_length = false) const {
@@ -919,7 +1028,7 @@ class DescriptorSet : public StateObject, public SubStateManager<DescriptorSetSu
 
     // For a given dynamic offset array, return the corresponding index into the list of descriptors in set
     const Descriptor *GetDescriptorFromDynamicOffsetIndex(const uint32_t index) const {
-        auto pos = dynamic_offset_idx_to_descriptor_list_.at(index);
+        auto pos = layout_->GetDynamicOffsetDescriptors().at(index);
         return bindings_[pos.first]->GetDescriptor(pos.second);
     }
 
@@ -1049,15 +1158,12 @@ class DescriptorSet : public StateObject, public SubStateManager<DescriptorSetSu
     const std::shared_ptr<DescriptorSetLayout const> layout_;
     // NOTE: the the backing store for the bindings must be declared *before* it so it will be destructed *after* it
     // "Destructors for nonstatic member objects are called in the reverse order in which they appear in the class declaration."
-    std::vector<BindingBackingStore> bindings_store_;
+    std::vector<BindingBackingStore, DescriptorSetArenaAllocator<BindingBackingStore>> bindings_store_;
     std::vector<BindingPtr> bindings_;
     DeviceState *state_data_;
     uint32_t variable_count_;
     std::atomic<uint64_t> change_count_;
 
-    // For a given dynamic offset index in the set, map to associated index of the descriptors in the set
-    std::vector<std::pair<uint32_t, uint32_t>> dynamic_offset_idx_to_descriptor_list_;
-
     // If this descriptor set is a push descriptor set, the descriptor
     // set writes that were last pushed.
     std::vector<vku::safe_VkWriteDescriptorSet> push_descriptor_set_writes;
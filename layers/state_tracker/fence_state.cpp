@@ -25,14 +25,11 @@ static VkExternalFenceHandleTypeFlags GetExportHandleTypes(const VkFenceCreateIn
     return export_info ? export_info->handleTypes : 0;
 }
 
-vvl::Fence::Fence(Logger &logger, VkFence handle, const VkFenceCreateInfo *pCreateInfo)
+vvl::Fence::Fence(VkFence handle, const VkFenceCreateInfo *pCreateInfo)
     : RefcountedStateObject(handle, kVulkanObjectTypeFence),
       flags(pCreateInfo->flags),
       export_handle_types(GetExportHandleTypes(pCreateInfo)),
-      state_((pCreateInfo->flags & VK_FENCE_CREATE_SIGNALED_BIT) ? kRetired : kUnsignaled),
-      completed_(),
-      waiter_(completed_.get_future()),
-      logger_(logger) {}
+      state_((pCreateInfo->flags & VK_FENCE_CREATE_SIGNALED_BIT) ? kRetired : kUnsignaled) {}
 
 const VulkanTypedHandle *vvl::Fence::InUse() const {
     auto guard = ReadLock();
@@ -66,7 +63,7 @@ bool vvl::Fence::EnqueueSignal(vvl::Queue *queue_state, uint64_t next_seq) {
 
 // Called from a non-queue operation, such as vkWaitForFences()|
 void vvl::Fence::NotifyAndWait(const Location &loc) {
-    std::shared_future<void> waiter;
+    std::optional<SubmissionReference> signal_submission_ref;
     std::optional<SubmissionReference> present_submission_ref;
     {
         // Hold the lock only while updating members, but not
@@ -74,11 +71,9 @@ void vvl::Fence::NotifyAndWait(const Location &loc) {
         auto guard = WriteLock();
         if (state_ == kInflight) {
             if (queue_) {
-                queue_->Notify(seq_);
-                waiter = waiter_;
+                signal_submission_ref.emplace(queue_, seq_);
             } else {
                 state_ = kRetired;
-                completed_.set_value();
                 queue_ = nullptr;
                 seq_ = 0;
             }
@@ -91,13 +86,10 @@ void vvl::Fence::NotifyAndWait(const Location &loc) {
             present_wait_semaphores_.clear();
         }
     }
-    if (waiter.valid()) {
-        auto result = waiter.wait_until(GetCondWaitTimeout());
-        if (result != std::future_status::ready) {
-            logger_.LogError(
-                "INTERNAL-ERROR-VkFence-state-timeout", Handle(), loc,
-                "The Validation Layers hit a timeout waiting for fence state to update (this is most likely a validation bug).");
-        }
+    if (signal_submission_ref.has_value()) {
+        // Retires the signaling submission on this thread unless the queue is already being retired elsewhere.
+        // Once the queue has retired it, Retire() was called on this fence, so there is nothing else to wait for.
+        signal_submission_ref->queue->NotifyAndWait(loc, signal_submission_ref->seq);
     }
     if (present_submission_ref.has_value()) {
         present_submission_ref->queue->NotifyAndWait(loc, present_submission_ref->seq);
@@ -109,7 +101,6 @@ void vvl::Fence::Retire() {
     auto guard = WriteLock();
     if (state_ == kInflight) {
         state_ = kRetired;
-        completed_.set_value();
         queue_ = nullptr;
         seq_ = 0;
     }
@@ -127,8 +118,6 @@ void vvl::Fence::Reset() {
         imported_handle_type_.reset();
     }
     state_ = kUnsignaled;
-    completed_ = std::promise<void>();
-    waiter_ = std::shared_future<void>(completed_.get_future());
     present_submission_ref_.reset();
 
     // Do not reset swapchain-in-use state of each semaphore here, only stop the tracking.
@@ -160,8 +149,6 @@ void vvl::Fence::Export(VkExternalFenceHandleTypeFlagBits handle_type) {
             imported_handle_type_.reset();
         }
         state_ = kUnsignaled;
-        completed_ = std::promise<void>();
-        waiter_ = std::shared_future<void>(completed_.get_future());
     }
 }
 
@@ -23,9 +23,6 @@
 #include "state_tracker/submission_reference.h"
 #include "containers/span.h"
 #include <optional>
-#include <future>
-
-class Logger;
 
 namespace vvl {
 class Semaphore;
@@ -40,7 +37,7 @@ class Fence : public RefcountedStateObject {
         kExternalPermanent,
     };
 
-    Fence(Logger &logger, VkFence handle, const VkFenceCreateInfo *pCreateInfo);
+    Fence(VkFence handle, const VkFenceCreateInfo *pCreateInfo);
 
     const VulkanTypedHandle *InUse() const override;
     VkFence VkHandle() const { return handle_.Cast<VkFence>(); }
@@ -86,9 +83,6 @@ class Fence : public RefcountedStateObject {
     enum Scope scope_{kInternal};
     std::optional<VkExternalFenceHandleTypeFlagBits> imported_handle_type_;  // has value when scope is not kInternal
     mutable std::shared_mutex lock_;
-    std::promise<void> completed_;
-    std::shared_future<void> waiter_;
-    Logger &logger_;
 
     // The present queue submission is notified when WaitForFences waits for the image acquire fence.
     //
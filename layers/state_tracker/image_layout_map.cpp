@@ -74,6 +74,34 @@ static bool UpdateLayoutStateImpl(LayoutsMap& layouts, InitialLayoutStates& init
     return updated_current;
 }
 
+// Most updates are whole image transitions of a map that is empty or already holds a single entry for the whole image. Those
+// are handled here without the range walk. Returns false if the update needs the general path.
+static bool UpdateFullRangeLayoutState(ImageLayoutRegistry::LayoutMap& layouts, InitialLayoutStates& initial_layout_states,
+                                       const IndexRange& full_range, const IndexRange& range, LayoutEntry& new_entry,
+                                       const vvl::CommandBuffer& cb_state, const vvl::ImageView* view_state,
+                                       bool& updated_current) {
+    if (range != full_range) {
+        return false;
+    }
+    if (layouts.empty()) {
+        initial_layout_states.emplace_back(cb_state, view_state);
+        new_entry.state = &initial_layout_states.back();
+        layouts.insert(layouts.end(), std::make_pair(range, new_entry));
+        updated_current = true;
+        return true;
+    }
+    if (layouts.size() != 1) {
+        return false;
+    }
+    auto& [entry_range, entry] = *layouts.begin();
+    if (entry_range != range) {
+        return false;
+    }
+    assert(entry.state != nullptr);
+    updated_current = entry.CurrentWillChange(new_entry.current_layout) && entry.Update(new_entry);
+    return true;
+}
+
 InitialLayoutState::InitialLayoutState(const vvl::CommandBuffer& cb_state_, const vvl::ImageView* view_state_)
     : image_view(VK_NULL_HANDLE), aspect_mask(0), label(cb_state_.debug_label) {
     if (view_state_) {
@@ -109,6 +137,12 @@ bool ImageLayoutRegistry::SetSubresourceRangeLayout(const vvl::CommandBuffer& cb
     if (!InRange(range)) return false;  // Don't even try to track bogus subreources
 
     RangeGenerator range_gen(encoder_, range);
+    LayoutEntry entry(expected_layout, layout);
+    bool updated = false;
+    if (UpdateFullRangeLayoutState(layout_map_, initial_layout_states_, FullRange(), *range_gen, entry, cb_state, nullptr,
+                                   updated)) {
+        return updated;
+    }
     if (layout_map_.UsesSmallMap()) {
         return SetSubresourceRangeLayoutImpl(layout_map_.GetSmallMap(), initial_layout_states_, range_gen, cb_state, layout,
                                              expected_layout);
@@ -135,6 +169,12 @@ void ImageLayoutRegistry::SetSubresourceRangeInitialLayout(const vvl::CommandBuf
     if (!InRange(range)) return;  // Don't even try to track bogus subreources
 
     RangeGenerator range_gen(encoder_, range);
+    LayoutEntry entry(layout);
+    bool updated = false;
+    if (UpdateFullRangeLayoutState(layout_map_, initial_layout_states_, FullRange(), *range_gen, entry, cb_state, nullptr,
+                                   updated)) {
+        return;
+    }
     if (layout_map_.UsesSmallMap()) {
         SetSubresourceRangeInitialLayoutImpl(layout_map_.GetSmallMap(), initial_layout_states_, range_gen, cb_state, layout,
                                              nullptr);
@@ -147,6 +187,12 @@ void ImageLayoutRegistry::SetSubresourceRangeInitialLayout(const vvl::CommandBuf
 void ImageLayoutRegistry::SetSubresourceRangeInitialLayout(const vvl::CommandBuffer& cb_state, VkImageLayout layout,
                                                            const vvl::ImageView& view_state) {
     RangeGenerator range_gen(view_state.range_generator);
+    LayoutEntry entry(layout);
+    bool updated = false;
+    if (UpdateFullRangeLayoutState(layout_map_, initial_layout_states_, FullRange(), *range_gen, entry, cb_state, &view_state,
+                                   updated)) {
+        return;
+    }
     if (layout_map_.UsesSmallMap()) {
         SetSubresourceRangeInitialLayoutImpl(layout_map_.GetSmallMap(), initial_layout_states_, range_gen, cb_state, layout,
                                              &view_state);
@@ -21,6 +21,7 @@
 #pragma once
 
 #include <functional>
+#include <optional>
 
 #include "containers/range.h"
 #include "containers/subresource_adapter.h"
@@ -149,6 +150,7 @@ class ImageLayoutRegistry {
     }
 
   protected:
+    IndexRange FullRange() const { return IndexRange(0, encoder_.SubresourceCount()); }
     bool InRange(const VkImageSubresource& subres) const { return encoder_.InRange(subres); }
     bool InRange(const VkImageSubresourceRange& range) const { return encoder_.InRange(range); }
 
@@ -164,12 +166,27 @@ class GlobalImageLayoutRangeMap : public subresource_adapter::BothRangeMap<VkIma
   public:
     using RangeGenerator = image_layout_map::RangeGenerator;
 
-    GlobalImageLayoutRangeMap(index_type index) : BothRangeMap<VkImageLayout, 16>(index) {}
+    GlobalImageLayoutRangeMap(index_type index)
+        : BothRangeMap<VkImageLayout, 16>(index), subresource_count_(index), version_(NextVersion()) {}
     ReadLockGuard ReadLock() const { return ReadLockGuard(lock_); }
     WriteLockGuard WriteLock() { return WriteLockGuard(lock_); }
 
+    // Any change to the layouts moves the map to a new version, so cached validation results can tell the layouts changed.
+    // Versions are unique across all maps. Must be called while holding the lock.
+    uint64_t Version() const { return version_; }
+    void UpdateVersion() { version_ = NextVersion(); }
+
     bool AnyInRange(RangeGenerator& gen, std::function<bool(const key_type& range, const mapped_type& state)>&& func) const;
 
+    // The layout of all subresources, if they are all in the same one (the common case), so callers can skip the range walk.
+    // Must be called while holding the lock.
+    std::optional<VkImageLayout> UniformLayout() const;
+
   private:
+    static uint64_t NextVersion();
+
+    const index_type subresource_count_;
+
     mutable std::shared_mutex lock_;
+    uint64_t version_;
 };
@@ -24,6 +24,8 @@
 #include "state_tracker/shader_module.h"
 #include "generated/dispatch_functions.h"
 
+#include <atomic>
+
 static VkExternalMemoryHandleTypeFlags GetExternalHandleTypes(const VkImageCreateInfo *pCreateInfo) {
     const auto *external_memory_info = vku::FindStructInPNextChain<VkExternalMemoryImageCreateInfo>(pCreateInfo->pNext);
     return external_memory_info ? external_memory_info->handleTypes : 0;
@@ -340,6 +342,7 @@ void Image::SetImageLayout(const VkImageSubresourceRange &range, VkImageLayout l
     for (; range_gen->non_empty(); ++range_gen) {
         update_range_value(*layout_range_map, *range_gen, layout, value_precedence::prefer_source);
     }
+    layout_range_map->UpdateVersion();
 }
 
 void Image::SetSwapchain(std::shared_ptr<vvl::Swapchain> &swapchain, uint32_t swapchain_index) {
@@ -954,6 +957,10 @@ std::vector<VkPresentModeKHR> Surface::GetCompatibleModes(VkPhysicalDevice phys_
 
 bool GlobalImageLayoutRangeMap::AnyInRange(RangeGenerator &gen,
                                            std::function<bool(const key_type &range, const mapped_type &state)> &&func) const {
+    if (const auto uniform_layout = UniformLayout()) {
+        // Every range of gen intersects the single entry
+        return gen->non_empty() && func(begin()->first, *uniform_layout);
+    }
     for (; gen->non_empty(); ++gen) {
         for (auto pos = lower_bound(*gen); (pos != end()) && (gen->intersects(pos->first)); ++pos) {
             if (func(pos->first, pos->second)) {
@@ -963,3 +970,19 @@ bool GlobalImageLayoutRangeMap::AnyInRange(RangeGenerator &gen,
     }
     return false;
 }
+
+std::optional<VkImageLayout> GlobalImageLayoutRangeMap::UniformLayout() const {
+    if (size() != 1) {
+        return std::nullopt;
+    }
+    const auto &[range, layout] = *begin();
+    if (range.begin != 0 || range.end != subresource_count_) {
+        return std::nullopt;
+    }
+    return layout;
+}
+
+uint64_t GlobalImageLayoutRangeMap::NextVersion() {
+    static std::atomic<uint64_t> version{0};
+    return ++version;
+}
@@ -685,9 +685,12 @@ struct LastBound {
         PipelineLayoutCompatId compat_id_for_set{0};
 
         // Cache most recently validated descriptor state for ValidateActionState/UpdateImageLayoutDrawState
-        const vvl::DescriptorSet *validated_set{nullptr};
+        // The set is identified by its id, a freed set's memory is reused by the pool for the next set allocated from it
+        uint32_t validated_set_id{0};
         uint64_t validated_set_change_count{~0ULL};
         uint64_t validated_set_image_layout_change_count{~0ULL};
+        // Bindings used by the pipeline the set was last validated for, another pipeline can use bindings that were skipped
+        const BindingVariableMap *validated_binding_req_map{nullptr};
 
         void Reset() {
             ds_state.reset();
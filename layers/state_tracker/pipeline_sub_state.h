@@ -18,6 +18,7 @@
 #pragma once
 
 #include "state_tracker/pipeline_layout_state.h"
+#include "utils/fixed_function_state.h"
 #include <vulkan/utility/vk_safe_struct.hpp>
 #include <vulkan/utility/vk_struct_helper.hpp>
 
@@ -125,18 +126,6 @@ struct PreRasterState : public PipelineSubState {
                                                    *task_shader_ci = nullptr, *mesh_shader_ci = nullptr;
 };
 
-std::unique_ptr<const vku::safe_VkPipelineColorBlendStateCreateInfo> ToSafeColorBlendState(
-    const vku::safe_VkPipelineColorBlendStateCreateInfo &cbs);
-std::unique_ptr<const vku::safe_VkPipelineColorBlendStateCreateInfo> ToSafeColorBlendState(
-    const VkPipelineColorBlendStateCreateInfo &cbs);
-std::unique_ptr<const vku::safe_VkPipelineMultisampleStateCreateInfo> ToSafeMultisampleState(
-    const vku::safe_VkPipelineMultisampleStateCreateInfo &cbs);
-std::unique_ptr<const vku::safe_VkPipelineMultisampleStateCreateInfo> ToSafeMultisampleState(
-    const VkPipelineMultisampleStateCreateInfo &cbs);
-std::unique_ptr<const vku::safe_VkPipelineDepthStencilStateCreateInfo> ToSafeDepthStencilState(
-    const vku::safe_VkPipelineDepthStencilStateCreateInfo &cbs);
-std::unique_ptr<const vku::safe_VkPipelineDepthStencilStateCreateInfo> ToSafeDepthStencilState(
-    const VkPipelineDepthStencilStateCreateInfo &cbs);
 std::unique_ptr<const vku::safe_VkPipelineShaderStageCreateInfo> ToShaderStageCI(
     const vku::safe_VkPipelineShaderStageCreateInfo &cbs);
 std::unique_ptr<const vku::safe_VkPipelineShaderStageCreateInfo> ToShaderStageCI(const VkPipelineShaderStageCreateInfo &cbs);
@@ -164,8 +153,8 @@ struct FragmentShaderState : public PipelineSubState {
     uint32_t subpass = 0;
 
     std::shared_ptr<const vvl::PipelineLayout> pipeline_layout;
-    std::unique_ptr<const vku::safe_VkPipelineMultisampleStateCreateInfo> ms_state;
-    std::unique_ptr<const vku::safe_VkPipelineDepthStencilStateCreateInfo> ds_state;
+    std::shared_ptr<const vku::safe_VkPipelineMultisampleStateCreateInfo> ms_state;
+    std::shared_ptr<const vku::safe_VkPipelineDepthStencilStateCreateInfo> ds_state;
 
     std::shared_ptr<const vvl::ShaderModule> fragment_shader;
     std::unique_ptr<const vku::safe_VkPipelineShaderStageCreateInfo> fragment_shader_ci;
@@ -236,8 +225,8 @@ struct FragmentOutputState : public PipelineSubState {
     std::shared_ptr<const vvl::RenderPass> rp_state;
     uint32_t subpass = 0;
 
-    std::unique_ptr<const vku::safe_VkPipelineColorBlendStateCreateInfo> color_blend_state;
-    std::unique_ptr<const vku::safe_VkPipelineMultisampleStateCreateInfo> ms_state;
+    std::shared_ptr<const vku::safe_VkPipelineColorBlendStateCreateInfo> color_blend_state;
+    std::shared_ptr<const vku::safe_VkPipelineMultisampleStateCreateInfo> ms_state;
 
     AttachmentStateVector attachment_states;
 
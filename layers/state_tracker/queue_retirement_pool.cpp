@@ -0,0 +1,127 @@
+/* Copyright (c) 2025 The Khronos Group Inc.
+ * Copyright (c) 2025 Valve Corporation
+ * Copyright (c) 2025 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "state_tracker/queue_retirement_pool.h"
+#include "state_tracker/queue_state.h"
+
+#include <algorithm>
+
+#include "profiling/profiling.h"
+
+namespace {
+// Lets a worker that schedules more work (eg. a retirement notifying the queue that signals a semaphore it waits on)
+// push to its own deque instead of going through the round robin.
+thread_local const vvl::QueueRetirementPool *current_pool = nullptr;
+thread_local uint32_t current_worker = 0;
+}  // namespace
+
+void vvl::QueueRetirementPool::Start() {
+    const uint32_t cores = std::thread::hardware_concurrency();
+    const uint32_t worker_count = std::clamp(cores, 1u, kMaxWorkers);
+    workers_.reserve(worker_count);
+    for (uint32_t i = 0; i < worker_count; ++i) {
+        workers_.emplace_back(std::make_unique<Worker>());
+    }
+    threads_.reserve(worker_count);
+    for (uint32_t i = 0; i < worker_count; ++i) {
+        threads_.emplace_back(&QueueRetirementPool::WorkerFunc, this, i);
+    }
+}
+
+void vvl::QueueRetirementPool::Schedule(std::weak_ptr<Queue> queue) {
+    std::call_once(start_once_, [this]() { Start(); });
+    {
+        std::lock_guard<std::mutex> guard(sleep_lock_);
+        if (exit_) {
+            return;
+        }
+    }
+    const uint32_t index = (current_pool == this) ? current_worker
+                                                  : next_worker_.fetch_add(1, std::memory_order_relaxed) % workers_.size();
+    {
+        Worker &worker = *workers_[index];
+        std::lock_guard<std::mutex> guard(worker.lock);
+        worker.tasks.emplace_back(std::move(queue));
+    }
+    {
+        std::lock_guard<std::mutex> guard(sleep_lock_);
+        ++pending_;
+    }
+    wake_.notify_one();
+}
+
+bool vvl::QueueRetirementPool::PopTask(uint32_t index, std::weak_ptr<Queue> &task) {
+    {
+        Worker &own = *workers_[index];
+        std::lock_guard<std::mutex> guard(own.lock);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            return true;
+        }
+    }
+    for (size_t i = 1; i < workers_.size(); ++i) {
+        Worker &victim = *workers_[(index + i) % workers_.size()];
+        std::lock_guard<std::mutex> guard(victim.lock);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void vvl::QueueRetirementPool::WorkerFunc(uint32_t index) {
+    VVL_TracySetThreadName(__FUNCTION__);
+    current_pool = this;
+    current_worker = index;
+
+    while (true) {
+        std::weak_ptr<Queue> task;
+        if (PopTask(index, task)) {
+            {
+                std::lock_guard<std::mutex> guard(sleep_lock_);
+                --pending_;
+            }
+            // The queue may have been destroyed since it was scheduled
+            if (auto queue = task.lock()) {
+                queue->RunRetirement(true);
+            }
+            continue;
+        }
+        std::unique_lock<std::mutex> guard(sleep_lock_);
+        // pending_ can be briefly negative when a task is taken before Schedule() counted it
+        wake_.wait(guard, [this]() { return exit_ || pending_ > 0; });
+        if (exit_) {
+            break;
+        }
+    }
+}
+
+void vvl::QueueRetirementPool::Shutdown() {
+    {
+        std::lock_guard<std::mutex> guard(sleep_lock_);
+        exit_ = true;
+    }
+    wake_.notify_all();
+    for (auto &thread : threads_) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+    threads_.clear();
+}
@@ -0,0 +1,74 @@
+/* Copyright (c) 2025 The Khronos Group Inc.
+ * Copyright (c) 2025 Valve Corporation
+ * Copyright (c) 2025 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace vvl {
+
+class Queue;
+
+// Device wide set of worker threads that retire queue submissions.
+//
+// Each task is "run whatever is ready on this queue". Per-queue ordering is not the pool's concern: Queue::RunRetirement()
+// lets only one thread at a time retire a given queue, so a task that finds its queue already being retired is a no-op.
+// Workers push to and pop from the back of their own deque and steal from the front of the others when they run dry.
+// Threads are only started on the first Schedule() so devices that never submit don't pay for them.
+class QueueRetirementPool {
+  public:
+    QueueRetirementPool() = default;
+    QueueRetirementPool(const QueueRetirementPool &) = delete;
+    QueueRetirementPool &operator=(const QueueRetirementPool &) = delete;
+    ~QueueRetirementPool() { Shutdown(); }
+
+    void Schedule(std::weak_ptr<Queue> queue);
+
+    // Stop and join all workers. Tasks that have not started are dropped.
+    void Shutdown();
+
+    // Upper bound on worker count, regardless of the number of cores
+    static constexpr uint32_t kMaxWorkers = 8;
+
+  private:
+    struct Worker {
+        std::mutex lock;
+        std::deque<std::weak_ptr<Queue>> tasks;
+    };
+
+    void Start();
+    void WorkerFunc(uint32_t index);
+    bool PopTask(uint32_t index, std::weak_ptr<Queue> &task);
+
+    std::once_flag start_once_;
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::vector<std::thread> threads_;
+    std::atomic<uint32_t> next_worker_{0};
+
+    // Guards pending_ and exit_. Idle workers sleep on wake_ until there is a task to take.
+    std::mutex sleep_lock_;
+    std::condition_variable wake_;
+    int64_t pending_{0};
+    bool exit_{false};
+};
+
+}  // namespace vvl
@@ -20,6 +20,8 @@
 #include "state_tracker/cmd_buffer_state.h"
 #include "containers/small_vector.h"
 
+#include <algorithm>
+
 #include "profiling/profiling.h"
 
 void vvl::QueueSubmission::BeginUse() {
@@ -60,6 +62,7 @@ vvl::PreSubmitResult vvl::Queue::PreSubmit(std::vector<vvl::QueueSubmission> &&s
         item.second->PreSubmit(submissions);
     }
     PreSubmitResult result;
+    ReclaimBlocks();
     for (QueueSubmission &submission : submissions) {
         for (CommandBufferSubmission &cb_submission : submission.cb_submissions) {
             auto cb_guard = cb_submission.cb->WriteLock();
@@ -70,9 +73,8 @@ vvl::PreSubmitResult vvl::Queue::PreSubmit(std::vector<vvl::QueueSubmission> &&s
             cb_submission.cb->IncrementResources();
             cb_submission.cb->Submit(*this, submission.perf_submit_pass, submission.loc.Get());
         }
-        // seq_ is atomic so we don't need a lock until updating the deque below.
         // Note that this relies on the external synchonization requirements for the
-        // VkQueue
+        // VkQueue, this is the only thread adding submissions.
         submission.seq = ++seq_;
         result.submission_seq = submission.seq;
         submission.BeginUse();
@@ -90,44 +92,115 @@ vvl::PreSubmitResult vvl::Queue::PreSubmit(std::vector<vvl::QueueSubmission> &&s
                 result.has_external_fence = true;
             }
         }
+        const uint64_t seq = submission.seq;
+        AllocateSlot(std::move(submission));
+        published_seq_.store(seq);
+    }
+    // Retirement may have been requested before the submission was published (eg. by a semaphore wait on
+    // another queue), make sure it is picked up.
+    ScheduleIfReady();
+    return result;
+}
+
+void vvl::Queue::AllocateSlot(QueueSubmission &&submission) {
+    const uint64_t seq = submission.seq;
+    if (!tail_block_ || seq >= tail_block_->first_seq + kSlotsPerBlock) {
+        SubmissionBlock *block = nullptr;
+        if (!free_blocks_.empty()) {
+            block = free_blocks_.back();
+            free_blocks_.pop_back();
+        } else {
+            block = blocks_.emplace_back(std::make_unique<SubmissionBlock>()).get();
+        }
+        block->first_seq = seq;
+        block->next.store(nullptr);
+        if (tail_block_) {
+            tail_block_->next.store(block);
+        } else {
+            // The first block. The consumer starts here and nothing reads head_block_ before anything was published.
+            auto guard = Lock();
+            head_block_ = block;
+            consumer_block_ = block;
+        }
+        tail_block_ = block;
+    }
+    auto &slot = tail_block_->slots[seq - tail_block_->first_seq];
+    assert(!slot.has_value());
+    slot.emplace(std::move(submission));
+}
+
+void vvl::Queue::ReclaimBlocks() {
+    // A block can be reused once the consumer has retired the first submission of the next block.
+    // From then on the consumer only looks at the next block and later ones.
+    while (head_block_ && head_block_ != tail_block_) {
+        SubmissionBlock *next = head_block_->next.load();
+        assert(next);
+        if (retired_seq_.load() < next->first_seq) {
+            break;
+        }
+        SubmissionBlock *block = head_block_;
         {
             auto guard = Lock();
-            submissions_.emplace_back(std::move(submission));
-            if (!thread_) {
-                thread_ = std::make_unique<std::thread>(&Queue::ThreadFunc, this);
-            }
+            head_block_ = next;
         }
+        // The consumer already reset every slot when it retired them
+        assert(std::none_of(block->slots.begin(), block->slots.end(), [](const auto &slot) { return slot.has_value(); }));
+        free_blocks_.push_back(block);
     }
-    return result;
 }
 
-void vvl::Queue::Notify(uint64_t until_seq) {
-    auto guard = Lock();
+std::optional<vvl::QueueSubmission> &vvl::Queue::ConsumerSlot(uint64_t seq) {
+    assert(seq <= published_seq_.load());
+    while (seq >= consumer_block_->first_seq + kSlotsPerBlock) {
+        consumer_block_ = consumer_block_->next.load();
+        assert(consumer_block_);
+    }
+    auto &slot = consumer_block_->slots[seq - consumer_block_->first_seq];
+    assert(slot.has_value() && slot->seq == seq);
+    return slot;
+}
+
+uint64_t vvl::Queue::RequestRetirement(uint64_t until_seq) {
     if (until_seq == kU64Max) {
-        until_seq = seq_.load();
+        until_seq = published_seq_.load();
     }
-    if (request_seq_ < until_seq) {
-        request_seq_ = until_seq;
+    uint64_t request_seq = request_seq_.load();
+    while (request_seq < until_seq && !request_seq_.compare_exchange_weak(request_seq, until_seq)) {
+    }
+    return until_seq;
+}
+
+void vvl::Queue::Notify(uint64_t until_seq) {
+    RequestRetirement(until_seq);
+    ScheduleIfReady();
+}
+
+void vvl::Queue::ScheduleIfReady() {
+    // If some thread is already retiring, it checks for new requests before releasing the queue
+    if (!retiring_.load() && !exit_.load() && HasReadySubmission()) {
+        dev_data_.queue_retirement_pool.Schedule(SharedFromThisImpl(this));
     }
-    cond_.notify_one();
 }
 
 void vvl::Queue::Wait(const Location &loc, uint64_t until_seq) {
-    std::shared_future<void> waiter;
+    if (until_seq == kU64Max) {
+        until_seq = published_seq_.load();
+    }
+    if (retired_seq_.load() >= until_seq) {
+        return;
+    }
+    // Do the work here rather than hand it to a pool worker and sleep until it is done.
+    // If a worker already has the queue this is a no-op and we wait for it below.
+    RunRetirement(false);
+
+    bool retired = true;
     {
         auto guard = Lock();
-        if (until_seq == kU64Max) {
-            until_seq = seq_.load();
-        }
-        if (submissions_.empty() || until_seq < submissions_.begin()->seq) {
-            return;
-        }
-        uint64_t index = until_seq - submissions_.begin()->seq;
-        assert(index < submissions_.size());
-        waiter = submissions_[static_cast<size_t>(index)].waiter;
+        ++waiters_;
+        retired = cond_.wait_until(guard, GetCondWaitTimeout(), [this, until_seq]() { return retired_seq_.load() >= until_seq; });
+        --waiters_;
     }
-    auto wait_status = waiter.wait_until(GetCondWaitTimeout());
-    if (wait_status != std::future_status::ready) {
+    if (!retired) {
         dev_data_.LogError(
             "INTERNAL-ERROR-VkQueue-state-timeout", Handle(), loc,
             "The Validation Layers hit a timeout waiting for queue state to update (this is most likely a validation bug)."
@@ -137,40 +210,78 @@ void vvl::Queue::Wait(const Location &loc, uint64_t until_seq) {
 }
 
 void vvl::Queue::NotifyAndWait(const Location &loc, uint64_t until_seq) {
-    Notify(until_seq);
+    // No need to schedule on the pool, Wait() retires inline
+    until_seq = RequestRetirement(until_seq);
     Wait(loc, until_seq);
 }
 
+void vvl::Queue::WakeWaiters() {
+    if (waiters_.load() != 0) {
+        // Taking the lock orders this with the waiter's predicate check, so the notification can't be missed
+        { auto guard = Lock(); }
+        cond_.notify_all();
+    }
+}
+
+bool vvl::Queue::RunRetirement(bool queue_thread) {
+    bool retired_any = false;
+    while (!exit_.load() && HasReadySubmission()) {
+        if (retiring_.exchange(true)) {
+            // Another thread has the queue. It checks for new requests before releasing it.
+            return retired_any;
+        }
+        retired_any = true;
+        // Roll this queue forward, one submission at a time.
+        while (!exit_.load() && HasReadySubmission()) {
+            const uint64_t seq = retired_seq_.load() + 1;
+            auto &slot = ConsumerSlot(seq);
+            Retire(*slot, queue_thread);
+            // Release the command buffers, semaphores and fence now rather than when the whole block is reclaimed.
+            // The lock keeps FindTimelineWaitWithoutResolvingSignal() and PostSubmit() from reading the slot meanwhile.
+            {
+                auto guard = Lock();
+                slot.reset();
+            }
+            // The slot must not be touched after this, the producer can reclaim it
+            retired_seq_.store(seq);
+            WakeWaiters();
+        }
+        retiring_.store(false);
+        // Destroy() waits for retiring_ to be released
+        WakeWaiters();
+        // Loop in case a request came in after the last check but saw retiring_ still set
+    }
+    return retired_any;
+}
+
 std::optional<vvl::SemaphoreInfo> vvl::Queue::FindTimelineWaitWithoutResolvingSignal(uint64_t until_seq) const {
     // A simple optimization for a long sequence of submits without host waits.
-    // Stop iteration over submits if there are no timeline waits left. If only
-    // binary semaphores are used this will return immediately.
-    uint32_t processed_waits = 0;
+    // If only binary semaphores are used this will return immediately.
+    if (timeline_wait_count_.load() == 0) {
+        return {};
+    }
 
-    // Run algorithm in two separate steps to avoid lock-inversion with Semaphore::RetireWait:
-    // Semaphore::RetireWait()
-    //     Semaphore::WriteLock()
-    //         Semaphore::CanRetireTimelineWait
-    //             TimePoint::Notify
-    //                  Queue::Lock() <-- semaphore lock is still held here
-    //
-    // Current function:
-    //     Queue::Lock()
-    //     queue lock is released here, can't lock-inverse now
-    //     Semaphore::ReadLock()
+    // Run algorithm in two separate steps so the queue lock is not held while locking semaphores.
 
-    // Step 1. Get list of timeline waits (write-locks Queue)
+    // Step 1. Get list of timeline waits. The lock keeps the producer from reclaiming blocks while we walk them.
     small_vector<SemaphoreInfo, 8> timeline_waits;
     {
         auto guard = Lock();
-        for (auto it = submissions_.rbegin(); it != submissions_.rend() && processed_waits < timeline_wait_count_; ++it) {
-            const vvl::QueueSubmission &submission = *it;
-            if (submission.seq <= until_seq) {
-                for (const auto &wait_info : submission.wait_semaphores) {
-                    if (wait_info.semaphore->type == VK_SEMAPHORE_TYPE_TIMELINE) {
-                        timeline_waits.emplace_back(wait_info);
-                        processed_waits++;
-                    }
+        // Only look at published slots, the producer may be filling the ones after them
+        const uint64_t last_seq = std::min(until_seq, published_seq_.load());
+        const SubmissionBlock *block = head_block_;
+        for (uint64_t seq = retired_seq_.load() + 1; seq <= last_seq; ++seq) {
+            while (seq >= block->first_seq + kSlotsPerBlock) {
+                block = block->next.load();
+            }
+            const auto &slot = block->slots[seq - block->first_seq];
+            if (!slot.has_value()) {
+                // Retired after retired_seq_ was read
+                continue;
+            }
+            for (const auto &wait_info : slot->wait_semaphores) {
+                if (wait_info.semaphore->type == VK_SEMAPHORE_TYPE_TIMELINE) {
+                    timeline_waits.emplace_back(wait_info);
                 }
             }
         }
@@ -185,16 +296,20 @@ std::optional<vvl::SemaphoreInfo> vvl::Queue::FindTimelineWaitWithoutResolvingSi
 }
 
 void vvl::Queue::Destroy() {
-    std::unique_ptr<std::thread> dead_thread;
+    // Let whoever is retiring this queue finish the current submission, nothing new starts after exit_ is set
+    exit_.store(true);
     {
         auto guard = Lock();
-        exit_thread_ = true;
-        cond_.notify_all();
-        dead_thread = std::move(thread_);
-    }
-    if (dead_thread && dead_thread->joinable()) {
-        dead_thread->join();
-        dead_thread.reset();
+        ++waiters_;
+        cond_.wait(guard, [this]() { return !retiring_.load(); });
+        --waiters_;
+
+        // Release the command buffers, semaphores and fences still referenced by submissions that were never retired
+        for (auto &block : blocks_) {
+            for (auto &slot : block->slots) {
+                slot.reset();
+            }
+        }
     }
     for (auto &item : sub_states_) {
         item.second->Destroy();
@@ -203,9 +318,15 @@ void vvl::Queue::Destroy() {
 }
 
 void vvl::Queue::PostSubmit() {
-    auto guard = Lock();
-    if (!submissions_.empty()) {
-        PostSubmit(submissions_.back());
+    // Called on the submitting thread, the last published slot can't be reclaimed until the next PreSubmit.
+    // It may already be retired (and reset) though, the lock keeps the consumer from resetting it meanwhile.
+    const uint64_t seq = published_seq_.load();
+    if (seq != 0) {
+        auto guard = Lock();
+        auto &slot = tail_block_->slots[seq - tail_block_->first_seq];
+        if (slot.has_value()) {
+            PostSubmit(*slot);
+        }
     }
 }
 
@@ -215,33 +336,17 @@ void vvl::Queue::PostSubmit(QueueSubmission &submission) {
     }
 }
 
-vvl::QueueSubmission *vvl::Queue::NextSubmission() {
-    QueueSubmission *result = nullptr;
-    // Find if the next submission is ready so that the thread function doesn't need to worry
-    // about locking.
-    auto guard = Lock();
-    while (!exit_thread_ && (submissions_.empty() || request_seq_ < submissions_.front().seq)) {
-        // The queue thread must wait forever if nothing is happening, until we tell it to exit
-        cond_.wait(guard);
-    }
-    if (!exit_thread_) {
-        result = &submissions_.front();
-        // NOTE: the submission must remain on the dequeue until we're done processing it so that
-        // anyone waiting for it can find the correct waiter
-    }
-    return result;
-}
-
-void vvl::Queue::Retire(QueueSubmission &submission) {
-    auto is_query_updated_after = [this](const QueryObject &query_object) {
-        auto guard = this->Lock();
-        bool first_queue_submission = true;
-        for (const QueueSubmission &queue_submission : this->submissions_) {
-            // The current submission is still on the deque, so skip it
-            if (first_queue_submission) {
-                first_queue_submission = false;
-                continue;
+void vvl::Queue::Retire(QueueSubmission &submission, bool queue_thread) {
+    auto is_query_updated_after = [this, &submission](const QueryObject &query_object) {
+        // Look at the submissions after the current one. They are published, so the producer won't modify them,
+        // and the consumer (this thread) keeps them from being reclaimed.
+        const uint64_t last_seq = this->published_seq_.load();
+        const SubmissionBlock *block = this->consumer_block_;
+        for (uint64_t seq = submission.seq + 1; seq <= last_seq; ++seq) {
+            while (seq >= block->first_seq + kSlotsPerBlock) {
+                block = block->next.load();
             }
+            const QueueSubmission &queue_submission = *block->slots[seq - block->first_seq];
             for (const CommandBufferSubmission &cb_submission : queue_submission.cb_submissions) {
                 if (query_object.perf_pass != queue_submission.perf_submit_pass) {
                     continue;
@@ -258,7 +363,7 @@ void vvl::Queue::Retire(QueueSubmission &submission) {
     }
     submission.EndUse();
     for (auto &wait : submission.wait_semaphores) {
-        wait.semaphore->RetireWait(this, wait.payload, submission.loc.Get(), true);
+        wait.semaphore->RetireWait(this, wait.payload, submission.loc.Get(), queue_thread);
         timeline_wait_count_ -= (wait.semaphore->type == VK_SEMAPHORE_TYPE_TIMELINE) ? 1 : 0;
     }
     for (CommandBufferSubmission &cb_submission : submission.cb_submissions) {
@@ -276,28 +381,3 @@ void vvl::Queue::Retire(QueueSubmission &submission) {
         submission.fence->Retire();
     }
 }
-
-void vvl::Queue::ThreadFunc() {
-    VVL_TracySetThreadName(__FUNCTION__);
-
-    QueueSubmission *submission = nullptr;
-
-    // Roll this queue forward, one submission at a time.
-    while (true) {
-        submission = NextSubmission();
-        if (submission == nullptr) {
-            break;
-        }
-        Retire(*submission);
-        // wake up anyone waiting for this submission to be retired
-        {
-            std::promise<void> completed;
-            {
-                auto guard = Lock();
-                completed = std::move(submission->completed);
-                submissions_.pop_front();
-            }
-            completed.set_value();
-        }
-    }
-}
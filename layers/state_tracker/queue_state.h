@@ -21,9 +21,9 @@
 #include "state_tracker/fence_state.h"
 #include "state_tracker/semaphore_state.h"
 #include <condition_variable>
-#include <deque>
-#include <future>
-#include <thread>
+#include <array>
+#include <atomic>
+#include <optional>
 #include <vector>
 #include <string>
 #include "error_message/error_location.h"
@@ -58,7 +58,7 @@ struct CommandBufferSubmission {
 };
 
 struct QueueSubmission {
-    QueueSubmission(const Location &loc_) : loc(loc_), completed(), waiter(completed.get_future()) {}
+    QueueSubmission(const Location &loc_) : loc(loc_) {}
 
     bool end_batch{false};
     std::vector<vvl::CommandBufferSubmission> cb_submissions{};
@@ -69,8 +69,6 @@ struct QueueSubmission {
     LocationCapture loc;
     uint64_t seq{0};
     uint32_t perf_submit_pass{0};
-    std::promise<void> completed;
-    std::shared_future<void> waiter;
 
     void AddCommandBuffer(std::shared_ptr<vvl::CommandBuffer> cb_state, std::vector<std::string> initial_label_stack) {
         cb_submissions.emplace_back(std::move(cb_state), std::move(initial_label_stack));
@@ -90,7 +88,7 @@ struct QueueSubmission {
     void BeginUse();
 };
 
-// This timeout is for all queue threads to update their state after we know
+// This timeout is for queue retirement to update the state after we know
 // (via being in a PostRecord call) that a fence, semaphore or wait for idle has
 // completed. Hitting it is almost a certainly a bug in this code.
 static inline std::chrono::time_point<std::chrono::steady_clock> GetCondWaitTimeout() {
@@ -125,12 +123,14 @@ class Queue : public StateObject, public SubStateManager<QueueSubState> {
     // called from the various PostCallRecordQueueSubmit() methods
     void PostSubmit();
 
-    // Tell the queue thread that submissions up to and including the submission with
-    // sequence number until_seq have finished. kU64Max means to finish all submissions.
+    // Tell the queue that submissions up to and including the submission with sequence number
+    // until_seq have finished. kU64Max means to finish all submissions. The retirement runs on
+    // the device's QueueRetirementPool unless a waiter gets to it first.
     void Notify(uint64_t until_seq = kU64Max);
 
-    // Wait for the queue thread to finish processing submissions with sequence numbers
-    // up to and including until_seq. kU64Max means to finish all submissions.
+    // Wait for submissions with sequence numbers up to and including until_seq to be retired.
+    // kU64Max means to finish all submissions. If no other thread is retiring this queue, the
+    // notified submissions are retired on the calling thread instead of waiting for a worker.
     void Wait(const Location &loc, uint64_t until_seq = kU64Max);
 
     // Helper that combines Notify and Wait
@@ -140,6 +140,11 @@ class Queue : public StateObject, public SubStateManager<QueueSubState> {
     // Check submissions up to and including until_seq.
     std::optional<SemaphoreInfo> FindTimelineWaitWithoutResolvingSignal(uint64_t until_seq) const;
 
+    // Retire notified submissions, in order, on the calling thread. Only one thread at a time retires
+    // a queue: if another thread already is, it is left to finish the job. Returns true if anything was retired here.
+    // queue_thread is false when called from an API call (and the validation object lock may be held).
+    bool RunRetirement(bool queue_thread);
+
   public:
     // Queue family index. As queueFamilyIndex parameter in vkGetDeviceQueue.
     const uint32_t queue_family_index;
@@ -166,30 +171,71 @@ class Queue : public StateObject, public SubStateManager<QueueSubState> {
     // called from the various PostCallRecordQueueSubmit() methods
     void PostSubmit(QueueSubmission &submission);
 
-    // called when the worker thread decides a submissions has finished executing
-    void Retire(QueueSubmission &submission);
+    // called when RunRetirement decides a submissions has finished executing
+    void Retire(QueueSubmission &submission, bool queue_thread);
 
   private:
-    uint32_t timeline_wait_count_ = 0;
+    // Written by PreSubmit and RunRetirement, read by FindTimelineWaitWithoutResolvingSignal from any thread
+    std::atomic<uint32_t> timeline_wait_count_{0};
 
   private:
+    // In-flight submissions live in fixed size blocks of slots, linked in submission order.
+    //
+    // There is one producer (PreSubmit, externally synchronized by the VkQueue) and one consumer at a time (whoever holds
+    // retiring_), so appending and retiring don't need lock_:
+    //  - the producer fills a slot, then publishes it by storing its seq to published_seq_
+    //  - the consumer retires a slot, resets it to release the submission's command buffers, semaphores and fence, then
+    //    marks it done by storing its seq to retired_seq_
+    //  - the producer reuses a block only after the consumer has moved on to the next one
+    // lock_ is taken to reset a slot and to reclaim a block, so that readers from other threads (and PostSubmit) can walk
+    // the blocks. Readers skip slots that were already reset.
+    static constexpr uint64_t kSlotsPerBlock = 64;
+    struct SubmissionBlock {
+        std::array<std::optional<QueueSubmission>, kSlotsPerBlock> slots;
+        uint64_t first_seq{0};
+        std::atomic<SubmissionBlock *> next{nullptr};
+    };
+
     using LockGuard = std::unique_lock<std::mutex>;
-    void ThreadFunc();
-    QueueSubmission *NextSubmission();
     LockGuard Lock() const { return LockGuard(lock_); }
+    bool HasReadySubmission() const {
+        const uint64_t next_seq = retired_seq_.load() + 1;
+        return next_seq <= published_seq_.load() && next_seq <= request_seq_.load();
+    }
+    // Returns until_seq with kU64Max resolved to the last submission
+    uint64_t RequestRetirement(uint64_t until_seq);
+    // Hand the queue to the QueueRetirementPool if there are notified submissions and no one is retiring them
+    void ScheduleIfReady();
+    // Producer side
+    void AllocateSlot(QueueSubmission &&submission);
+    void ReclaimBlocks();
+    // Consumer side, only valid while holding retiring_
+    std::optional<QueueSubmission> &ConsumerSlot(uint64_t seq);
+    // Signal threads blocked in Wait() or Destroy()
+    void WakeWaiters();
 
     DeviceState &dev_data_;
 
-    // state related to submitting to the queue, all data members must
-    // be accessed with lock_ held
-    std::unique_ptr<std::thread> thread_;
-    std::deque<QueueSubmission> submissions_;
     std::atomic<uint64_t> seq_{0};
-    uint64_t request_seq_{0};
-    bool exit_thread_{false};
+    std::atomic<uint64_t> published_seq_{0};
+    std::atomic<uint64_t> retired_seq_{0};
+    std::atomic<uint64_t> request_seq_{0};
+    std::atomic<bool> exit_{false};
+    // Set while a thread (pool worker or waiter) is retiring submissions. Keeps retirement in order.
+    std::atomic<bool> retiring_{false};
+
+    // Owned by the producer. head_block_ is also read with lock_ held.
+    std::vector<std::unique_ptr<SubmissionBlock>> blocks_;
+    std::vector<SubmissionBlock *> free_blocks_;
+    SubmissionBlock *head_block_{nullptr};
+    SubmissionBlock *tail_block_{nullptr};
+    // Owned by the consumer
+    SubmissionBlock *consumer_block_{nullptr};
+
     mutable std::mutex lock_;
-    // condition to wake up the queue's thread
+    // Wait() and Destroy() block on cond_, retirement only takes lock_ to notify when waiters_ is non-zero
     std::condition_variable cond_;
+    std::atomic<uint32_t> waiters_{0};
 };
 
 class QueueSubState {
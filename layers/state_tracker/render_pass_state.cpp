@@ -18,6 +18,7 @@
  */
 
 #include "state_tracker/render_pass_state.h"
+#include <vulkan/utility/vk_struct_helper.hpp>
 #include "utils/convert_utils.h"
 #include "state_tracker/image_state.h"
 
@@ -271,6 +272,94 @@ static bool IsDynamicRenderingMultiviewEnabled(const VkRenderingInfo *rendering_
     return rendering_info && rendering_info->viewMask != 0u;
 }
 
+static RenderPassCompatibilityDict render_pass_compatibility_dict;
+
+// Appends the parts of an attachment reference that matter for compatibility, out of range indices count as unused
+static void AddCompatibleAttachment(const vku::safe_VkRenderPassCreateInfo2 &create_info, uint32_t attachment,
+                                    RenderPassCompatibilityDef &def) {
+    if (attachment >= create_info.attachmentCount) {
+        def.emplace_back(VK_ATTACHMENT_UNUSED);
+        return;
+    }
+    const auto &desc = create_info.pAttachments[attachment];
+    def.emplace_back(0);  // used, keeps the words below from lining up with an unused marker
+    def.emplace_back(static_cast<uint32_t>(desc.format));
+    def.emplace_back(static_cast<uint32_t>(desc.samples));
+    def.emplace_back(desc.flags);
+}
+
+static void AddCompatibleFlags64(uint64_t flags, RenderPassCompatibilityDef &def) {
+    def.emplace_back(static_cast<uint32_t>(flags));
+    def.emplace_back(static_cast<uint32_t>(flags >> 32));
+}
+
+// Must cover every field CoreChecks::ValidateRenderPassCompatibility compares. It can be stricter (eg. attachment counts are
+// compared even though trailing unused references would be compatible), that only means taking the slow path.
+static RenderPassCompatibilityId GetRenderPassCompatibilityId(const vku::safe_VkRenderPassCreateInfo2 &create_info) {
+    RenderPassCompatibilityDef def;
+    def.emplace_back(create_info.flags);
+    def.emplace_back(create_info.subpassCount);
+    for (uint32_t i = 0; i < create_info.subpassCount; ++i) {
+        const auto &subpass = create_info.pSubpasses[i];
+        def.emplace_back(subpass.flags);
+        def.emplace_back(subpass.viewMask);
+        def.emplace_back(subpass.inputAttachmentCount);
+        for (uint32_t j = 0; j < subpass.inputAttachmentCount; ++j) {
+            AddCompatibleAttachment(create_info, subpass.pInputAttachments[j].attachment, def);
+        }
+        def.emplace_back(subpass.colorAttachmentCount);
+        for (uint32_t j = 0; j < subpass.colorAttachmentCount; ++j) {
+            AddCompatibleAttachment(create_info, subpass.pColorAttachments[j].attachment, def);
+            // Resolve attachments only matter with more than one subpass
+            if (create_info.subpassCount > 1) {
+                const uint32_t resolve =
+                    subpass.pResolveAttachments ? subpass.pResolveAttachments[j].attachment : VK_ATTACHMENT_UNUSED;
+                AddCompatibleAttachment(create_info, resolve, def);
+            }
+        }
+        const uint32_t depth_stencil =
+            subpass.pDepthStencilAttachment ? subpass.pDepthStencilAttachment->attachment : VK_ATTACHMENT_UNUSED;
+        AddCompatibleAttachment(create_info, depth_stencil, def);
+
+        if (const auto fsr = vku::FindStructInPNextChain<VkFragmentShadingRateAttachmentInfoKHR>(subpass.pNext)) {
+            def.emplace_back(1);
+            def.emplace_back(fsr->shadingRateAttachmentTexelSize.width);
+            def.emplace_back(fsr->shadingRateAttachmentTexelSize.height);
+        } else {
+            def.emplace_back(0);
+        }
+    }
+
+    // A VkMemoryBarrier2 in the create info pNext replaces the masks of every dependency
+    const auto barrier = vku::FindStructInPNextChain<VkMemoryBarrier2>(create_info.pNext);
+    def.emplace_back(create_info.dependencyCount);
+    for (uint32_t i = 0; i < create_info.dependencyCount; ++i) {
+        const auto &dependency = create_info.pDependencies[i];
+        def.emplace_back(dependency.srcSubpass);
+        def.emplace_back(dependency.dstSubpass);
+        AddCompatibleFlags64(barrier ? barrier->srcStageMask : dependency.srcStageMask, def);
+        AddCompatibleFlags64(barrier ? barrier->dstStageMask : dependency.dstStageMask, def);
+        AddCompatibleFlags64(barrier ? barrier->srcAccessMask : dependency.srcAccessMask, def);
+        AddCompatibleFlags64(barrier ? barrier->dstAccessMask : dependency.dstAccessMask, def);
+        def.emplace_back(dependency.dependencyFlags);
+        def.emplace_back(static_cast<uint32_t>(dependency.viewOffset));
+    }
+
+    def.emplace_back(create_info.correlatedViewMaskCount);
+    for (uint32_t i = 0; i < create_info.correlatedViewMaskCount; ++i) {
+        def.emplace_back(create_info.pCorrelatedViewMasks[i]);
+    }
+
+    if (const auto fdm = vku::FindStructInPNextChain<VkRenderPassFragmentDensityMapCreateInfoEXT>(create_info.pNext)) {
+        def.emplace_back(1);
+        AddCompatibleAttachment(create_info, fdm->fragmentDensityMapAttachment.attachment, def);
+    } else {
+        def.emplace_back(0);
+    }
+
+    return render_pass_compatibility_dict.LookUp(std::move(def));
+}
+
 namespace vvl {
 
 RenderPass::RenderPass(VkRenderPass handle, VkRenderPassCreateInfo2 const *pCreateInfo)
@@ -278,7 +367,8 @@ RenderPass::RenderPass(VkRenderPass handle, VkRenderPassCreateInfo2 const *pCrea
       use_dynamic_rendering(false),
       use_dynamic_rendering_inherited(false),
       has_multiview_enabled(false),
-      create_info(pCreateInfo) {
+      create_info(pCreateInfo),
+      compatibility_id(GetRenderPassCompatibilityId(create_info)) {
     InitRenderPassState(this);
 }
 
@@ -292,7 +382,8 @@ RenderPass::RenderPass(VkRenderPass handle, VkRenderPassCreateInfo const *pCreat
       use_dynamic_rendering(false),
       use_dynamic_rendering_inherited(false),
       has_multiview_enabled(false),
-      create_info(ConvertCreateInfo(*pCreateInfo)) {
+      create_info(ConvertCreateInfo(*pCreateInfo)),
+      compatibility_id(GetRenderPassCompatibilityId(create_info)) {
     InitRenderPassState(this);
 }
 
@@ -19,6 +19,7 @@
 #pragma once
 #include <vulkan/vulkan_core.h>
 #include "state_tracker/state_object.h"
+#include "utils/hash_util.h"
 #include <vulkan/utility/vk_safe_struct.hpp>
 #include <map>
 
@@ -60,6 +61,13 @@ struct SubpassLayout {
     VkImageLayout layout;
 };
 
+// Canonical dictionary of everything render pass compatibility looks at, flattened into words.
+// Two render passes with the same Id are compatible, different Ids need the full comparison (which also reports the differences)
+using RenderPassCompatibilityDef = std::vector<uint32_t>;
+using RenderPassCompatibilityDict =
+    hash_util::Dictionary<RenderPassCompatibilityDef, hash_util::IsOrderedContainer<RenderPassCompatibilityDef>>;
+using RenderPassCompatibilityId = RenderPassCompatibilityDict::Id;
+
 namespace vvl {
 
 // Vulkan 1.0 has a VkRenderPass object, things like dynamic rendering moved the handle to be across various other structs/calls.
@@ -83,6 +91,8 @@ class RenderPass : public StateObject {
     const vku::safe_VkPipelineRenderingCreateInfo dynamic_pipeline_rendering_create_info;
     const vku::safe_VkCommandBufferInheritanceRenderingInfo inheritance_rendering_info;
     const vku::safe_VkRenderPassCreateInfo2 create_info;
+    // Only set for VkRenderPass objects, null for dynamic rendering
+    const RenderPassCompatibilityId compatibility_id;
     using SubpassVec = std::vector<uint32_t>;
     using SelfDepVec = std::vector<SubpassVec>;
     const std::vector<SubpassVec> self_dependencies;
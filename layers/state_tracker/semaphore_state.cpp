@@ -20,6 +20,8 @@
 #include "state_tracker/queue_state.h"
 #include "state_tracker/state_tracker.h"
 
+#include <algorithm>
+
 static bool CanSignalBinarySemaphoreAfterOperation(vvl::Semaphore::OpType op_type) {
     return op_type == vvl::Semaphore::kNone || op_type == vvl::Semaphore::kWait;
 }
@@ -38,6 +40,62 @@ void vvl::Semaphore::TimePoint::Notify() const {
     signal_submit->queue->Notify(signal_submit->seq);
 }
 
+std::deque<vvl::Semaphore::Timeline::Entry>::iterator vvl::Semaphore::Timeline::RingLowerBound(uint64_t payload) {
+    return std::lower_bound(ring_.begin(), ring_.end(), payload,
+                            [](const Entry &entry, uint64_t value) { return entry.first < value; });
+}
+
+std::deque<vvl::Semaphore::Timeline::Entry>::const_iterator vvl::Semaphore::Timeline::RingLowerBound(uint64_t payload) const {
+    return std::lower_bound(ring_.begin(), ring_.end(), payload,
+                            [](const Entry &entry, uint64_t value) { return entry.first < value; });
+}
+
+vvl::Semaphore::TimePoint *vvl::Semaphore::Timeline::Find(uint64_t payload) {
+    if (use_map_) {
+        auto it = map_.find(payload);
+        return it != map_.end() ? &it->second : nullptr;
+    }
+    auto it = RingLowerBound(payload);
+    return (it != ring_.end() && it->first == payload) ? &it->second : nullptr;
+}
+
+const vvl::Semaphore::TimePoint *vvl::Semaphore::Timeline::Find(uint64_t payload) const {
+    return const_cast<Timeline *>(this)->Find(payload);
+}
+
+vvl::Semaphore::TimePoint &vvl::Semaphore::Timeline::operator[](uint64_t payload) {
+    if (use_map_) {
+        return map_[payload];
+    }
+    if (ring_.empty() || payload > ring_.back().first) {
+        return ring_.emplace_back(payload, TimePoint{}).second;
+    }
+    auto it = RingLowerBound(payload);
+    if (it->first == payload) {
+        return it->second;
+    }
+    // Out of order payload, fall back to the map until the timeline drains
+    for (Entry &entry : ring_) {
+        map_.emplace_hint(map_.end(), entry.first, std::move(entry.second));
+    }
+    ring_.clear();
+    use_map_ = true;
+    return map_[payload];
+}
+
+void vvl::Semaphore::Timeline::EraseUpTo(uint64_t last_payload) {
+    if (use_map_) {
+        map_.erase(map_.begin(), map_.upper_bound(last_payload));
+        if (map_.empty()) {
+            use_map_ = false;
+        }
+    } else {
+        while (!ring_.empty() && ring_.front().first <= last_payload) {
+            ring_.pop_front();
+        }
+    }
+}
+
 vvl::Semaphore::Semaphore(DeviceState &dev, VkSemaphore handle, const VkSemaphoreTypeCreateInfo *type_create_info,
                           const VkSemaphoreCreateInfo *pCreateInfo)
     : RefcountedStateObject(handle, kVulkanObjectTypeSemaphore),
@@ -51,6 +109,7 @@ vvl::Semaphore::Semaphore(DeviceState &dev, VkSemaphore handle, const VkSemaphor
       completed_{type == VK_SEMAPHORE_TYPE_TIMELINE ? kSignal : kNone, SubmissionReference{},
                  type_create_info ? type_create_info->initialValue : 0},
       next_payload_(completed_.payload + 1),
+      completed_payload_(completed_.payload),
       dev_data_(dev) {
 }
 
@@ -63,16 +122,22 @@ const VulkanTypedHandle *vvl::Semaphore::InUse() const {
         return nullptr;
     }
     // Scan timeline to find the first queue that uses the semaphore
-    for (const auto &[_, timepoint] : timeline_) {
+    const VulkanTypedHandle *queue_handle = nullptr;
+    timeline_.ForEachFrom(0, [&queue_handle](uint64_t, const TimePoint &timepoint) {
         if (timepoint.signal_submit.has_value() && timepoint.signal_submit->queue) {
-            return &timepoint.signal_submit->queue->Handle();
+            queue_handle = &timepoint.signal_submit->queue->Handle();
         } else {
             for (const SubmissionReference &wait_submit : timepoint.wait_submits) {
                 if (wait_submit.queue) {
-                    return &wait_submit.queue->Handle();
+                    queue_handle = &wait_submit.queue->Handle();
+                    break;
                 }
             }
         }
+        return queue_handle != nullptr;
+    });
+    if (queue_handle) {
+        return queue_handle;
     }
     // NOTE: In current implementation timepoints represent pending state. In-use tracking
     // can retire timepoint even if submission is still pending, so timeline_ state it's
@@ -105,7 +170,7 @@ void vvl::Semaphore::EnqueueSignal(const SubmissionReference &signal_submit, uin
         payload = next_payload_++;
     }
     // Check there is no existing signal, validation should enforce this
-    assert(timeline_.find(payload) == timeline_.end() || !timeline_.find(payload)->second.signal_submit.has_value());
+    assert(!timeline_.Find(payload) || !timeline_.Find(payload)->signal_submit.has_value());
 
     timeline_[payload].signal_submit.emplace(signal_submit);
 }
@@ -125,8 +190,8 @@ void vvl::Semaphore::EnqueueWait(const SubmissionReference &wait_submit, uint64_
             }
         } else {
             // generate binary payload value from the most recent pending binary signal
-            assert(timeline_.rbegin()->second.HasSignaler());
-            payload = timeline_.rbegin()->first;
+            assert(timeline_.Last().HasSignaler());
+            payload = timeline_.LastPayload();
         }
     }
 
@@ -135,7 +200,7 @@ void vvl::Semaphore::EnqueueWait(const SubmissionReference &wait_submit, uint64_
         // NOTE: wait's submission can still be pending, but timepoint lifetime logic
         // is determined by the signal. completed_ is updated when signal is retired.
         // The matching waits should be resolved against completed_ in this case.
-        assert(!vvl::Contains(timeline_, payload));
+        assert(!timeline_.Find(payload));
         completed_.op_type = kWait;
         completed_.submit = wait_submit;
         return;
@@ -148,7 +213,7 @@ void vvl::Semaphore::EnqueueAcquire(vvl::Func acquire_command) {
     assert(type == VK_SEMAPHORE_TYPE_BINARY);
     auto guard = WriteLock();
     auto payload = next_payload_++;
-    assert(timeline_.find(payload) == timeline_.end());
+    assert(!timeline_.Find(payload));
     timeline_[payload].acquire_command.emplace(acquire_command);
 }
 
@@ -156,9 +221,7 @@ std::optional<vvl::Semaphore::SemOp> vvl::Semaphore::LastOp(const std::function<
     auto guard = ReadLock();
     std::optional<SemOp> result;
 
-    for (auto pos = timeline_.rbegin(); pos != timeline_.rend(); ++pos) {
-        uint64_t payload = pos->first;
-        auto &timepoint = pos->second;
+    timeline_.ForEachReverse([&result, &filter](uint64_t payload, const TimePoint &timepoint) {
         for (auto &op : timepoint.wait_submits) {
             if (!filter || filter(kWait, payload, true)) {
                 result.emplace(SemOp(kWait, op, payload));
@@ -171,14 +234,15 @@ std::optional<vvl::Semaphore::SemOp> vvl::Semaphore::LastOp(const std::function<
 
             if (!filter || filter(kSignal, payload, pending)) {
                 result.emplace(SemOp(kSignal, *timepoint.signal_submit, payload));
-                break;
+                return true;
             }
         }
         if (!result && timepoint.acquire_command && (!filter || filter(kBinaryAcquire, payload, true))) {
             result.emplace(SemOp(*timepoint.acquire_command, payload));
-            break;
+            return true;
         }
-    }
+        return false;
+    });
     if (!result && (!filter || filter(completed_.op_type, completed_.payload, false))) {
         result.emplace(completed_);
     }
@@ -191,7 +255,7 @@ std::optional<vvl::SubmissionReference> vvl::Semaphore::GetPendingBinaryWaitSubm
     if (timeline_.empty()) {
         return {};
     }
-    const auto &timepoint = timeline_.rbegin()->second;
+    const auto &timepoint = timeline_.Last();
     assert(timepoint.wait_submits.empty() || timepoint.wait_submits.size() == 1);
 
     // No waits
@@ -211,7 +275,7 @@ std::optional<vvl::SemaphoreInfo> vvl::Semaphore::GetPendingBinarySignalTimeline
     if (timeline_.empty()) {
         return {};
     }
-    const TimePoint &timepoint = timeline_.rbegin()->second;
+    const TimePoint &timepoint = timeline_.Last();
     assert(timepoint.HasSignaler());
     const auto &signal_submit = timepoint.signal_submit;
 
@@ -237,9 +301,9 @@ bool vvl::Semaphore::CanBinaryBeSignaled() const {
     }
     // Every timeline slot of binary semaphore should contain at least a signal.
     // Wait before signal is not allowed.
-    assert(timeline_.rbegin()->second.HasSignaler());
+    assert(timeline_.Last().HasSignaler());
 
-    return timeline_.rbegin()->second.HasWaiters();
+    return timeline_.Last().HasWaiters();
 }
 
 bool vvl::Semaphore::CanBinaryBeWaited() const {
@@ -249,7 +313,7 @@ bool vvl::Semaphore::CanBinaryBeWaited() const {
         return CanWaitBinarySemaphoreAfterOperation(completed_.op_type);
     }
 
-    const TimePoint &timepoint = timeline_.rbegin()->second;
+    const TimePoint &timepoint = timeline_.Last();
 
     assert(scope_ == vvl::Semaphore::kInternal);  // Ensured by all calling sites
 
@@ -274,7 +338,7 @@ void vvl::Semaphore::GetLastBinarySignalSource(VkQueue &queue, vvl::Func &acquir
             acquire_command = *completed_.acquire_command;
         }
     } else {
-        const TimePoint &timepoint = timeline_.rbegin()->second;
+        const TimePoint &timepoint = timeline_.Last();
         if (timepoint.signal_submit.has_value() && timepoint.signal_submit->queue) {
             queue = timepoint.signal_submit->queue->VkHandle();
         } else if (timepoint.acquire_command.has_value()) {
@@ -292,19 +356,13 @@ bool vvl::Semaphore::HasResolvingTimelineSignal(uint64_t wait_payload) const {
         return true;
     }
 
-    auto it = timeline_.find(wait_payload);
-    assert(it != timeline_.end());  // for each registered wait there is a timepoint
-    while (it != timeline_.end()) {
-        if (it->second.signal_submit.has_value()) {
-            assert(it->first >= wait_payload);  // timepoints are ordered in increasing order
-            return true;
-        }
-        ++it;
-    }
-    return false;
+    assert(timeline_.Find(wait_payload));  // for each registered wait there is a timepoint
+    return timeline_.ForEachFrom(wait_payload, [](uint64_t, const TimePoint &timepoint) {
+        return timepoint.signal_submit.has_value();
+    });
 }
 
-bool vvl::Semaphore::CanRetireBinaryWait(TimePoint &timepoint) const {
+bool vvl::Semaphore::CanRetireBinaryWait(TimePoint &timepoint, vvl::Queue *&signaling_queue) const {
     assert(type == VK_SEMAPHORE_TYPE_BINARY);
     // The only allowed configuration when binary semaphore wait does not have a signal
     // is external semaphore. Just retire the wait because there is no guarantee we can
@@ -318,57 +376,60 @@ bool vvl::Semaphore::CanRetireBinaryWait(TimePoint &timepoint) const {
     // current queue are already processed and corresponding timepoints are retired).
     // Initiate forward progress on signaling queue and ask the caller to wait.
     timepoint.Notify();
+    signaling_queue = timepoint.signal_submit->queue;
     return false;
 }
 
-bool vvl::Semaphore::CanRetireTimelineWait(const vvl::Queue *current_queue, uint64_t payload) const {
+bool vvl::Semaphore::CanRetireTimelineWait(const vvl::Queue *current_queue, uint64_t payload,
+                                           vvl::Queue *&signaling_queue) const {
     assert(type == VK_SEMAPHORE_TYPE_TIMELINE);
 
     // In the correct program the resolving signal is the next signal on the timeline,
     // otherwise this violates the rule of strictly increasing signal values.
-    auto it = timeline_.find(payload);
-    assert(it != timeline_.end());
-    for (; it != timeline_.end(); ++it) {
-        const TimePoint &t = it->second;
+    assert(timeline_.Find(payload));
+    const TimePoint *resolving = nullptr;
+    timeline_.ForEachFrom(payload, [current_queue, &resolving](uint64_t, const TimePoint &t) {
         if (!t.signal_submit.has_value()) {
-            continue;
+            return false;
         }
         // If the next signal is on the waiting (current) queue, it can't be a resolving signal (blocked by wait).
         // QueueSubmissionValidator will also report an error about non-increasing signal values
         if (t.signal_submit->queue != nullptr && t.signal_submit->queue == current_queue) {
-            continue;
+            return false;
         }
         // Found the resolving signal
-        break;
-    }
+        resolving = &t;
+        return true;
+    });
 
     // There is always a resolving signal when we reach a retirement phase (CPU successfully finished waiting on GPU).
     // For external semaphore we might not have visibility of this signal. Just retire the wait.
-    if (it == timeline_.end()) {
+    if (!resolving) {
         assert(scope_ != kInternal);
         return true;
     }
 
     // Found host signal that finishes this wait
-    const TimePoint &t = it->second;
+    const TimePoint &t = *resolving;
     if (t.signal_submit->queue == nullptr) {
         return true;
     }
 
-    // Notify signaling queue and wait for its queue thread
+    // Notify signaling queue and wait for its retirement
     t.Notify();
+    signaling_queue = t.signal_submit->queue;
     return false;
 }
 
 void vvl::Semaphore::RetireWait(vvl::Queue *current_queue, uint64_t payload, const Location &loc, bool queue_thread) {
-    std::shared_future<void> waiter;
+    vvl::Queue *signaling_queue = nullptr;
     {
         auto guard = WriteLock();
         if (payload <= completed_.payload) {
             return;
         }
         if (scope_ != kInternal) {
-            if (!vvl::Find(timeline_, payload)) {
+            if (!timeline_.Find(payload)) {
                 // GetSemaphoreCounterValue for external semaphore might not have a registered timepoint.
                 // Add timepoint so we can retire timeline up to that point.
                 assert(type == VK_SEMAPHORE_TYPE_TIMELINE);
@@ -379,15 +440,17 @@ void vvl::Semaphore::RetireWait(vvl::Queue *current_queue, uint64_t payload, con
                 imported_handle_type_.reset();
             }
         }
-        TimePoint &timepoint = vvl::FindExisting(timeline_, payload);
+        TimePoint *timepoint_ptr = timeline_.Find(payload);
+        assert(timepoint_ptr);
+        TimePoint &timepoint = *timepoint_ptr;
 
         bool retire = false;
         if (timepoint.acquire_command) {
             retire = true;  // There is resolving acquire signal, timepoint can be retired
         } else if (type == VK_SEMAPHORE_TYPE_BINARY) {
-            retire = CanRetireBinaryWait(timepoint);
+            retire = CanRetireBinaryWait(timepoint, signaling_queue);
         } else {
-            retire = CanRetireTimelineWait(current_queue, payload);
+            retire = CanRetireTimelineWait(current_queue, payload, signaling_queue);
         }
         if (retire) {
             // SemOp::submit is used only by the binary semaphores.
@@ -399,11 +462,8 @@ void vvl::Semaphore::RetireWait(vvl::Queue *current_queue, uint64_t payload, con
         }
 
         // Wait for some other queue or a host operation to retire
-        assert(timepoint.waiter.valid());
-        // the current timepoint should get destroyed while we're waiting, so copy out the waiter.
-        waiter = timepoint.waiter;
     }
-    WaitTimePoint(std::move(waiter), payload, !queue_thread, loc);
+    WaitTimePoint(payload, signaling_queue, !queue_thread, loc);
 }
 
 void vvl::Semaphore::RetireSignal(uint64_t payload) {
@@ -411,7 +471,9 @@ void vvl::Semaphore::RetireSignal(uint64_t payload) {
     if (payload <= completed_.payload) {
         return;
     }
-    TimePoint &timepoint = vvl::FindExisting(timeline_, payload);
+    const TimePoint *timepoint_ptr = timeline_.Find(payload);
+    assert(timepoint_ptr);
+    const TimePoint &timepoint = *timepoint_ptr;
     assert(timepoint.signal_submit.has_value());
 
     OpType completed_op = kSignal;
@@ -431,33 +493,47 @@ void vvl::Semaphore::RetireSignal(uint64_t payload) {
 }
 
 void vvl::Semaphore::RetireTimePoint(uint64_t payload, OpType completed_op, SubmissionReference completed_submit) {
-    auto it = timeline_.begin();
-    while (it != timeline_.end() && it->first <= payload) {
-        assert(it->first > completed_.payload);
-        it->second.completed.set_value();
-        ++it;
-    }
-    timeline_.erase(timeline_.begin(), it);
+    assert(payload > completed_.payload);
+    timeline_.EraseUpTo(payload);
     completed_ = SemOp(completed_op, completed_submit, payload);
+    completed_payload_.store(payload);
+    if (waiters_.load() != 0) {
+        // Taking the lock orders this with the waiter's predicate check, so the notification can't be missed
+        { std::lock_guard<std::mutex> guard(wait_lock_); }
+        wait_cond_.notify_all();
+    }
 }
 
-void vvl::Semaphore::WaitTimePoint(std::shared_future<void> &&waiter, uint64_t payload, bool unblock_validation_object,
+void vvl::Semaphore::WaitTimePoint(uint64_t payload, vvl::Queue *signaling_queue, bool unblock_validation_object,
                                    const Location &loc) {
     if (unblock_validation_object) {
         dev_data_.BeginBlockingOperation();
     }
 
-    auto result = waiter.wait_until(GetCondWaitTimeout());
+    // Retire the signaling queue on this thread instead of waiting for a pool worker to do it.
+    // No validation object lock is held at this point, so this runs as if on a queue thread.
+    if (signaling_queue) {
+        signaling_queue->RunRetirement(true);
+    }
+
+    bool retired = true;
+    {
+        std::unique_lock<std::mutex> guard(wait_lock_);
+        ++waiters_;
+        retired = wait_cond_.wait_until(guard, GetCondWaitTimeout(),
+                                        [this, payload]() { return completed_payload_.load() >= payload; });
+        --waiters_;
+    }
 
     if (unblock_validation_object) {
         dev_data_.EndBlockingOperation();
     }
 
-    if (result != std::future_status::ready) {
+    if (!retired) {
         dev_data_.LogError("INTERNAL-ERROR-VkSemaphore-state-timeout", Handle(), loc,
                            "The Validation Layers hit a timeout waiting for timeline semaphore state to update (this is most "
                            "likely a validation bug). completed_.payload=%" PRIu64 " wait_payload=%" PRIu64,
-                           completed_.payload, payload);
+                           completed_payload_.load(), payload);
     }
 }
 
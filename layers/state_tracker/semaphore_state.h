@@ -19,9 +19,12 @@
 #pragma once
 #include "state_tracker/state_object.h"
 #include "state_tracker/submission_reference.h"
-#include <future>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
 #include <optional>
 #include <map>
+#include <mutex>
 #include <shared_mutex>
 #include "error_message/error_location.h"
 
@@ -75,10 +78,7 @@ class Semaphore : public RefcountedStateObject {
         std::optional<SubmissionReference> signal_submit;
         small_vector<SubmissionReference, 1, uint32_t> wait_submits;
         std::optional<Func> acquire_command;
-        std::promise<void> completed;
-        std::shared_future<void> waiter;
 
-        TimePoint() : completed(), waiter(completed.get_future()) {}
         bool HasSignaler() const { return signal_submit.has_value() || acquire_command.has_value(); }
         bool HasWaiters() const { return !wait_submits.empty(); }
         void Notify() const;
@@ -159,16 +159,57 @@ class Semaphore : public RefcountedStateObject {
     WriteLockGuard WriteLock() { return WriteLockGuard(lock_); }
 
     // Return true if timepoint has no dependencies and can be retired.
-    // If there is unresolved wait then notify signaling queue (if there is registered signal) and return false
-    bool CanRetireBinaryWait(TimePoint &timepoint) const;
-    bool CanRetireTimelineWait(const vvl::Queue *current_queue, uint64_t payload) const;
+    // If there is unresolved wait then notify signaling queue (if there is registered signal) and return false.
+    // The notified queue is returned in signaling_queue, so the caller can help retire it.
+    bool CanRetireBinaryWait(TimePoint &timepoint, vvl::Queue *&signaling_queue) const;
+    bool CanRetireTimelineWait(const vvl::Queue *current_queue, uint64_t payload, vvl::Queue *&signaling_queue) const;
 
     // Mark timepoints up to and including payload as completed (notify waiters) and remove them from timeline
     void RetireTimePoint(uint64_t payload, OpType completed_op, SubmissionReference completed_submit);
 
-    // Waits for the waiter. Unblock parameter must be true if the caller is a validation object and false otherwise.
+    // Waits until the timepoint at payload is retired, retiring signaling_queue inline first if no one else is.
+    // Unblock parameter must be true if the caller is a validation object and false otherwise.
     // (validation object has to use {Begin/End}BlockingOperation() when waiting for the timepoint)
-    void WaitTimePoint(std::shared_future<void> &&waiter, uint64_t payload, bool unblock_validation_object, const Location &loc);
+    void WaitTimePoint(uint64_t payload, vvl::Queue *signaling_queue, bool unblock_validation_object, const Location &loc);
+
+    // Pending timepoints ordered by payload.
+    //
+    // Payloads almost always come in increasing order (binary semaphores always, timelines in the common case of a
+    // counter that only goes up), so timepoints are kept in a deque that is appended at the back and retired from the
+    // front. Adding a payload below the last one switches to an ordered map until the timeline drains.
+    class Timeline {
+      public:
+        bool empty() const { return use_map_ ? map_.empty() : ring_.empty(); }
+
+        TimePoint *Find(uint64_t payload);
+        const TimePoint *Find(uint64_t payload) const;
+        // Returns the timepoint at payload, adding it if needed
+        TimePoint &operator[](uint64_t payload);
+
+        // Timepoint with the highest payload, the timeline must not be empty
+        uint64_t LastPayload() const { return use_map_ ? map_.rbegin()->first : ring_.back().first; }
+        const TimePoint &Last() const { return use_map_ ? map_.rbegin()->second : ring_.back().second; }
+
+        // Visit timepoints with payload >= first_payload in increasing order until fn returns true.
+        // Returns true if fn did.
+        template <typename Fn>
+        bool ForEachFrom(uint64_t first_payload, Fn &&fn) const;
+        // Visit timepoints in decreasing order until fn returns true.
+        template <typename Fn>
+        bool ForEachReverse(Fn &&fn) const;
+
+        // Remove timepoints with payload <= last_payload
+        void EraseUpTo(uint64_t last_payload);
+
+      private:
+        using Entry = std::pair<uint64_t, TimePoint>;
+        std::deque<Entry>::iterator RingLowerBound(uint64_t payload);
+        std::deque<Entry>::const_iterator RingLowerBound(uint64_t payload) const;
+
+        std::deque<Entry> ring_;
+        std::map<uint64_t, TimePoint> map_;
+        bool use_map_{false};
+    };
 
   private:
     enum Scope scope_ { kInternal };
@@ -183,8 +224,15 @@ class Semaphore : public RefcountedStateObject {
     // Set of pending operations ordered by payload.
     // Timeline operations can be added in any order and multiple wait operations
     // can use the same payload value.
-    std::map<uint64_t, TimePoint> timeline_;
+    Timeline timeline_;
     mutable std::shared_mutex lock_;
+
+    // completed_.payload, readable without lock_. WaitTimePoint() sleeps on wait_cond_ until it reaches the
+    // waited payload, retirement only takes wait_lock_ to notify when waiters_ is non-zero.
+    std::atomic<uint64_t> completed_payload_;
+    std::mutex wait_lock_;
+    std::condition_variable wait_cond_;
+    std::atomic<uint32_t> waiters_{0};
     DeviceState &dev_data_;
 
     // Not empty when semaphore was used in QueuePresent but has not been re-acquired yet
@@ -192,4 +240,40 @@ class Semaphore : public RefcountedStateObject {
     std::optional<SwapchainWaitInfo> swapchain_wait_info_;
 };
 
+template <typename Fn>
+bool Semaphore::Timeline::ForEachFrom(uint64_t first_payload, Fn &&fn) const {
+    if (use_map_) {
+        for (auto it = map_.lower_bound(first_payload); it != map_.end(); ++it) {
+            if (fn(it->first, it->second)) {
+                return true;
+            }
+        }
+    } else {
+        for (auto it = RingLowerBound(first_payload); it != ring_.end(); ++it) {
+            if (fn(it->first, it->second)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+template <typename Fn>
+bool Semaphore::Timeline::ForEachReverse(Fn &&fn) const {
+    if (use_map_) {
+        for (auto it = map_.rbegin(); it != map_.rend(); ++it) {
+            if (fn(it->first, it->second)) {
+                return true;
+            }
+        }
+    } else {
+        for (auto it = ring_.rbegin(); it != ring_.rend(); ++it) {
+            if (fn(it->first, it->second)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
 }  // namespace vvl
@@ -921,6 +921,8 @@ void DeviceState::DestroyObjectMaps() {
         entry.second->Destroy();
     }
     queue_map_.clear();
+    queue_retirement_pool.Shutdown();
+    validation_thread_pool.Shutdown();
 }
 
 void DeviceState::PreCallRecordDestroyDevice(VkDevice device, const VkAllocationCallbacks *pAllocator,
@@ -1689,7 +1691,7 @@ void DeviceState::PostCallRecordCreateFence(VkDevice device, const VkFenceCreate
                                             const VkAllocationCallbacks *pAllocator, VkFence *pFence,
                                             const RecordObject &record_obj) {
     if (VK_SUCCESS != record_obj.result) return;
-    Add(std::make_shared<Fence>(*this, *pFence, pCreateInfo));
+    Add(std::make_shared<Fence>(*pFence, pCreateInfo));
 }
 
 std::shared_ptr<PipelineCache> DeviceState::CreatePipelineCacheState(VkPipelineCache handle,
@@ -1951,11 +1953,16 @@ std::shared_ptr<DescriptorPool> DeviceState::CreateDescriptorPoolState(VkDescrip
 std::shared_ptr<DescriptorSet> DeviceState::CreateDescriptorSet(VkDescriptorSet handle, DescriptorPool *pool,
                                                                 const std::shared_ptr<DescriptorSetLayout const> &layout,
                                                                 uint32_t variable_count) {
+    if (pool) {
+        return std::allocate_shared<DescriptorSet>(pool->GetSetAllocator(), handle, pool, layout, variable_count, this);
+    }
     return std::make_shared<DescriptorSet>(handle, pool, layout, variable_count, this);
 }
 std::shared_ptr<vvl::DescriptorSet> DeviceState::CreatePushDescriptorSet(
     const std::shared_ptr<vvl::DescriptorSetLayout const> &layout) {
     auto ds = CreateDescriptorSet(VK_NULL_HANDLE, nullptr, layout, 0);
+    // Not in the state map, but still needs an id so cached validation of the previous push set isn't reused for it
+    ds->SetId(object_id_++);
     NotifyCreated(*ds);
     return ds;
 }
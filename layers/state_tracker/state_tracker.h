@@ -28,6 +28,8 @@
 #include "containers/custom_containers.h"
 #include "utils/android_ndk_types.h"
 #include "containers/range_map.h"
+#include "state_tracker/queue_retirement_pool.h"
+#include "utils/thread_pool.h"
 #include <vulkan/utility/vk_struct_helper.hpp>
 #include <atomic>
 #include <functional>
@@ -1983,6 +1985,11 @@ class DeviceState : public vvl::base::Device {
     vvl::unordered_map<VkShaderModuleIdentifierEXT, std::shared_ptr<vvl::ShaderModule>> shader_identifier_map_;
     mutable std::shared_mutex shader_identifier_map_lock_;
 
+    // Retires submissions for all queues of the device
+    vvl::QueueRetirementPool queue_retirement_pool;
+    // For validation work that can be split into independent parts (eg. per image at submit time)
+    vvl::ThreadPool validation_thread_pool;
+
     // If vkGetMemoryFdKHR is called, keep track of fd handle -> allocation info
     vvl::unordered_map<int, ExternalOpaqueInfo> fd_handle_map_;
     mutable std::shared_mutex fd_handle_map_lock_;
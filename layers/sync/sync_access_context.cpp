@@ -20,6 +20,10 @@
 #include "state_tracker/render_pass_state.h"
 #include "sync/sync_access_context.h"
 #include "sync/sync_image.h"
+#include "utils/thread_pool.h"
+
+#include <atomic>
+#include <limits>
 
 bool SimpleBinding(const vvl::Bindable &bindable) { return !bindable.sparse && bindable.Binding(); }
 VkDeviceSize ResourceBaseAddress(const vvl::Buffer &buffer) { return buffer.GetFakeBaseAddress(); }
@@ -28,6 +32,7 @@ class HazardDetector {
     const SyncAccessInfo &access_info_;
 
   public:
+    bool MaybeHazard(const ResourceAccessRangeMap::const_iterator &pos) const { return pos->second.HasHazard(access_info_); }
     HazardResult Detect(const ResourceAccessRangeMap::const_iterator &pos) const { return pos->second.DetectHazard(access_info_); }
     HazardResult DetectAsync(const ResourceAccessRangeMap::const_iterator &pos, ResourceUsageTag start_tag,
                              QueueId queue_id) const {
@@ -41,6 +46,10 @@ class HazardDetectorWithOrdering {
     const SyncOrdering ordering_rule_;
 
   public:
+    // Layout transitions are checked as barrier hazards, which the unordered pre-check doesn't cover
+    bool MaybeHazard(const ResourceAccessRangeMap::const_iterator &pos) const {
+        return (access_info_.access_index == SYNC_IMAGE_LAYOUT_TRANSITION) || pos->second.HasHazard(access_info_);
+    }
     HazardResult Detect(const ResourceAccessRangeMap::const_iterator &pos) const {
         return pos->second.DetectHazard(access_info_, ordering_rule_, kQueueIdInvalid);
     }
@@ -56,6 +65,7 @@ class HazardDetectFirstUse {
   public:
     HazardDetectFirstUse(const ResourceAccessState &recorded_use, QueueId queue_id, const ResourceUsageRange &tag_range)
         : recorded_use_(recorded_use), queue_id_(queue_id), tag_range_(tag_range) {}
+    bool MaybeHazard(const ResourceAccessRangeMap::const_iterator &) const { return true; }
     HazardResult Detect(const ResourceAccessRangeMap::const_iterator &pos) const {
         return pos->second.DetectHazard(recorded_use_, queue_id_, tag_range_);
     }
@@ -102,23 +112,23 @@ AccessContext::AccessContext(uint32_t subpass, VkQueueFlags queue_flags,
     }
 }
 
-template <typename NormalizeOp>
-void AccessContext::Trim(NormalizeOp &&normalize) {
-    ForAll(std::forward<NormalizeOp>(normalize));
-    sparse_container::consolidate(access_state_map_);
-}
-
 void AccessContext::Trim() {
-    auto normalize = [](ResourceAccessRangeMap::value_type &access) { access.second.Normalize(); };
-    Trim(normalize);
+    // Only write to the entries that change, so that segments shared with other contexts (eg. the previous batch this one
+    // was copied from, which is already trimmed) stay shared
+    auto &map = access_state_map_;
+    for (auto pos = map.cbegin(); pos != map.cend(); ++pos) {
+        if (!pos->second.IsNormalized()) {
+            auto mutable_pos = map.find(pos->first.begin);
+            mutable_pos->second.Normalize();
+            pos = mutable_pos;  // Writing may have copied the segment pos points to
+        }
+    }
+    sparse_container::consolidate(map);
 }
 
 void AccessContext::TrimAndClearFirstAccess() {
-    auto normalize = [](ResourceAccessRangeMap::value_type &access) {
-        access.second.Normalize();
-        access.second.ClearFirstUse();
-    };
-    Trim(normalize);
+    // Normalize() clears the first accesses
+    Trim();
 }
 
 void AccessContext::AddReferencedTags(ResourceUsageTagSet &used) const {
@@ -126,13 +136,6 @@ void AccessContext::AddReferencedTags(ResourceUsageTagSet &used) const {
     ConstForAll(gather);
 }
 
-template <typename Action>
-void AccessContext::ForAll(Action &&action) {
-    for (auto &access : access_state_map_) {
-        action(access);
-    }
-}
-
 template <typename Action>
 void AccessContext::ConstForAll(Action &&action) const {
     for (auto &access : access_state_map_) {
@@ -141,6 +144,11 @@ void AccessContext::ConstForAll(Action &&action) const {
 }
 
 void AccessContext::ResolveFromContext(const AccessContext &from) {
+    if (access_state_map_.empty() && from.prev_.empty()) {
+        // Nothing to resolve against, and nothing to pull from previous contexts to fill the gaps: it's a copy
+        access_state_map_ = from.access_state_map_;
+        return;
+    }
     const NoopBarrierAction noop_barrier;
     from.ResolveAccessRange(kFullRange, noop_barrier, &access_state_map_, nullptr);
 }
@@ -399,6 +407,7 @@ class BarrierHazardDetector {
           src_exec_scope_(src_exec_scope),
           src_access_scope_(src_access_scope) {}
 
+    bool MaybeHazard(const ResourceAccessRangeMap::const_iterator &) const { return true; }
     HazardResult Detect(const ResourceAccessRangeMap::const_iterator &pos) const {
         return pos->second.DetectBarrierHazard(access_info_, kQueueIdInvalid, src_exec_scope_, src_access_scope_);
     }
@@ -427,6 +436,7 @@ class EventBarrierHazardDetector {
           scope_pos_(event_scope.cbegin()),
           scope_end_(event_scope.cend()) {}
 
+    bool MaybeHazard(const ResourceAccessRangeMap::const_iterator &) const { return true; }
     HazardResult Detect(const ResourceAccessRangeMap::const_iterator &pos) {
         // Need to piece together coverage of pos->first range:
         // Copy the range as we'll be chopping it up as needed
@@ -536,15 +546,71 @@ void AccessContext::UpdateMemoryAccessStateFunctor::operator()(const ResourceAcc
     access_state.Update(usage_info, ordering_rule, tag_ex);
 }
 
-// This is called with the *recorded* command buffers access context, with the *active* access context pass in, againsts which
-// hazards will be detected
-HazardResult AccessContext::DetectFirstUseHazard(QueueId queue_id, const ResourceUsageRange &tag_range,
-                                                 const AccessContext &access_context) const {
-    for (const auto &recorded_access : access_state_map_) {
-        // Cull any entries not in the current tag range
-        if (!recorded_access.second.FirstAccessInTagRange(tag_range)) continue;
-        HazardDetectFirstUse detector(recorded_access.second, queue_id, tag_range);
-        HazardResult hazard = access_context.DetectHazardRange(detector, recorded_access.first, DetectOptions::kDetectAll);
+FirstUseSummary::FirstUseSummary(const AccessContext &recorded_context, const std::vector<ResourceUsageTag> &sync_op_tags) {
+    for (const auto &[range, access] : recorded_context.GetAccessStateMap()) {
+        const ResourceUsageRange first_tags = access.FirstAccessTagRange();
+        if (!first_tags.non_empty()) continue;
+        if (!entries_.empty()) {
+            Entry &last = entries_.back();
+            if (last.range.end == range.begin && last.recorded_use.SameFirstAccess(access)) {
+                last.range.end = range.end;
+                continue;
+            }
+        }
+        entries_.push_back({range, first_tags, access});
+    }
+
+    // The ranges ReplayState::ValidateFirstUse checks: the accesses before each sync op, and the sync op itself (layout
+    // transitions), then everything after the last sync op
+    ResourceUsageTag begin = 0;
+    for (const ResourceUsageTag tag : sync_op_tags) {
+        if (tag < begin) continue;  // Another sync op at the same tag, the ranges are the same
+        bucket_ranges_.emplace_back(begin, tag);
+        bucket_ranges_.emplace_back(tag, tag + 1);
+        begin = tag + 1;
+    }
+    bucket_ranges_.emplace_back(begin, std::numeric_limits<ResourceUsageTag>::max());
+
+    buckets_.resize(bucket_ranges_.size());
+    auto end_less = [](const ResourceUsageRange &bucket_range, ResourceUsageTag tag) { return bucket_range.end <= tag; };
+    for (uint32_t i = 0; i < entries_.size(); ++i) {
+        const ResourceUsageRange &first_tags = entries_[i].first_tags;
+        auto bucket = std::lower_bound(bucket_ranges_.begin(), bucket_ranges_.end(), first_tags.begin, end_less);
+        for (; bucket != bucket_ranges_.end() && bucket->begin < first_tags.end; ++bucket) {
+            if (bucket->non_empty()) {
+                buckets_[bucket - bucket_ranges_.begin()].push_back(i);
+            }
+        }
+    }
+}
+
+const FirstUseSummary::Bucket *FirstUseSummary::FindBucket(const ResourceUsageRange &tag_range) const {
+    auto begin_less = [](const ResourceUsageRange &bucket_range, ResourceUsageTag tag) { return bucket_range.begin < tag; };
+    auto bucket = std::lower_bound(bucket_ranges_.begin(), bucket_ranges_.end(), tag_range.begin, begin_less);
+    // A sync op right after the previous one (or at tag 0) gives an empty range with the same begin
+    for (; bucket != bucket_ranges_.end() && bucket->begin == tag_range.begin; ++bucket) {
+        if (bucket->end == tag_range.end) {
+            return &buckets_[bucket - bucket_ranges_.begin()];
+        }
+    }
+    return nullptr;
+}
+
+template <typename StopPredicate>
+HazardResult FirstUseSummary::DetectHazardInOrder(QueueId queue_id, const ResourceUsageRange &tag_range,
+                                                  const AccessContext &access_context, const uint32_t *first, const uint32_t *last,
+                                                  StopPredicate &&stop) const {
+    if (first == last) return {};
+
+    // Merge-join the entries with the access context map when possible, instead of a map search per entry
+    const bool in_address_order = access_context.CanDetectInAddressOrder();
+    auto pos = access_context.GetAccessStateMap().lower_bound(entries_[*first].range);
+    for (const uint32_t *index = first; index != last; ++index) {
+        if (stop()) break;
+        const Entry &entry = entries_[*index];
+        HazardDetectFirstUse detector(entry.recorded_use, queue_id, tag_range);
+        HazardResult hazard = in_address_order ? access_context.DetectHazardNextRange(detector, entry.range, pos)
+                                               : access_context.DetectHazardRange(detector, entry.range, DetectOptions::kDetectAll);
         if (hazard.IsHazard()) {
             return hazard;
         }
@@ -552,6 +618,54 @@ HazardResult AccessContext::DetectFirstUseHazard(QueueId queue_id, const Resourc
     return {};
 }
 
+// The summary is for the *recorded* command buffers access context, and the *active* access context is passed in, againsts
+// which hazards will be detected
+HazardResult FirstUseSummary::DetectHazard(QueueId queue_id, const ResourceUsageRange &tag_range,
+                                           const AccessContext &access_context, vvl::ThreadPool *thread_pool) const {
+    // Below this many entries to check the serial scan is faster than waking up the workers
+    constexpr size_t kParallelThreshold = 256;
+    constexpr size_t kSliceSize = 64;
+
+    const Bucket *bucket = FindBucket(tag_range);
+    Bucket culled;
+    if (!bucket) {
+        // Not one of the ranges the buckets were made for, cull any entries not in the tag range
+        for (uint32_t i = 0; i < entries_.size(); ++i) {
+            if (tag_range.intersects(entries_[i].first_tags)) {
+                culled.push_back(i);
+            }
+        }
+        bucket = &culled;
+    }
+    const uint32_t *indices = bucket->data();
+    const size_t count = bucket->size();
+
+    if (!thread_pool || count < kParallelThreshold) {
+        return DetectHazardInOrder(queue_id, tag_range, access_context, indices, indices + count, []() { return false; });
+    }
+
+    // Detection only reads the batch context, so the slices are independent. Each slice stops at its first hazard, and
+    // slices past one that already found a hazard are skipped, as their result can't be the one reported.
+    const size_t slice_count = (count + kSliceSize - 1) / kSliceSize;
+    std::vector<HazardResult> slice_hazards(slice_count);
+    std::atomic<size_t> first_hazard_slice{slice_count};
+    thread_pool->ParallelFor(slice_count, [&](size_t slice) {
+        const size_t end = std::min((slice + 1) * kSliceSize, count);
+        auto stop = [&first_hazard_slice, slice]() { return first_hazard_slice.load(std::memory_order_relaxed) < slice; };
+        HazardResult hazard =
+            DetectHazardInOrder(queue_id, tag_range, access_context, indices + slice * kSliceSize, indices + end, stop);
+        if (hazard.IsHazard()) {
+            slice_hazards[slice] = std::move(hazard);
+            size_t current = first_hazard_slice.load(std::memory_order_relaxed);
+            while (slice < current && !first_hazard_slice.compare_exchange_weak(current, slice)) {
+            }
+        }
+    });
+
+    const size_t hazard_slice = first_hazard_slice.load();
+    return hazard_slice < slice_count ? std::move(slice_hazards[hazard_slice]) : HazardResult();
+}
+
 // For RenderPass time validation this is "start tag", for QueueSubmit, this is the earliest
 // unsynchronized tag for the Queue being tested against (max synchrononous + 1, perhaps)
 ResourceUsageTag AccessContext::AsyncReference::StartTag() const { return (tag_ == kInvalidTag) ? context_->StartTag() : tag_; }
@@ -19,6 +19,7 @@
 
 #include "sync/sync_common.h"
 #include "sync/sync_access_state.h"
+#include "sync/sync_stats.h"
 
 struct SubpassDependencyGraphNode;
 
@@ -30,6 +31,7 @@ class Image;
 class ImageView;
 class VideoPictureResource;
 class VideoSession;
+class ThreadPool;
 }  // namespace vvl
 
 bool SimpleBinding(const vvl::Bindable &bindable);
@@ -279,8 +281,16 @@ class AccessContext {
                                           DetectOptions options) const;
     HazardResult DetectSubpassTransitionHazard(const TrackBack &track_back, const AttachmentViewGen &attach_view) const;
 
-    HazardResult DetectFirstUseHazard(QueueId queue_id, const ResourceUsageRange &tag_range,
-                                      const AccessContext &access_context) const;
+    template <typename Detector>
+    HazardResult DetectHazardRange(Detector &detector, const ResourceAccessRange &range, DetectOptions options) const;
+    // Ranges checked one after the other in increasing address order can share the walk of the map (see DetectHazardNextRange)
+    // when there are no previous or async contexts to look into
+    bool CanDetectInAddressOrder() const { return prev_.empty() && async_.empty(); }
+    // Same result as DetectHazardRange with kDetectAll, for a sequence of increasing, non overlapping ranges. pos carries the
+    // position in the map from one range to the next, it must start at the lower bound of the first range.
+    template <typename Detector>
+    HazardResult DetectHazardNextRange(Detector &detector, const ResourceAccessRange &range,
+                                       ResourceAccessRangeMap::const_iterator &pos) const;
 
     const TrackBack &GetDstExternalTrackBack() const { return dst_external_; }
     void Reset() {
@@ -335,6 +345,7 @@ class AccessContext {
                   const std::vector<AccessContext> &contexts, const AccessContext *external_context);
 
     AccessContext() { Reset(); }
+    // Cheap when the access maps are segmented, the copy shares the segments with copy_from until either one changes them
     AccessContext(const AccessContext &copy_from) = default;
     void Trim();
     void TrimAndClearFirstAccess();
@@ -354,8 +365,6 @@ class AccessContext {
     void SetStartTag(ResourceUsageTag tag) { start_tag_ = tag; }
     ResourceUsageTag StartTag() const { return start_tag_; }
 
-    template <typename Action>
-    void ForAll(Action &&action);
     template <typename Action>
     void ConstForAll(Action &&action) const;
     template <typename Predicate>
@@ -414,8 +423,6 @@ class AccessContext {
     void ResolveAccessRange(const ResourceAccessRange &range, BarrierAction &barrier_action, ResourceAccessRangeMap *resolve_map,
                             const ResourceAccessState *infill_state, bool recur_to_infill = true) const;
 
-    template <typename Detector>
-    HazardResult DetectHazardRange(Detector &detector, const ResourceAccessRange &range, DetectOptions options) const;
     template <typename Detector, typename RangeGen>
     HazardResult DetectHazardGeneratedRanges(Detector &detector, RangeGen &range_gen, DetectOptions options) const;
     template <typename Detector, typename RangeGen>
@@ -443,9 +450,6 @@ class AccessContext {
     HazardResult DetectAsyncHazard(const Detector &detector, const RangeGen &const_range_gen, ResourceUsageTag async_tag,
                                    QueueId async_queue_id) const;
 
-    template <typename NormalizeOp>
-    void Trim(NormalizeOp &&normalize);
-
     template <typename Detector>
     HazardResult DetectPreviousHazard(Detector &detector, const ResourceAccessRange &range) const;
 
@@ -459,6 +463,42 @@ class AccessContext {
     ResourceUsageTag start_tag_;
 };
 
+// The first accesses of a recorded context, in the form submit time validation needs them.
+//
+// Entries without first accesses are dropped, and adjacent entries with the same first accesses are merged. The entries are
+// also bucketed by the tag ranges ReplayState validates (between and at the sync ops of the command buffer), so that each
+// range only checks the entries with first accesses in it. The recorded contexts don't change once the command buffer is
+// executable, so the summary is built once and reused by all the submits of the command buffer.
+class FirstUseSummary {
+  public:
+    FirstUseSummary(const AccessContext &recorded_context, const std::vector<ResourceUsageTag> &sync_op_tags);
+
+    // With a thread pool, large sets of entries are split into address ordered slices that are checked concurrently.
+    // The hazard reported is the same one the serial scan would find (the lowest address one).
+    HazardResult DetectHazard(QueueId queue_id, const ResourceUsageRange &tag_range, const AccessContext &access_context,
+                              vvl::ThreadPool *thread_pool = nullptr) const;
+
+    size_t EntryCount() const { return entries_.size(); }
+
+  private:
+    struct Entry {
+        ResourceAccessRange range;
+        ResourceUsageRange first_tags;
+        ResourceAccessState recorded_use;
+    };
+    using Bucket = std::vector<uint32_t>;
+
+    // nullptr when tag_range isn't one of the bucket ranges
+    const Bucket *FindBucket(const ResourceUsageRange &tag_range) const;
+    template <typename StopPredicate>
+    HazardResult DetectHazardInOrder(QueueId queue_id, const ResourceUsageRange &tag_range, const AccessContext &access_context,
+                                     const uint32_t *first, const uint32_t *last, StopPredicate &&stop) const;
+
+    std::vector<Entry> entries_;
+    std::vector<ResourceUsageRange> bucket_ranges_;  // Sorted by begin
+    std::vector<Bucket> buckets_;                    // Indices into entries_, in address order
+};
+
 // The semantics of the InfillUpdateOps of infill_update_range are slightly different than for the UpdateMemoryAccessState Action
 // operations, as this simplifies the generic traversal.  So we wrap them in a semantics Adapter to get the same effect.
 template <typename Action>
@@ -559,8 +599,11 @@ HazardResult AccessContext::DetectHazardOneRange(Detector &detector, bool detect
             gap.begin = pos->first.end;
         }
 
-        hazard = detector.Detect(pos);
-        if (hazard.IsHazard()) return hazard;
+        // Most entries are clean, don't build a HazardResult for those
+        if (detector.MaybeHazard(pos)) {
+            hazard = detector.Detect(pos);
+            if (hazard.IsHazard()) return hazard;
+        }
         ++pos;
     }
 
@@ -575,6 +618,30 @@ HazardResult AccessContext::DetectHazardOneRange(Detector &detector, bool detect
     return hazard;
 }
 
+template <typename Detector>
+HazardResult AccessContext::DetectHazardNextRange(Detector &detector, const ResourceAccessRange &range,
+                                                  ResourceAccessRangeMap::const_iterator &pos) const {
+    assert(CanDetectInAddressOrder());
+    syncval_stats::Stats::AddHazardCheck();
+    const auto the_end = access_state_map_.cend();
+    // The last entry looked at for the previous range can extend into this one
+    if (pos != access_state_map_.cbegin()) {
+        auto prev = pos;
+        --prev;
+        if (prev->first.end > range.begin) {
+            pos = prev;
+        }
+    }
+    if (pos != the_end && pos->first.end <= range.begin) {
+        // Step to the next entry, and search when the ranges are further apart
+        ++pos;
+        if (pos != the_end && pos->first.end <= range.begin) {
+            pos = access_state_map_.lower_bound(range);
+        }
+    }
+    return DetectHazardOneRange(detector, false, pos, the_end, range);
+}
+
 template <typename Detector>
 HazardResult AccessContext::DetectHazardRange(Detector &detector, const ResourceAccessRange &range, DetectOptions options) const {
     SingleRangeGenerator range_gen(range);
@@ -649,6 +716,7 @@ void AccessContext::ResolveAccessRange(const ResourceAccessRange &range, Barrier
 // the DAG of the contexts (for example subpasses)
 template <typename Detector, typename RangeGen>
 HazardResult AccessContext::DetectHazardGeneratedRanges(Detector &detector, RangeGen &range_gen, DetectOptions options) const {
+    syncval_stats::Stats::AddHazardCheck();
     HazardResult hazard;
 
     // Do this before range_gen is incremented s.t. the copies used will be correct
@@ -682,6 +750,7 @@ HazardResult AccessContext::DetectPreviousHazard(Detector &detector, const Resou
     ResolvePreviousAccess(range, &descent_map, nullptr);
 
     for (auto prev = descent_map.begin(); prev != descent_map.end(); ++prev) {
+        if (!detector.MaybeHazard(prev)) continue;
         HazardResult hazard = detector.Detect(prev);
         if (hazard.IsHazard()) {
             return hazard;
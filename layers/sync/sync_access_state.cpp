@@ -17,12 +17,38 @@
 #include "sync/sync_utils.h"
 #include "sync/sync_access_state.h"
 #include <vulkan/utility/vk_struct_helper.hpp>
+#include <atomic>
 
 ResourceAccessState::OrderingBarriers ResourceAccessState::kOrderingRules = {
     {{VK_PIPELINE_STAGE_2_NONE, SyncAccessFlags()},
      {kColorAttachmentExecScope, kColorAttachmentAccessScope},
      {kDepthStencilAttachmentExecScope, kDepthStencilAttachmentAccessScope},
      {kRasterAttachmentExecScope, kRasterAttachmentAccessScope}}};
+const ResourceAccessState::FirstAccessState ResourceAccessState::kEmptyFirstAccess{};
+
+ResourceAccessState::FirstAccessState &ResourceAccessState::MutableFirstAccess() {
+    if (!first_access_) {
+        first_access_ = std::make_shared<FirstAccessState>();
+    } else if (first_access_.use_count() > 1) {
+        // Shared with other entries (split from the same range), they keep the old copy
+        first_access_ = std::make_shared<FirstAccessState>(*first_access_);
+    } else {
+        // The last other owner may have been released by another thread, use_count() is a relaxed load so order with it
+        // before writing in place
+        std::atomic_thread_fence(std::memory_order_acquire);
+    }
+    return *first_access_;
+}
+
+bool ResourceAccessState::SameFirstAccess(const ResourceAccessState &rhs) const {
+    if (first_access_ == rhs.first_access_) {
+        return true;
+    }
+    const FirstAccessState &lhs_first = FirstAccess();
+    const FirstAccessState &rhs_first = rhs.FirstAccess();
+    return (lhs_first.accesses == rhs_first.accesses) && (lhs_first.read_stages == rhs_first.read_stages) &&
+           (lhs_first.write_layout_ordering == rhs_first.write_layout_ordering);
+}
 
 // Apply a list of barriers, without resolving pending state, useful for subpass layout transitions
 void ResourceAccessState::ApplyBarriers(const std::vector<SyncBarrier> &barriers, bool layout_transition) {
@@ -148,11 +174,12 @@ HazardResult ResourceAccessState::DetectHazard(const ResourceAccessState &record
                                                const ResourceUsageRange &tag_range) const {
     HazardResult hazard;
     using Size = FirstAccesses::size_type;
-    const auto &recorded_accesses = recorded_use.first_accesses_;
+    const FirstAccessState &recorded_first = recorded_use.FirstAccess();
+    const auto &recorded_accesses = recorded_first.accesses;
     Size count = recorded_accesses.size();
     if (count) {
         // First access is only closed if the last is a write
-        bool do_write_last = recorded_use.first_access_closed_;
+        bool do_write_last = recorded_first.closed;
         if (do_write_last) {
             // Note: We know count > 0 so this is alway safe.
             --count;
@@ -183,16 +210,16 @@ HazardResult ResourceAccessState::DetectHazard(const ResourceAccessState &record
                     // Or in the layout first access scope as a barrier... IFF the usage is an ILT
                     // this was saved off in the "apply barriers" logic to simplify ILT access checks as they straddle
                     // the barrier that applies them
-                    barrier |= recorded_use.first_write_layout_ordering_;
+                    barrier |= recorded_first.write_layout_ordering;
                 }
                 // Any read stages present in the recorded context (this) are most recent to the write, and thus mask those stages
                 // in the active context
-                if (recorded_use.first_read_stages_) {
+                if (recorded_first.read_stages) {
                     // we need to ignore the first use read stage in the active context (so we add them to the ordering rule),
                     // reads in the active context are not "most recent" as all recorded context operations are *after* them
                     // This supresses only RAW checks for stages present in the recorded context, but not those only present in the
                     // active context.
-                    barrier.exec_scope |= recorded_use.first_read_stages_;
+                    barrier.exec_scope |= recorded_first.read_stages;
                     // if there are any first use reads, we suppress WAW by injecting the active context write in the ordering rule
                     barrier.access_scope |= last_access.usage_info->access_bit;
                 }
@@ -233,7 +260,7 @@ HazardResult ResourceAccessState::DetectAsyncHazard(const SyncAccessInfo &usage_
 
 HazardResult ResourceAccessState::DetectAsyncHazard(const ResourceAccessState &recorded_use, const ResourceUsageRange &tag_range,
                                                     ResourceUsageTag start_tag, QueueId queue_id) const {
-    for (const auto &first : recorded_use.first_accesses_) {
+    for (const auto &first : recorded_use.FirstAccess().accesses) {
         // Skip and quit logic
         if (first.tag < tag_range.begin) continue;
         if (first.tag >= tag_range.end) break;
@@ -423,12 +450,16 @@ void ResourceAccessState::Resolve(const ResourceAccessState &other) {
     // of the copy and other into this using the update first logic.
     // NOTE: All sorts of additional cleverness could be put into short circuts.  (for example back is write and is before front
     //       of the other first_accesses... )
-    if (!skip_first && !(first_accesses_ == other.first_accesses_) && !other.first_accesses_.empty()) {
-        FirstAccesses firsts(std::move(first_accesses_));
+    const FirstAccesses &other_firsts = other.FirstAccess().accesses;
+    if (!skip_first && (first_access_ != other.first_access_) && !(FirstAccess().accesses == other_firsts) &&
+        !other_firsts.empty()) {
+        // Keep our old first use state alive (it may also be other's) while rebuilding it
+        const std::shared_ptr<FirstAccessState> old_first = std::move(first_access_);
         ClearFirstUse();
+        const FirstAccesses &firsts = old_first ? old_first->accesses : kEmptyFirstAccess.accesses;
         auto a = firsts.begin();
         auto a_end = firsts.end();
-        for (auto &b : other.first_accesses_) {
+        for (auto &b : other_firsts) {
             // TODO: Determine whether some tag offset will be needed for PHASE II
             while ((a != a_end) && (a->tag < b.tag)) {
                 UpdateFirst(a->TagEx(), *a->usage_info, a->ordering_rule);
@@ -537,12 +568,7 @@ void ResourceAccessState::ClearRead() {
     input_attachment_read = false;  // Denotes no outstanding input attachment read after the last write.
 }
 
-void ResourceAccessState::ClearFirstUse() {
-    first_accesses_.clear();
-    first_read_stages_ = VK_PIPELINE_STAGE_2_NONE;
-    first_write_layout_ordering_ = OrderingBarrier();
-    first_access_closed_ = false;
-}
+void ResourceAccessState::ClearFirstUse() { first_access_.reset(); }
 
 void ResourceAccessState::ApplyPendingBarriers(const ResourceUsageTag tag) {
     if (pending_layout_transition) {
@@ -629,9 +655,14 @@ bool ResourceAccessState::WaitAcquirePredicate::operator()(const ResourceAccessS
 }
 
 bool ResourceAccessState::FirstAccessInTagRange(const ResourceUsageRange &tag_range) const {
-    if (!first_accesses_.size()) return false;
-    const ResourceUsageRange first_access_range = {first_accesses_.front().tag, first_accesses_.back().tag + 1};
-    return tag_range.intersects(first_access_range);
+    const ResourceUsageRange first_access_range = FirstAccessTagRange();
+    return first_access_range.non_empty() && tag_range.intersects(first_access_range);
+}
+
+ResourceUsageRange ResourceAccessState::FirstAccessTagRange() const {
+    const FirstAccesses &first_accesses = FirstAccess().accesses;
+    if (!first_accesses.size()) return {};
+    return {first_accesses.front().tag, first_accesses.back().tag + 1};
 }
 
 void ResourceAccessState::OffsetTag(ResourceUsageTag offset) {
@@ -639,8 +670,10 @@ void ResourceAccessState::OffsetTag(ResourceUsageTag offset) {
     for (auto &read_access : last_reads) {
         read_access.tag += offset;
     }
-    for (auto &first : first_accesses_) {
-        first.tag += offset;
+    if (!FirstAccess().accesses.empty()) {
+        for (auto &first : MutableFirstAccess().accesses) {
+            first.tag += offset;
+        }
     }
 }
 
@@ -652,10 +685,7 @@ ResourceAccessState::ResourceAccessState()
       last_reads(),
       input_attachment_read(false),
       pending_layout_transition(false),
-      first_accesses_(),
-      first_read_stages_(VK_PIPELINE_STAGE_2_NONE),
-      first_write_layout_ordering_(),
-      first_access_closed_(false) {}
+      first_access_() {}
 
 VkPipelineStageFlags2 ResourceAccessState::GetReadBarriers(SyncAccessIndex access_index) const {
     for (const auto &read_access : last_reads) {
@@ -702,6 +732,8 @@ void ResourceAccessState::Normalize() {
     ClearFirstUse();
 }
 
+bool ResourceAccessState::IsNormalized() const { return !first_access_ && std::is_sorted(last_reads.begin(), last_reads.end()); }
+
 void ResourceAccessState::GatherReferencedTags(ResourceUsageTagSet &used) const {
     if (last_write.has_value()) {
         used.CachedInsert(last_write->Tag());
@@ -712,17 +744,6 @@ void ResourceAccessState::GatherReferencedTags(ResourceUsageTagSet &used) const
     }
 }
 
-bool ResourceAccessState::IsRAWHazard(const SyncAccessInfo &usage_info) const {
-    assert(IsRead(usage_info));
-    // Only RAW vs. last_write if it doesn't happen-after any other read because either:
-    //    * the previous reads are not hazards, and thus last_write must be visible and available to
-    //      any reads that happen after.
-    //    * the previous reads *are* hazards to last_write, have been reported, and if that hazard is fixed
-    //      the current read will be also not be a hazard, thus reporting a hazard here adds no needed information.
-    return last_write.has_value() && (0 == (read_execution_barriers & usage_info.stage_mask)) &&
-           last_write->IsWriteHazard(usage_info);
-}
-
 VkPipelineStageFlags2 ResourceAccessState::GetOrderedStages(QueueId queue_id, const OrderingBarrier &ordering) const {
     // At apply queue submission order limits on the effect of ordering
     VkPipelineStageFlags2 non_qso_stages = VK_PIPELINE_STAGE_2_NONE;
@@ -749,17 +770,19 @@ VkPipelineStageFlags2 ResourceAccessState::GetOrderedStages(QueueId queue_id, co
 void ResourceAccessState::UpdateFirst(const ResourceUsageTagEx tag_ex, const SyncAccessInfo &usage_info,
                                       SyncOrdering ordering_rule) {
     // Only record until we record a write.
-    if (!first_access_closed_) {
+    const FirstAccessState &first = FirstAccess();
+    if (!first.closed) {
         const bool is_read = IsRead(usage_info);
         const VkPipelineStageFlags2 usage_stage = is_read ? usage_info.stage_mask : 0U;
-        if (0 == (usage_stage & first_read_stages_)) {
+        if (0 == (usage_stage & first.read_stages)) {
             // If this is a read we haven't seen or a write, record.
             // We always need to know what stages were found prior to write
-            first_read_stages_ |= usage_stage;
+            FirstAccessState &mutable_first = MutableFirstAccess();
+            mutable_first.read_stages |= usage_stage;
             if (0 == (read_execution_barriers & usage_stage)) {
                 // If this stage isn't masked then we add it (since writes map to usage_stage 0, this also records writes)
-                first_accesses_.emplace_back(usage_info, tag_ex, ordering_rule);
-                first_access_closed_ = !is_read;
+                mutable_first.accesses.emplace_back(usage_info, tag_ex, ordering_rule);
+                mutable_first.closed = !is_read;
             }
         }
     }
@@ -767,11 +790,12 @@ void ResourceAccessState::UpdateFirst(const ResourceUsageTagEx tag_ex, const Syn
 
 void ResourceAccessState::TouchupFirstForLayoutTransition(ResourceUsageTag tag, const OrderingBarrier &layout_ordering) {
     // Only call this after recording an image layout transition
-    assert(first_accesses_.size());
-    if (first_accesses_.back().tag == tag) {
+    const FirstAccesses &first_accesses = FirstAccess().accesses;
+    assert(first_accesses.size());
+    if (first_accesses.back().tag == tag) {
         // If this layout transition is the the first write, add the additional ordering rules that guard the ILT
-        assert(first_accesses_.back().usage_info->access_index == SyncAccessIndex::SYNC_IMAGE_LAYOUT_TRANSITION);
-        first_write_layout_ordering_ = layout_ordering;
+        assert(first_accesses.back().usage_info->access_index == SyncAccessIndex::SYNC_IMAGE_LAYOUT_TRANSITION);
+        MutableFirstAccess().write_layout_ordering = layout_ordering;
     }
 }
 
@@ -816,8 +840,6 @@ WriteState::WriteState(const SyncAccessInfo &usage_info, ResourceUsageTagEx tag_
       pending_dep_chain_(VK_PIPELINE_STAGE_2_NONE),
       pending_barriers_() {}
 
-bool WriteState::IsWriteHazard(const SyncAccessInfo &usage_info) const { return !barriers_[usage_info.access_index]; }
-
 bool WriteState::IsOrdered(const OrderingBarrier &ordering, QueueId queue_id) const {
     assert(access_);
     return (queue_ == queue_id) && ordering.access_scope[access_->access_index];
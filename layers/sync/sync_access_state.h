@@ -17,6 +17,14 @@
 
 #pragma once
 #include "sync/sync_common.h"
+#include "containers/node_pool_allocator.h"
+#include "containers/segmented_map.h"
+
+// Store the access maps in two levels, segments of the fake address space each with their own map (see segmented_map).
+// Segments are copied on write, which keeps the many access context copies (queue batches, event and barrier snapshots) cheap.
+#ifndef VVL_SYNCVAL_SEGMENTED_ACCESS_MAPS
+#define VVL_SYNCVAL_SEGMENTED_ACCESS_MAPS 1
+#endif
 
 class ResourceAccessState;
 class WriteState;
@@ -308,7 +316,7 @@ class WriteState {
     const SyncAccessFlags &Barriers() const { return barriers_; }
     ResourceUsageTag Tag() const { return tag_; }
     ResourceUsageTagEx TagEx() const { return {tag_, handle_index_}; }
-    bool IsWriteHazard(const SyncAccessInfo &usage_info) const;
+    bool IsWriteHazard(const SyncAccessInfo &usage_info) const { return !barriers_[usage_info.access_index]; }
     bool IsOrdered(const OrderingBarrier &ordering, QueueId queue_id) const;
 
     bool IsWriteBarrierHazard(QueueId queue_id, VkPipelineStageFlags2 src_exec_scope,
@@ -347,8 +355,34 @@ class ResourceAccessState : public SyncStageAccess {
     using OrderingBarriers = std::array<OrderingBarrier, static_cast<size_t>(SyncOrdering::kNumOrderings)>;
     using FirstAccesses = small_vector<ResourceFirstAccess, 3>;
 
+    // First use information, only needed by command buffer contexts (it is cleared once recorded accesses are resolved into
+    // a queue batch). Kept out of line and shared between the entries a range split creates, copied on write.
+    struct FirstAccessState {
+        FirstAccesses accesses;
+        VkPipelineStageFlags2 read_stages = VK_PIPELINE_STAGE_2_NONE;
+        OrderingBarrier write_layout_ordering{};
+        bool closed = false;
+    };
+
   public:
     HazardResult DetectHazard(const SyncAccessInfo &usage_info) const;
+    // Yes/no version of DetectHazard(usage_info) for scanning many entries, only build the HazardResult for the ones that
+    // return true. Also a superset of the ordered DetectHazard for anything but layout transitions (ordering only removes
+    // hazards). Must be kept in sync with DetectHazard.
+    bool HasHazard(const SyncAccessInfo &usage_info) const {
+        if (IsRead(usage_info)) {
+            return IsRAWHazard(usage_info);
+        }
+        if (!last_reads.empty()) {
+            for (const auto &read_access : last_reads) {
+                if (IsReadHazard(usage_info.stage_mask, read_access)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+        return last_write.has_value() && last_write->IsWriteHazard(usage_info);
+    }
     HazardResult DetectHazard(const SyncAccessInfo &usage_info, SyncOrdering ordering_rule, QueueId queue_id) const;
     HazardResult DetectHazard(const SyncAccessInfo &usage_info, const OrderingBarrier &ordering, QueueId queue_id) const;
     HazardResult DetectHazard(const ResourceAccessState &recorded_use, QueueId queue_id, const ResourceUsageRange &tag_range) const;
@@ -404,6 +438,9 @@ class ResourceAccessState : public SyncStageAccess {
     bool ApplyPredicatedWait(Predicate &predicate);
 
     bool FirstAccessInTagRange(const ResourceUsageRange &tag_range) const;
+    // Tags from the first to the last first access, empty when there are none
+    ResourceUsageRange FirstAccessTagRange() const;
+    bool SameFirstAccess(const ResourceAccessState &rhs) const;
 
     void OffsetTag(ResourceUsageTag offset);
     ResourceAccessState();
@@ -419,11 +456,7 @@ class ResourceAccessState : public SyncStageAccess {
 
         const bool read_write_same = write_same && (last_read_stages == rhs.last_read_stages) && (last_reads == rhs.last_reads);
 
-        const bool same = read_write_same && (first_accesses_ == rhs.first_accesses_) &&
-                          (first_read_stages_ == rhs.first_read_stages_) &&
-                          (first_write_layout_ordering_ == rhs.first_write_layout_ordering_);
-
-        return same;
+        return read_write_same && SameFirstAccess(rhs);
     }
     bool operator!=(const ResourceAccessState &rhs) const { return !(*this == rhs); }
     VkPipelineStageFlags2 GetReadBarriers(SyncAccessIndex access_index) const;
@@ -471,11 +504,22 @@ class ResourceAccessState : public SyncStageAccess {
     };
 
     void Normalize();
+    // True when Normalize() would not change anything
+    bool IsNormalized() const;
     void GatherReferencedTags(ResourceUsageTagSet &used) const;
 
   private:
     static constexpr VkPipelineStageFlags2 kInvalidAttachmentStage = ~VkPipelineStageFlags2(0);
-    bool IsRAWHazard(const SyncAccessInfo &usage_info) const;
+    bool IsRAWHazard(const SyncAccessInfo &usage_info) const {
+        assert(IsRead(usage_info));
+        // Only RAW vs. last_write if it doesn't happen-after any other read because either:
+        //    * the previous reads are not hazards, and thus last_write must be visible and available to
+        //      any reads that happen after.
+        //    * the previous reads *are* hazards to last_write, have been reported, and if that hazard is fixed
+        //      the current read will be also not be a hazard, thus reporting a hazard here adds no needed information.
+        return last_write.has_value() && (0 == (read_execution_barriers & usage_info.stage_mask)) &&
+               last_write->IsWriteHazard(usage_info);
+    }
 
     bool WriteInScope(const SyncAccessFlags &src_access_scope) const;
     // Apply ordering scope to write hazard detection
@@ -502,6 +546,9 @@ class ResourceAccessState : public SyncStageAccess {
         return kOrderingRules[static_cast<size_t>(ordering_enum)];
     }
 
+    const FirstAccessState &FirstAccess() const { return first_access_ ? *first_access_ : kEmptyFirstAccess; }
+    FirstAccessState &MutableFirstAccess();
+
     // TODO: Add a NONE (zero) enum to SyncStageAccessFlags for input_attachment_read and last_write
 
     // With reads, each must be "safe" relative to it's prior write, so we need only
@@ -514,7 +561,8 @@ class ResourceAccessState : public SyncStageAccess {
 
     VkPipelineStageFlags2 last_read_stages;
     VkPipelineStageFlags2 read_execution_barriers;
-    using ReadStates = small_vector<ReadState, 3, uint32_t>;
+    // Most entries have at most one outstanding read, more than that go to the heap
+    using ReadStates = small_vector<ReadState, 1, uint32_t>;
     ReadStates last_reads;
 
     // TODO Input Attachment cleanup for multiple reads in a given stage
@@ -526,15 +574,28 @@ class ResourceAccessState : public SyncStageAccess {
     bool pending_layout_transition;
     uint32_t pending_layout_transition_handle_index = vvl::kNoIndex32;
 
-    FirstAccesses first_accesses_;
-    VkPipelineStageFlags2 first_read_stages_;
-    OrderingBarrier first_write_layout_ordering_;
-    bool first_access_closed_;
+    // null when there is no first use information
+    std::shared_ptr<FirstAccessState> first_access_;
 
     static OrderingBarriers kOrderingRules;
+    static const FirstAccessState kEmptyFirstAccess;
 };
 using ResourceAccessStateFunction = std::function<void(ResourceAccessState *)>;
-using ResourceAccessRangeMap = sparse_container::range_map<ResourceAddress, ResourceAccessState>;
+// Access maps are split, infilled and merged constantly, so their nodes come from a pool owned by each map
+using ResourceAccessRangeSegmentMap =
+    std::map<ResourceAccessRange, ResourceAccessState, std::less<ResourceAccessRange>,
+             vvl::node_pool_allocator<std::pair<const ResourceAccessRange, ResourceAccessState>>>;
+#if VVL_SYNCVAL_SEGMENTED_ACCESS_MAPS != 0
+// Resources get disjoint fake address ranges and small ones are mostly sub-allocated together, so a 4MB segment usually
+// holds a handful of resources
+constexpr unsigned kAccessMapSegmentShift = 22;
+using ResourceAccessRangeMapImpl = sparse_container::segmented_map<ResourceAccessRange, ResourceAccessState,
+                                                                   kAccessMapSegmentShift, ResourceAccessRangeSegmentMap>;
+#else
+using ResourceAccessRangeMapImpl = ResourceAccessRangeSegmentMap;
+#endif
+using ResourceAccessRangeMap =
+    sparse_container::range_map<ResourceAddress, ResourceAccessState, ResourceAccessRange, ResourceAccessRangeMapImpl>;
 using ResourceRangeMergeIterator = sparse_container::parallel_iterator<ResourceAccessRangeMap, const ResourceAccessRangeMap>;
 
 // Apply the memory barrier without updating the existing barriers.  The execution barrier
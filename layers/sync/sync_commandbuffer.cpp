@@ -100,6 +100,7 @@ CommandBufferAccessContext::CommandBufferAccessContext(const CommandBufferAccess
     // Copy only the needed fields out of from for a temporary, proxy command buffer context
     cb_state_ = from.cb_state_;
     access_log_ = std::make_shared<AccessLog>(*from.access_log_);  // potentially large, but no choice given tagging lookup.
+    sync_state_.stats.AddAccessLogRecord(access_log_->size());
     command_number_ = from.command_number_;
     reset_count_ = from.reset_count_;
 
@@ -123,9 +124,11 @@ CommandBufferAccessContext::CommandBufferAccessContext(const CommandBufferAccess
 CommandBufferAccessContext::~CommandBufferAccessContext() {
     sync_state_.stats.RemoveCommandBufferContext();
     sync_state_.stats.RemoveHandleRecord((uint32_t)handles_.size());
+    sync_state_.stats.RemoveAccessLogRecord(access_log_->size());
 }
 
 void CommandBufferAccessContext::Reset() {
+    sync_state_.stats.RemoveAccessLogRecord(access_log_->size());
     access_log_ = std::make_shared<AccessLog>();
     cbs_referenced_ = std::make_shared<CommandBufferSet>();
     if (cb_state_) {
@@ -145,6 +148,25 @@ void CommandBufferAccessContext::Reset() {
     current_renderpass_context_ = nullptr;
     events_context_.Clear();
     dynamic_rendering_info_.reset();
+
+    std::lock_guard<std::mutex> guard(first_use_summaries_lock_);
+    first_use_summaries_.clear();
+}
+
+const FirstUseSummary &CommandBufferAccessContext::GetFirstUseSummary(const AccessContext &recorded_context) const {
+    std::lock_guard<std::mutex> guard(first_use_summaries_lock_);
+    for (const auto &[context, summary] : first_use_summaries_) {
+        if (context == &recorded_context) {
+            return *summary;
+        }
+    }
+    std::vector<ResourceUsageTag> sync_op_tags;
+    sync_op_tags.reserve(sync_ops_.size());
+    for (const auto &sync_op : sync_ops_) {
+        sync_op_tags.push_back(sync_op.tag);
+    }
+    first_use_summaries_.emplace_back(&recorded_context, std::make_unique<FirstUseSummary>(recorded_context, sync_op_tags));
+    return *first_use_summaries_.back().second;
 }
 
 bool CommandBufferAccessContext::ValidateBeginRendering(const ErrorObject &error_obj,
@@ -1087,6 +1109,7 @@ void CommandBufferAccessContext::ResolveExecutedCommandBuffer(const AccessContex
 void CommandBufferAccessContext::ImportRecordedAccessLog(const CommandBufferAccessContext &recorded_context) {
     cbs_referenced_->emplace_back(recorded_context.GetCBStateShared());
     access_log_->insert(access_log_->end(), recorded_context.access_log_->cbegin(), recorded_context.access_log_->cend());
+    sync_state_.stats.AddAccessLogRecord(recorded_context.access_log_->size());
 
     // Adjust command indices for the log records added from recorded_context.
     const auto &recorded_label_commands = recorded_context.cb_state_->GetLabelCommands();
@@ -1108,6 +1131,7 @@ ResourceUsageTag CommandBufferAccessContext::NextCommandTag(vvl::Func command, R
     current_command_tag_ = access_log_->size();
 
     ResourceUsageRecord &record = access_log_->emplace_back(command, command_number_, subcommand, cb_state_, reset_count_);
+    sync_state_.stats.AddAccessLogRecord();
 
     if (!cb_state_->GetLabelCommands().empty()) {
         record.label_command_index = static_cast<uint32_t>(cb_state_->GetLabelCommands().size() - 1);
@@ -1119,6 +1143,7 @@ ResourceUsageTag CommandBufferAccessContext::NextCommandTag(vvl::Func command, R
 ResourceUsageTag CommandBufferAccessContext::NextSubcommandTag(vvl::Func command, ResourceUsageRecord::SubcommandType subcommand) {
     const ResourceUsageTag tag = access_log_->size();
     ResourceUsageRecord &record = access_log_->emplace_back(command, command_number_, subcommand, cb_state_, reset_count_);
+    sync_state_.stats.AddAccessLogRecord();
 
     // By default copy handle range from the main command, but can be overwritten with AddSubcommandHandle.
     const auto &main_command_record = (*access_log_)[current_command_tag_];
@@ -1232,12 +1257,30 @@ syncval_state::CommandBufferSubState::CommandBufferSubState(SyncValidator &dev,
     access_context.SetSelfReference();
 }
 
+// The async submit validation also reads the base command buffer state (label commands), wait before it is cleared
+void syncval_state::CommandBufferSubState::PreDestroy() { WaitForAsyncSubmit(); }
+
+void syncval_state::CommandBufferSubState::PreReset() { WaitForAsyncSubmit(); }
+
 void syncval_state::CommandBufferSubState::Destroy() {
     access_context.Destroy();  // must be first to clean up self references correctly.
 }
 
 void syncval_state::CommandBufferSubState::Reset(const Location &loc) { access_context.Reset(); }
 
+void syncval_state::CommandBufferSubState::SetAsyncSubmitTicket(uint64_t ticket) const {
+    // Simultaneous use command buffers can be submitted from several threads, keep the latest task
+    uint64_t current = async_submit_ticket_.load();
+    while (current < ticket && !async_submit_ticket_.compare_exchange_weak(current, ticket)) {
+    }
+}
+
+void syncval_state::CommandBufferSubState::WaitForAsyncSubmit() {
+    if (const uint64_t ticket = async_submit_ticket_.exchange(0)) {
+        access_context.GetSyncState().async_submit_worker_.WaitFor(ticket);
+    }
+}
+
 void syncval_state::CommandBufferSubState::NotifyInvalidate(const vvl::StateObject::NodeList &invalid_nodes, bool unlink) {
     for (auto &obj : invalid_nodes) {
         switch (obj->Type()) {
@@ -16,6 +16,7 @@
  */
 #pragma once
 
+#include <mutex>
 #include "sync/sync_renderpass.h"
 #include "sync/sync_reporting.h"
 #include "state_tracker/cmd_buffer_state.h"
@@ -277,6 +278,9 @@ class CommandBufferAccessContext : public CommandExecutionContext, DebugNameProv
     std::shared_ptr<CommandBufferSet> GetCBReferencesShared() const { return cbs_referenced_; }
     void ImportRecordedAccessLog(const CommandBufferAccessContext &cb_context);
     const std::vector<SyncOpEntry> &GetSyncOps() const { return sync_ops_; };
+    // Summary of the first accesses of one of the recorded contexts (the command buffer context, or a subpass context of a
+    // recorded render pass) for submit time validation. Built on first use and kept until the command buffer is reset.
+    const FirstUseSummary &GetFirstUseSummary(const AccessContext &recorded_context) const;
 
     // DebugNameProvider
     std::string GetDebugRegionName(const ResourceUsageRecord &record) const override;
@@ -327,6 +331,10 @@ class CommandBufferAccessContext : public CommandExecutionContext, DebugNameProv
     RenderPassAccessContext *current_renderpass_context_;
     std::vector<SyncOpEntry> sync_ops_;
 
+    // Submits of the same command buffer can be validated from several threads
+    mutable std::mutex first_use_summaries_lock_;
+    mutable std::vector<std::pair<const AccessContext *, std::unique_ptr<const FirstUseSummary>>> first_use_summaries_;
+
     // State during dynamic rendering (dynamic rendering rendering passes must be
     // contained within a single command buffer)
     std::unique_ptr<syncval_state::DynamicRenderingInfo> dynamic_rendering_info_;
@@ -346,8 +354,19 @@ class CommandBufferSubState : public vvl::CommandBufferSubState {
 
     void NotifyInvalidate(const vvl::StateObject::NodeList &invalid_nodes, bool unlink) override;
 
+    void PreDestroy() override;
+    void PreReset() override;
     void Destroy() override;
     void Reset(const Location &loc) override;
+
+    // With async submit validation, the access context is read by the worker after the submit returns
+    void SetAsyncSubmitTicket(uint64_t ticket) const;
+
+  private:
+    void WaitForAsyncSubmit();
+
+    // Last async submit validation task that reads this command buffer (0 if none)
+    mutable std::atomic<uint64_t> async_submit_ticket_{0};
 };
 
 static inline CommandBufferSubState &SubState(vvl::CommandBuffer &cb) {
@@ -1176,11 +1176,14 @@ bool ReplayState::DetectFirstUseHazard(const ResourceUsageRange &first_use_range
         // We're allowing for the Replay(Validate|Record) to modify the exec_context (e.g. for Renderpass operations), so
         // we need to fetch the current access context each time
         const AccessContext *access_context = GetRecordedAccessContext();
+        const SyncValidator &sync_state = exec_context_.GetSyncState();
 
-        const HazardResult hazard = access_context->DetectFirstUseHazard(exec_context_.GetQueueId(), first_use_range,
-                                                                         *exec_context_.GetCurrentAccessContext());
+        // The recorded accesses are checked against the batch context in parallel for large command buffers
+        vvl::ThreadPool &thread_pool = sync_state.device_state->validation_thread_pool;
+        const FirstUseSummary &first_use = recorded_context_.GetFirstUseSummary(*access_context);
+        const HazardResult hazard = first_use.DetectHazard(exec_context_.GetQueueId(), first_use_range,
+                                                           *exec_context_.GetCurrentAccessContext(), &thread_pool);
         if (hazard.IsHazard()) {
-            const SyncValidator &sync_state = exec_context_.GetSyncState();
             LogObjectList objlist(exec_context_.Handle(), recorded_context_.Handle());
             const std::string error = sync_state.error_messages_.FirstUseError(hazard, exec_context_, recorded_context_, index_);
             skip |= sync_state.SyncError(hazard.Hazard(), objlist, error_obj_.location, error);
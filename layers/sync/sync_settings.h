@@ -16,10 +16,19 @@
  */
 
 #pragma once
+#include <cstdint>
+#include <string>
 
 struct SyncValSettings {
     bool submit_time_validation = true;
+    bool submit_time_validation_async = false;
     bool shader_accesses_heuristic = false;
     bool message_extra_properties = false;
     bool message_extra_properties_pretty_print = false;
+    // In MB, 0 means no budget. Above it the access logs kept for error messages are compacted more aggressively.
+    uint32_t access_log_memory_budget = 0;
+    // Path of a JSON stats report rewritten during submits and at device destruction, empty disables it
+    std::string stats_file;
+    // In seconds, minimum time between two stats file updates during submits
+    uint32_t stats_file_period = 10;
 };
@@ -17,24 +17,27 @@
 
 #include "sync_stats.h"
 
-#if VVL_ENABLE_SYNCVAL_STATS != 0
 #include "sync_commandbuffer.h"
 #include "utils/vk_layer_utils.h"
 
+#include <algorithm>
 #include <iostream>
+#include <sstream>
 
 namespace syncval_stats {
 
+ShardedCounter Stats::hazard_check_counter;
+
 void Value32::Update(uint32_t new_value) { u32.store(new_value); }
 
 uint32_t Value32::Add(uint32_t n) {
-    // fetch_add returns value before increment; add one to get new value
-    return u32.fetch_add(n) + 1;
+    // fetch_add returns value before increment; add n to get new value
+    return u32.fetch_add(n) + n;
 }
 
 uint32_t Value32::Sub(uint32_t n) {
-    // fetch_sub returns value before decrement; subtract one to get new value
-    return u32.fetch_sub(n) - 1;
+    // fetch_sub returns value before decrement; subtract n to get new value
+    return u32.fetch_sub(n) - n;
 }
 
 void ValueMax32::Update(uint32_t new_value) {
@@ -49,6 +52,21 @@ void ValueMax32::Add(uint32_t n) {
 
 void ValueMax32::Sub(uint32_t n) { value.Sub(n); }
 
+int64_t ShardedCounter::Sum() const {
+    int64_t sum = 0;
+    for (const auto &shard : shards_) {
+        sum += shard.value.load(std::memory_order_relaxed);
+    }
+    // The shards are not read atomically, so a Sub() that follows an Add() on another thread can be seen without the Add()
+    return std::max<int64_t>(sum, 0);
+}
+
+int64_t ShardedValueMax::Sample() {
+    const int64_t current = value.Sum();
+    vvl::atomic_fetch_max(max_value, current);
+    return current;
+}
+
 Stats::~Stats() {
     if (report_on_destruction) {
         const std::string report = CreateReport();
@@ -56,35 +74,39 @@ Stats::~Stats() {
     }
 }
 
-void Stats::AddCommandBufferContext() { command_buffer_context_counter.Add(1); }
-void Stats::RemoveCommandBufferContext() { command_buffer_context_counter.Sub(1); }
-
-void Stats::AddQueueBatchContext() { queue_batch_context_counter.Add(1); }
-void Stats::RemoveQueueBatchContext() { queue_batch_context_counter.Sub(1); }
-
 void Stats::AddTimelineSignals(uint32_t count) { timeline_signal_counter.Add(count); }
 void Stats::RemoveTimelineSignals(uint32_t count) { timeline_signal_counter.Sub(count); }
 
 void Stats::AddUnresolvedBatch() { unresolved_batch_counter.Add(1); }
 void Stats::RemoveUnresolvedBatch() { unresolved_batch_counter.Sub(1); }
 
-void Stats::AddHandleRecord(uint32_t count) { handle_record_counter.Add(count); }
-void Stats::RemoveHandleRecord(uint32_t count) { handle_record_counter.Sub(count); }
+void Stats::AddSubmitValidation(std::chrono::steady_clock::duration duration) {
+    const uint64_t ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+    submit_counter.fetch_add(1);
+    submit_validation_time_ns.fetch_add(ns);
+    vvl::atomic_fetch_max(submit_validation_max_time_ns, ns);
+
+    // Submits are rare compared to the updates of the sharded counters, sample their max here so it is still meaningful in
+    // the report made at destruction
+    command_buffer_context_counter.Sample();
+    queue_batch_context_counter.Sample();
+    handle_record_counter.Sample();
+}
 
 void Stats::ReportOnDestruction() { report_on_destruction = true; }
 
 std::string Stats::CreateReport() {
     std::ostringstream str;
     {
-        uint32_t cb_contex = command_buffer_context_counter.value.u32;
-        uint32_t cb_context_max = command_buffer_context_counter.max_value.u32;
+        const int64_t cb_contex = command_buffer_context_counter.Sample();
+        const int64_t cb_context_max = command_buffer_context_counter.max_value;
         str << "CommandBufferAccessContext:\n";
         str << "\tcount = " << cb_contex << '\n';
         str << "\tmax_count = " << cb_context_max << '\n';
     }
     {
-        uint32_t qbc_context = queue_batch_context_counter.value.u32;
-        uint32_t qbc_context_max = queue_batch_context_counter.max_value.u32;
+        const int64_t qbc_context = queue_batch_context_counter.Sample();
+        const int64_t qbc_context_max = queue_batch_context_counter.max_value;
         str << "QueueBatchContext:\n";
         str << "\tcount = " << qbc_context << "\n";
         str << "\tmax_count = " << qbc_context_max << "\n";
@@ -104,18 +126,84 @@ std::string Stats::CreateReport() {
         str << "\tmax_count = " << unresolved_batch_max << "\n";
     }
     {
-        uint32_t handle_record = handle_record_counter.value.u32;
-        uint64_t handle_record_memory = handle_record * sizeof(HandleRecord);
-        uint32_t handle_record_max = handle_record_counter.max_value.u32;
-        uint64_t handle_record_max_memory = handle_record_max * sizeof(HandleRecord);
+        const int64_t handle_record = handle_record_counter.Sample();
+        const uint64_t handle_record_memory = handle_record * sizeof(HandleRecord);
+        const int64_t handle_record_max = handle_record_counter.max_value;
+        const uint64_t handle_record_max_memory = handle_record_max * sizeof(HandleRecord);
         str << "HandleRecord:\n";
         str << "\tcount = " << handle_record << '\n';
         str << "\tmemory = " << handle_record_memory << " bytes\n";
         str << "\tmax_count = " << handle_record_max << '\n';
         str << "\tmax_memory = " << handle_record_max_memory << " bytes\n";
     }
+    {
+        str << "AccessLog:\n";
+        str << "\trecords = " << access_log_record_counter.Sum() << '\n';
+    }
+    {
+        const uint64_t submits = submit_counter;
+        const uint64_t time_us = submit_validation_time_ns / 1000;
+        str << "Submit validation:\n";
+        str << "\tsubmits = " << submits << '\n';
+        str << "\ttime = " << time_us << " us\n";
+        str << "\tmax_time = " << submit_validation_max_time_ns / 1000 << " us\n";
+    }
+    {
+        str << "Hazard checks (process wide):\n";
+        str << "\tcount = " << hazard_check_counter.Sum() << '\n';
+    }
+    return str.str();
+}
+
+std::string Stats::CreateJsonReport(const std::vector<QueueBatchStats> &queues) {
+    const auto now = std::chrono::steady_clock::now();
+    const double seconds = std::chrono::duration<double>(now - creation_time_).count();
+    const double interval_seconds = std::chrono::duration<double>(now - last_json_report_time_).count();
+    const int64_t hazard_checks = hazard_check_counter.Sum();
+    const double hazard_checks_per_second =
+        interval_seconds > 0.0 ? static_cast<double>(hazard_checks - last_json_report_hazard_checks_) / interval_seconds : 0.0;
+    last_json_report_time_ = now;
+    last_json_report_hazard_checks_ = hazard_checks;
+
+    auto counter = [](std::ostringstream &str, const char *name, const ValueMax32 &value) {
+        str << "  \"" << name << "\": { \"count\": " << value.value.u32 << ", \"max_count\": " << value.max_value.u32 << " },\n";
+    };
+    auto sharded_counter = [](std::ostringstream &str, const char *name, ShardedValueMax &value) {
+        const int64_t count = value.Sample();
+        str << "  \"" << name << "\": { \"count\": " << count << ", \"max_count\": " << value.max_value << " },\n";
+    };
+
+    std::ostringstream str;
+    str << "{\n";
+    str << "  \"seconds\": " << seconds << ",\n";
+    sharded_counter(str, "command_buffer_contexts", command_buffer_context_counter);
+    sharded_counter(str, "queue_batch_contexts", queue_batch_context_counter);
+    counter(str, "timeline_signals", timeline_signal_counter);
+    counter(str, "unresolved_batches", unresolved_batch_counter);
+    sharded_counter(str, "handle_records", handle_record_counter);
+    str << "  \"handle_record_bytes\": " << handle_record_counter.value.Sum() * sizeof(HandleRecord) << ",\n";
+    str << "  \"command_buffer_access_log_records\": " << access_log_record_counter.Sum() << ",\n";
+
+    const uint64_t submits = submit_counter;
+    const uint64_t submit_time_ns = submit_validation_time_ns;
+    str << "  \"submit_validation\": { \"submits\": " << submits << ", \"total_us\": " << submit_time_ns / 1000
+        << ", \"average_us\": " << (submits ? submit_time_ns / submits / 1000 : 0)
+        << ", \"max_us\": " << submit_validation_max_time_ns / 1000 << " },\n";
+    str << "  \"hazard_checks\": { \"count\": " << hazard_checks << ", \"per_second\": " << uint64_t(hazard_checks_per_second)
+        << " },\n";
+
+    str << "  \"queues\": [";
+    for (size_t i = 0; i < queues.size(); ++i) {
+        const QueueBatchStats &queue = queues[i];
+        str << (i ? ",\n" : "\n");
+        str << "    { \"queue_id\": " << queue.queue_id << ", \"access_map_entries\": " << queue.access_map_entries
+            << ", \"access_map_bytes\": " << queue.access_map_bytes << ", \"access_map_segments\": " << queue.access_map_segments
+            << ", \"access_map_shared_segments\": " << queue.access_map_shared_segments
+            << ", \"access_log_bytes\": " << queue.access_log_bytes << " }";
+    }
+    str << (queues.empty() ? "]\n" : "\n  ]\n");
+    str << "}\n";
     return str.str();
 }
 
 }  // namespace syncval_stats
-#endif  // VVL_ENABLE_SYNCVAL_STATS != 0
@@ -17,22 +17,17 @@
 
 #pragma once
 
-#include <string>
-#include <cstdint>
-
-#ifndef VVL_ENABLE_SYNCVAL_STATS
-#define VVL_ENABLE_SYNCVAL_STATS 0
-#endif
-
-#if VVL_ENABLE_SYNCVAL_STATS != 0
+#include <array>
 #include <atomic>
-#endif
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
 
 namespace syncval_stats {
-#if VVL_ENABLE_SYNCVAL_STATS != 0
 
 struct Value32 {
-    std::atomic_uint32_t u32;
+    std::atomic_uint32_t u32{0};
     void Update(uint32_t new_value);
     uint32_t Add(uint32_t n);  // Returns new counter value
     uint32_t Sub(uint32_t n);  // Returns new counter value
@@ -46,17 +41,64 @@ struct ValueMax32 {
     void Sub(uint32_t n);
 };
 
+// Counter for the hot paths. Each thread adds to its own cache line (threads only share one past kShardCount threads),
+// and the shards are summed when the value is read.
+class ShardedCounter {
+  public:
+    void Add(int64_t n) { shards_[ThreadShard()].value.fetch_add(n, std::memory_order_relaxed); }
+    void Sub(int64_t n) { Add(-n); }
+    // Never negative, even while a Sub() is seen before the matching Add()
+    int64_t Sum() const;
+
+  private:
+    static constexpr uint32_t kShardCount = 16;
+    struct alignas(64) Shard {
+        std::atomic_int64_t value{0};
+    };
+
+    static uint32_t ThreadShard() {
+        static std::atomic_uint32_t next_shard{0};
+        thread_local const uint32_t shard = next_shard.fetch_add(1, std::memory_order_relaxed) % kShardCount;
+        return shard;
+    }
+
+    std::array<Shard, kShardCount> shards_;
+};
+
+// ShardedCounter that also keeps the largest value it had when sampled. Tracking the exact max would need a CAS loop on every
+// change, which is too much for the hot paths.
+struct ShardedValueMax {
+    ShardedCounter value;
+    std::atomic_int64_t max_value{0};
+    void Add(uint32_t n) { value.Add(n); }
+    void Sub(uint32_t n) { value.Sub(n); }
+    // Returns the current value, after folding it into max_value
+    int64_t Sample();
+};
+
+// State held by the last batch of a queue, gathered by the validator when a report is made
+struct QueueBatchStats {
+    uint32_t queue_id = 0;
+    uint64_t access_map_entries = 0;
+    uint64_t access_map_bytes = 0;  // Approximate, the heap storage of the access states is not included
+    uint64_t access_map_segments = 0;
+    uint64_t access_map_shared_segments = 0;
+    uint64_t access_log_bytes = 0;
+};
+
+// Stats are always collected. Counting is cheap enough for all builds, the reports are only made on request.
 struct Stats {
     ~Stats();
     bool report_on_destruction = false;
 
-    ValueMax32 command_buffer_context_counter;
-    void AddCommandBufferContext();
-    void RemoveCommandBufferContext();
+    // The max_count of the sharded counters is sampled at each submit and report
+    ShardedValueMax command_buffer_context_counter;
+    void AddCommandBufferContext() { command_buffer_context_counter.Add(1); }
+    void RemoveCommandBufferContext() { command_buffer_context_counter.Sub(1); }
 
-    ValueMax32 queue_batch_context_counter;
-    void AddQueueBatchContext();
-    void RemoveQueueBatchContext();
+    ShardedValueMax queue_batch_context_counter;
+    void AddQueueBatchContext() { queue_batch_context_counter.Add(1); }
+    void RemoveQueueBatchContext() { queue_batch_context_counter.Sub(1); }
 
     ValueMax32 timeline_signal_counter;
     void AddTimelineSignals(uint32_t count);
@@ -66,28 +108,33 @@ struct Stats {
     void AddUnresolvedBatch();
     void RemoveUnresolvedBatch();
 
-    ValueMax32 handle_record_counter;
-    void AddHandleRecord(uint32_t count = 1);
-    void RemoveHandleRecord(uint32_t count = 1);
+    ShardedValueMax handle_record_counter;
+    void AddHandleRecord(uint32_t count = 1) { handle_record_counter.Add(count); }
+    void RemoveHandleRecord(uint32_t count = 1) { handle_record_counter.Sub(count); }
+
+    // Records of the command buffer access logs. The logs referenced by the batches are reported with their queue.
+    ShardedCounter access_log_record_counter;
+    void AddAccessLogRecord(size_t count = 1) { access_log_record_counter.Add(static_cast<int64_t>(count)); }
+    void RemoveAccessLogRecord(size_t count = 1) { access_log_record_counter.Sub(static_cast<int64_t>(count)); }
+
+    // Access contexts don't know which device they belong to, so hazard checks are counted for the whole process
+    static ShardedCounter hazard_check_counter;
+    static void AddHazardCheck() { hazard_check_counter.Add(1); }
+
+    std::atomic_uint64_t submit_counter{0};
+    std::atomic_uint64_t submit_validation_time_ns{0};
+    std::atomic_uint64_t submit_validation_max_time_ns{0};
+    void AddSubmitValidation(std::chrono::steady_clock::duration duration);
 
     void ReportOnDestruction();
     std::string CreateReport();
-};
+    // The hazard check rate is computed since the previous call, calls must be externally synchronized
+    std::string CreateJsonReport(const std::vector<QueueBatchStats> &queues);
 
-#else
-struct Stats {
-    void AddHandleRecord(uint32_t count = 1) {}
-    void RemoveHandleRecord(uint32_t count = 1) {}
-    void AddCommandBufferContext() {}
-    void RemoveCommandBufferContext() {}
-    void AddQueueBatchContext() {}
-    void RemoveQueueBatchContext() {}
-    void AddTimelineSignals(uint32_t count) {}
-    void RemoveTimelineSignals(uint32_t count) {}
-    void AddUnresolvedBatch() {}
-    void RemoveUnresolvedBatch() {}
-    void ReportOnDestruction() {}
-    std::string CreateReport() { return "SyncVal stats are disabled in the current build configuration\n"; }
+  private:
+    const std::chrono::steady_clock::time_point creation_time_ = std::chrono::steady_clock::now();
+    std::chrono::steady_clock::time_point last_json_report_time_ = creation_time_;
+    int64_t last_json_report_hazard_checks_ = hazard_check_counter.Sum();
 };
-#endif  // VVL_ENABLE_SYNCVAL_STATS != 0
+
 }  // namespace syncval_stats
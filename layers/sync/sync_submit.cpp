@@ -19,6 +19,10 @@
 #include "sync/sync_validation.h"
 #include "sync/sync_image.h"
 #include "sync/sync_reporting.h"
+#include "profiling/profiling.h"
+
+#include <algorithm>
+#include <limits>
 
 AcquiredImage::AcquiredImage(const PresentedImage& presented, ResourceUsageTag acq_tag)
     : image(presented.image), generator(presented.range_gen), present_tag(presented.tag), acquire_tag(acq_tag) {}
@@ -268,6 +272,28 @@ void QueueBatchContext::Trim() {
 
     // Only conserve AccessLog references that are referenced by used_tags
     batch_log_.Trim(used_tags);
+
+    // The budget is for the device, split between the queues
+    const size_t memory_budget = size_t(sync_state_.syncval_settings.access_log_memory_budget) * 1024 * 1024 /
+                                 std::max<size_t>(sync_state_.queue_sync_states_.size(), 1);
+    batch_log_.Compact(used_tags, memory_budget);
+}
+
+syncval_stats::QueueBatchStats QueueBatchContext::GetStats() const {
+    // Map nodes carry a header (color and three links) in front of the entry
+    constexpr size_t kNodeBytes = sizeof(ResourceAccessRangeMap::value_type) + 4 * sizeof(void*);
+
+    const ResourceAccessRangeMap& access_map = access_context_.GetAccessStateMap();
+    syncval_stats::QueueBatchStats stats;
+    stats.queue_id = GetQueueId();
+    stats.access_map_entries = access_map.size();
+    stats.access_map_bytes = access_map.size() * kNodeBytes;
+#if VVL_SYNCVAL_SEGMENTED_ACCESS_MAPS != 0
+    stats.access_map_segments = access_map.get_implementation_map().segment_count();
+    stats.access_map_shared_segments = access_map.get_implementation_map().shared_segment_count();
+#endif
+    stats.access_log_bytes = batch_log_.MemoryUsage();
+    return stats;
 }
 
 void QueueBatchContext::ResolveSubmittedCommandBuffer(const AccessContext& recorded_context, ResourceUsageTag offset) {
@@ -739,13 +765,28 @@ void QueueSyncState::ClearPending() const {
 
 void BatchAccessLog::Import(const BatchRecord& batch, const CommandBufferAccessContext& cb_access,
                             const std::vector<std::string>& initial_label_stack) {
+    LabelStackPtr label_stack;
+    if (!initial_label_stack.empty()) {
+        if (!last_label_stack_ || *last_label_stack_ != initial_label_stack) {
+            last_label_stack_ = std::make_shared<const std::vector<std::string>>(initial_label_stack);
+        }
+        label_stack = last_label_stack_;
+    }
     ResourceUsageRange import_range = {batch.base_tag, batch.base_tag + cb_access.GetTagCount()};
-    log_map_.insert(std::make_pair(import_range, CBSubmitLog(batch, cb_access, initial_label_stack)));
+    log_map_.insert(std::make_pair(import_range, CBSubmitLog(batch, cb_access, std::move(label_stack))));
 }
 
 void BatchAccessLog::Import(const BatchAccessLog& other) {
     for (const auto& entry : other.log_map_) {
-        log_map_.insert(entry);
+        auto inserted = log_map_.insert(entry);
+        if (!inserted.second) {
+            // Same submit seen through two batches, each one may have compacted it differently
+            assert(inserted.first->first == entry.first);
+            inserted.first->second.Merge(entry.second);
+        }
+    }
+    if (!last_label_stack_) {
+        last_label_stack_ = other.last_label_stack_;
     }
 }
 
@@ -809,6 +850,52 @@ void BatchAccessLog::Trim(const ResourceUsageTagSet& used_tags) {
     }
 }
 
+// Compact: Keep only the referenced records of the AccessLogs that are mostly unreferenced
+//
+// Trim only drops the logs with no referenced tag at all. A log with a single referenced record still keeps the whole
+// AccessLog of the command buffer alive, and long running queues without host waits accumulate these. Compaction copies the
+// referenced records out and releases the reference to the full log.
+//
+// Must use the same used tags as the Trim just before it, lookups of tags not in the set fail afterwards.
+void BatchAccessLog::Compact(const ResourceUsageTagSet& used_tags, size_t memory_budget) {
+    // Copying the records of small or mostly referenced logs doesn't save enough to be worth it
+    constexpr size_t kMinCompactSize = 64;
+    constexpr size_t kCompactRatio = 4;
+    const bool over_budget = (memory_budget != 0) && (MemoryUsage() > memory_budget);
+
+    std::vector<ResourceUsageTag> kept_tags;
+    for (auto& entry : log_map_) {
+        const ResourceUsageRange& range = entry.first;
+        CBSubmitLog& submit_log = entry.second;
+        const size_t size = submit_log.Size();
+        if (size < kMinCompactSize && !over_budget) {
+            continue;
+        }
+        kept_tags.clear();
+        for (auto tag = used_tags.lower_bound(range.begin); tag != used_tags.end() && *tag < range.end; ++tag) {
+            kept_tags.emplace_back(*tag);
+        }
+        const bool sparse = kept_tags.size() * kCompactRatio <= size;
+        if (kept_tags.size() < size && (sparse || over_budget)) {
+            submit_log.Compact(kept_tags);
+        }
+    }
+}
+
+size_t BatchAccessLog::MemoryUsage() const {
+    // Repeated submits of a command buffer share its log
+    vvl::unordered_set<const void*> counted_logs;
+    size_t usage = 0;
+    for (const auto& entry : log_map_) {
+        const void* key = nullptr;
+        const size_t log_usage = entry.second.MemoryUsage(key);
+        if (counted_logs.insert(key).second) {
+            usage += log_usage;
+        }
+    }
+    return usage;
+}
+
 BatchAccessLog::AccessRecord BatchAccessLog::GetAccessRecord(ResourceUsageTag tag) const {
     auto found_log = log_map_.find(tag);
     if (found_log != log_map_.cend()) {
@@ -820,13 +907,33 @@ BatchAccessLog::AccessRecord BatchAccessLog::GetAccessRecord(ResourceUsageTag ta
 }
 
 std::string BatchAccessLog::CBSubmitLog::GetDebugRegionName(const ResourceUsageRecord& record) const {
+    if (compact_log_) {
+        const size_t pos = &record - compact_log_->records.data();
+        assert(pos < compact_log_->records.size());
+        const uint32_t region_id = compact_log_->debug_region_ids[pos];
+        return (region_id == vvl::kNoIndex32) ? std::string() : compact_log_->debug_region_names[region_id];
+    }
+    static const std::vector<std::string> empty_label_stack;
     const auto& label_commands = (*cbs_)[0]->GetLabelCommands();
-    return vvl::CommandBuffer::GetDebugRegionName(label_commands, record.label_command_index, initial_label_stack_);
+    return vvl::CommandBuffer::GetDebugRegionName(label_commands, record.label_command_index,
+                                                  initial_label_stack_ ? *initial_label_stack_ : empty_label_stack);
 }
 
 BatchAccessLog::AccessRecord BatchAccessLog::CBSubmitLog::GetAccessRecord(ResourceUsageTag tag) const {
     assert(tag >= batch_.base_tag);
     const size_t index = tag - batch_.base_tag;
+    if (compact_log_) {
+        const auto& indices = compact_log_->indices;
+        const auto found = std::lower_bound(indices.begin(), indices.end(), static_cast<uint32_t>(index));
+        if (found == indices.end() || *found != index) {
+            // Compaction only drops records that are not referenced anymore
+            assert(false);
+            return AccessRecord();
+        }
+        const size_t pos = found - indices.begin();
+        const auto debug_name_provider = (compact_log_->debug_region_ids[pos] == vvl::kNoIndex32) ? nullptr : this;
+        return AccessRecord{&batch_, &compact_log_->records[pos], debug_name_provider};
+    }
     assert(log_);
     assert(index < log_->size());
     const ResourceUsageRecord* record = &(*log_)[index];
@@ -834,14 +941,100 @@ BatchAccessLog::AccessRecord BatchAccessLog::CBSubmitLog::GetAccessRecord(Resour
     return AccessRecord{&batch_, record, debug_name_provider};
 }
 
+void BatchAccessLog::CBSubmitLog::Compact(const std::vector<ResourceUsageTag>& kept_tags) {
+    auto compact_log = std::make_shared<CompactLog>();
+    compact_log->indices.reserve(kept_tags.size());
+    compact_log->records.reserve(kept_tags.size());
+    compact_log->debug_region_ids.reserve(kept_tags.size());
+    for (const ResourceUsageTag tag : kept_tags) {
+        const AccessRecord access = GetAccessRecord(tag);
+        if (!access.IsValid()) {
+            continue;
+        }
+        uint32_t region_id = vvl::kNoIndex32;
+        if (access.debug_name_provider) {
+            std::string name = GetDebugRegionName(*access.record);
+            if (!name.empty()) {
+                region_id = compact_log->InternDebugRegionName(std::move(name));
+            }
+        }
+        compact_log->indices.emplace_back(static_cast<uint32_t>(tag - batch_.base_tag));
+        compact_log->records.emplace_back(*access.record);
+        compact_log->debug_region_ids.emplace_back(region_id);
+    }
+    compact_log_ = std::move(compact_log);
+    log_.reset();
+    initial_label_stack_.reset();
+}
+
+void BatchAccessLog::CBSubmitLog::Merge(const CBSubmitLog& other) {
+    if (!compact_log_ || compact_log_ == other.compact_log_) {
+        return;  // Already has every record the other log can have
+    }
+    if (!other.compact_log_) {
+        *this = other;
+        return;
+    }
+    const CompactLog& a = *compact_log_;
+    const CompactLog& b = *other.compact_log_;
+    auto merged = std::make_shared<CompactLog>();
+    auto append = [&merged](const CompactLog& from, size_t pos) {
+        uint32_t region_id = from.debug_region_ids[pos];
+        if (region_id != vvl::kNoIndex32) {
+            region_id = merged->InternDebugRegionName(std::string(from.debug_region_names[region_id]));
+        }
+        merged->indices.emplace_back(from.indices[pos]);
+        merged->records.emplace_back(from.records[pos]);
+        merged->debug_region_ids.emplace_back(region_id);
+    };
+    size_t a_pos = 0;
+    size_t b_pos = 0;
+    while (a_pos < a.indices.size() || b_pos < b.indices.size()) {
+        if (b_pos == b.indices.size() || (a_pos < a.indices.size() && a.indices[a_pos] <= b.indices[b_pos])) {
+            if (b_pos < b.indices.size() && a.indices[a_pos] == b.indices[b_pos]) {
+                ++b_pos;
+            }
+            append(a, a_pos++);
+        } else {
+            append(b, b_pos++);
+        }
+    }
+    compact_log_ = std::move(merged);
+}
+
+size_t BatchAccessLog::CBSubmitLog::MemoryUsage(const void*& key) const {
+    if (compact_log_) {
+        key = compact_log_.get();
+        size_t usage = compact_log_->records.capacity() * (sizeof(ResourceUsageRecord) + 2 * sizeof(uint32_t));
+        for (const std::string& name : compact_log_->debug_region_names) {
+            usage += sizeof(std::string) + name.capacity();
+        }
+        return usage;
+    }
+    key = log_.get();
+    return log_ ? log_->capacity() * sizeof(ResourceUsageRecord) : 0;
+}
+
+uint32_t BatchAccessLog::CBSubmitLog::CompactLog::InternDebugRegionName(std::string&& name) {
+    const auto found = std::find(debug_region_names.begin(), debug_region_names.end(), name);
+    if (found != debug_region_names.end()) {
+        return static_cast<uint32_t>(found - debug_region_names.begin());
+    }
+    debug_region_names.emplace_back(std::move(name));
+    return static_cast<uint32_t>(debug_region_names.size() - 1);
+}
+
 BatchAccessLog::CBSubmitLog::CBSubmitLog(const BatchRecord& batch,
                                          std::shared_ptr<const CommandExecutionContext::CommandBufferSet> cbs,
                                          std::shared_ptr<const CommandExecutionContext::AccessLog> log)
     : batch_(batch), cbs_(cbs), log_(log) {}
 
 BatchAccessLog::CBSubmitLog::CBSubmitLog(const BatchRecord& batch, const CommandBufferAccessContext& cb,
-                                         const std::vector<std::string>& initial_label_stack)
-    : batch_(batch), cbs_(cb.GetCBReferencesShared()), log_(cb.GetAccessLogShared()), initial_label_stack_(initial_label_stack) {}
+                                         LabelStackPtr initial_label_stack)
+    : batch_(batch),
+      cbs_(cb.GetCBReferencesShared()),
+      log_(cb.GetAccessLogShared()),
+      initial_label_stack_(std::move(initial_label_stack)) {}
 
 PresentedImage::PresentedImage(SyncValidator& sync_state, QueueBatchContext::Ptr batch_, VkSwapchainKHR swapchain,
                                uint32_t image_index_, uint32_t present_index_, ResourceUsageTag tag_)
@@ -887,3 +1080,61 @@ void PresentedImage::UpdateMemoryAccess(SyncAccessIndex usage, ResourceUsageTag
     // Intentional copy. The range_gen argument is not copied by the Update... call below
     access_context.UpdateAccessState(range_gen, usage, SyncOrdering::kNonAttachment, ResourceUsageTagEx{tag});
 }
+
+uint64_t AsyncSubmitWorker::Post(std::function<void()>&& task) {
+    {
+        std::lock_guard<std::mutex> guard(lock_);
+        if (!exit_) {
+            if (!thread_.joinable()) {
+                thread_ = std::thread(&AsyncSubmitWorker::WorkerFunc, this);
+            }
+            tasks_.emplace_back(std::move(task));
+            wake_.notify_one();
+            return ++posted_;
+        }
+    }
+    task();
+    return 0;
+}
+
+void AsyncSubmitWorker::WaitFor(uint64_t ticket) {
+    std::unique_lock<std::mutex> guard(lock_);
+    // A task can end up here through a debug callback calling back into the layer, it would wait for itself
+    if (thread_.get_id() == std::this_thread::get_id()) {
+        return;
+    }
+    ticket = std::min(ticket, posted_);
+    done_.wait(guard, [this, ticket]() { return completed_ >= ticket; });
+}
+
+void AsyncSubmitWorker::Drain() { WaitFor(std::numeric_limits<uint64_t>::max()); }
+
+void AsyncSubmitWorker::Shutdown() {
+    {
+        std::lock_guard<std::mutex> guard(lock_);
+        exit_ = true;
+    }
+    wake_.notify_all();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void AsyncSubmitWorker::WorkerFunc() {
+    VVL_TracySetThreadName(__FUNCTION__);
+    std::unique_lock<std::mutex> guard(lock_);
+    while (true) {
+        wake_.wait(guard, [this]() { return exit_ || !tasks_.empty(); });
+        // Tasks posted before Shutdown still run, they record state later calls depend on
+        if (tasks_.empty()) {
+            break;
+        }
+        std::function<void()> task = std::move(tasks_.front());
+        tasks_.pop_front();
+        guard.unlock();
+        task();
+        guard.lock();
+        ++completed_;
+        done_.notify_all();
+    }
+}
@@ -19,6 +19,12 @@
 #include "sync/sync_commandbuffer.h"
 #include "state_tracker/queue_state.h"
 
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
 struct PresentedImage;
 class QueueBatchContext;
 struct QueueSubmitCmdState;
@@ -185,6 +191,8 @@ class BatchAccessLog {
         bool IsValid() const { return batch && record; }
     };
 
+    using LabelStackPtr = std::shared_ptr<const std::vector<std::string>>;
+
     struct CBSubmitLog : DebugNameProvider {
       public:
         CBSubmitLog() = default;
@@ -194,20 +202,39 @@ class BatchAccessLog {
         CBSubmitLog &operator=(CBSubmitLog &&other) = default;
         CBSubmitLog(const BatchRecord &batch, std::shared_ptr<const CommandExecutionContext::CommandBufferSet> cbs,
                     std::shared_ptr<const CommandExecutionContext::AccessLog> log);
-        CBSubmitLog(const BatchRecord &batch, const CommandBufferAccessContext &cb,
-                    const std::vector<std::string> &initial_label_stack);
-        size_t Size() const { return log_->size(); }
+        CBSubmitLog(const BatchRecord &batch, const CommandBufferAccessContext &cb, LabelStackPtr initial_label_stack);
+        size_t Size() const { return compact_log_ ? compact_log_->records.size() : log_->size(); }
+        bool IsCompact() const { return compact_log_ != nullptr; }
         AccessRecord GetAccessRecord(ResourceUsageTag tag) const;
 
+        // Replace the log with a copy of the records for the given tags (sorted, all within the submit log range)
+        void Compact(const std::vector<ResourceUsageTag> &kept_tags);
+        // Other is a log of the same submit from another batch, which might have kept different records
+        void Merge(const CBSubmitLog &other);
+        // Approximate size of the log, key is set to the shared allocation to count logs of repeated submits once
+        size_t MemoryUsage(const void *&key) const;
+
         // DebugNameProvider
         std::string GetDebugRegionName(const ResourceUsageRecord &record) const override;
 
       private:
+        // The records still referenced once most of the command buffer log is no longer needed.
+        // Debug region names are resolved when compacting, different regions of a log are usually few.
+        struct CompactLog {
+            std::vector<uint32_t> indices;  // sorted, position of the record in the command buffer log
+            std::vector<ResourceUsageRecord> records;
+            std::vector<uint32_t> debug_region_ids;  // vvl::kNoIndex32 when not inside a debug region
+            std::vector<std::string> debug_region_names;
+
+            uint32_t InternDebugRegionName(std::string &&name);
+        };
+
         BatchRecord batch_;
         std::shared_ptr<const CommandExecutionContext::CommandBufferSet> cbs_;
         std::shared_ptr<const CommandExecutionContext::AccessLog> log_;
+        std::shared_ptr<const CompactLog> compact_log_;
         // label stack at the point when command buffer is submitted to the queue
-        std::vector<std::string> initial_label_stack_;
+        LabelStackPtr initial_label_stack_;
     };
 
     void Import(const BatchRecord &batch, const CommandBufferAccessContext &cb_access,
@@ -217,6 +244,10 @@ class BatchAccessLog {
                 std::shared_ptr<const CommandExecutionContext::AccessLog> log);
 
     void Trim(const ResourceUsageTagSet &used);
+    // Drop the unreferenced records of the logs that are mostly unreferenced. When the logs use more than memory_budget
+    // bytes (0 is no budget) every log with unreferenced records is compacted.
+    void Compact(const ResourceUsageTagSet &used, size_t memory_budget);
+    size_t MemoryUsage() const;
     // AccessRecord lookup is based on global tags
     AccessRecord GetAccessRecord(ResourceUsageTag tag) const;
     BatchAccessLog() {}
@@ -224,6 +255,8 @@ class BatchAccessLog {
   private:
     using CBSubmitLogRangeMap = sparse_container::range_map<ResourceUsageTag, CBSubmitLog>;
     CBSubmitLogRangeMap log_map_;
+    // Consecutive submits mostly share the label stack, the last one is reused when it matches
+    LabelStackPtr last_label_stack_;
 };
 
 // Batch that has wait-before-signal dependencies.
@@ -294,6 +327,7 @@ class QueueBatchContext : public CommandExecutionContext, public std::enable_sha
     QueueBatchContext() = delete;
     ~QueueBatchContext();
     void Trim();
+    syncval_stats::QueueBatchStats GetStats() const;
 
     ResourceUsageInfo GetResourceUsageInfo(ResourceUsageTagEx tag_ex) const override;
     AccessContext *GetCurrentAccessContext() override { return current_access_context_; }
@@ -419,3 +453,35 @@ struct QueueSubmitCmdState {
     SignalsUpdate signals_update;
     QueueSubmitCmdState(const SyncValidator &sync_validator) : signals_update(sync_validator) {}
 };
+
+// Runs submit time validation off the submitting thread (syncval_submit_time_validation_async).
+//
+// Tasks run one at a time, in the order they were posted, so a task sees the batch state left by all the submits
+// and waits posted before it. Code outside the worker that reads that state must Drain() first.
+class AsyncSubmitWorker {
+  public:
+    AsyncSubmitWorker() = default;
+    AsyncSubmitWorker(const AsyncSubmitWorker &) = delete;
+    AsyncSubmitWorker &operator=(const AsyncSubmitWorker &) = delete;
+    ~AsyncSubmitWorker() { Shutdown(); }
+
+    // Returns a ticket for WaitFor. After Shutdown the task runs on the calling thread and the ticket is 0.
+    uint64_t Post(std::function<void()> &&task);
+    // Block until the task with the given ticket (and so all tasks before it) is done. No-op on the worker thread.
+    void WaitFor(uint64_t ticket);
+    void Drain();
+    // Runs what is left and joins the worker
+    void Shutdown();
+
+  private:
+    void WorkerFunc();
+
+    std::mutex lock_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    std::deque<std::function<void()>> tasks_;
+    uint64_t posted_ = 0;
+    uint64_t completed_ = 0;
+    bool exit_ = false;
+    std::thread thread_;
+};
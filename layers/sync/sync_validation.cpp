@@ -16,6 +16,9 @@
  */
 
 #include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
 #include <memory>
 #include <vector>
 
@@ -149,6 +152,20 @@ void SyncValidator::ApplySignalsUpdate(SignalsUpdate &update, const QueueBatchCo
     EnsureTimelineSignalsLimit(kMaxTimelineSignalsPerQueue);
 }
 
+void SyncValidator::RecordBatchStateUpdate(std::function<void()> &&update) {
+    if (syncval_settings.submit_time_validation_async) {
+        async_submit_worker_.Post(std::move(update));
+    } else {
+        update();
+    }
+}
+
+void SyncValidator::WaitForAsyncSubmits() const {
+    if (syncval_settings.submit_time_validation_async) {
+        async_submit_worker_.Drain();
+    }
+}
+
 void SyncValidator::ApplyTaggedWait(QueueId queue_id, ResourceUsageTag tag) {
     auto tagged_wait_op = [queue_id, tag](const QueueBatchContext::Ptr &batch) {
         batch->ApplyTaggedWait(queue_id, tag);
@@ -303,11 +320,13 @@ void SyncValidator::PreCallRecordDestroyBuffer(VkDevice device, VkBuffer buffer,
     if (const auto buffer_state = Get<vvl::Buffer>(buffer)) {
         const VkDeviceSize base_address = ResourceBaseAddress(*buffer_state);
         const ResourceAccessRange buffer_range(base_address, base_address + buffer_state->create_info.size);
-        auto batch_op = [&buffer_range](const QueueBatchContext::Ptr &batch) {
-            batch->OnResourceDestroyed(buffer_range);
-            batch->Trim();
-        };
-        ForAllQueueBatchContexts(batch_op);
+        RecordBatchStateUpdate([this, buffer_range]() {
+            auto batch_op = [&buffer_range](const QueueBatchContext::Ptr &batch) {
+                batch->OnResourceDestroyed(buffer_range);
+                batch->Trim();
+            };
+            ForAllQueueBatchContexts(batch_op);
+        });
     }
     BaseClass::PreCallRecordDestroyBuffer(device, buffer, pAllocator, record_obj);
 }
@@ -315,16 +334,22 @@ void SyncValidator::PreCallRecordDestroyBuffer(VkDevice device, VkBuffer buffer,
 void SyncValidator::PreCallRecordDestroyImage(VkDevice device, VkImage image, const VkAllocationCallbacks *pAllocator,
                                               const RecordObject &record_obj) {
     if (const auto image_state = Get<vvl::Image>(image)) {
-        auto batch_op = [&image_state](const QueueBatchContext::Ptr &batch) {
-            const auto &sub_state = syncval_state::SubState(*image_state);
-            ImageRangeGen range_gen = sub_state.MakeImageRangeGen(image_state->full_range, false);
-            for (; range_gen->non_empty(); ++range_gen) {
-                const ResourceAccessRange subresource_range = *range_gen;
-                batch->OnResourceDestroyed(subresource_range);
-            }
-            batch->Trim();
-        };
-        ForAllQueueBatchContexts(batch_op);
+        // The ranges are taken now, the image state is gone by the time a deferred update runs
+        std::vector<ResourceAccessRange> subresource_ranges;
+        const auto &sub_state = syncval_state::SubState(*image_state);
+        for (ImageRangeGen range_gen = sub_state.MakeImageRangeGen(image_state->full_range, false); range_gen->non_empty();
+             ++range_gen) {
+            subresource_ranges.emplace_back(*range_gen);
+        }
+        RecordBatchStateUpdate([this, subresource_ranges = std::move(subresource_ranges)]() {
+            auto batch_op = [&subresource_ranges](const QueueBatchContext::Ptr &batch) {
+                for (const ResourceAccessRange &subresource_range : subresource_ranges) {
+                    batch->OnResourceDestroyed(subresource_range);
+                }
+                batch->Trim();
+            };
+            ForAllQueueBatchContexts(batch_op);
+        });
     }
     BaseClass::PreCallRecordDestroyImage(device, image, pAllocator, record_obj);
 }
@@ -757,6 +782,12 @@ void SyncValidator::FinishDeviceSetup(const VkDeviceCreateInfo *pCreateInfo, con
 
 void SyncValidator::PreCallRecordDestroyDevice(VkDevice device, const VkAllocationCallbacks *pAllocator,
                                                const RecordObject &record_obj) {
+    // Pending async submit validation still reports its errors
+    async_submit_worker_.Shutdown();
+    if (!syncval_settings.stats_file.empty()) {
+        std::lock_guard lock_guard(queue_submit_mutex_);
+        UpdateStatsFile(true);
+    }
     queue_sync_states_.clear();
     binary_signals_.clear();
     timeline_signals_.clear();
@@ -769,11 +800,17 @@ void SyncValidator::PostCallRecordCreateSemaphore(VkDevice device, const VkSemap
                                                   const RecordObject &record_obj) {
     BaseClass::PostCallRecordCreateSemaphore(device, pCreateInfo, pAllocator, pSemaphore, record_obj);
     if (record_obj.result != VK_SUCCESS) return;
+#ifndef NDEBUG
+    // The async submit worker updates the signals under the submit lock
+    std::lock_guard lock_guard(queue_submit_mutex_);
     assert(!vvl::Contains(timeline_signals_, *pSemaphore));
+#endif
 }
 
 void SyncValidator::PreCallRecordDestroySemaphore(VkDevice device, VkSemaphore semaphore, const VkAllocationCallbacks *pAllocator,
                                                   const RecordObject &record_obj) {
+    // Async submit validation looks semaphores up by handle, the submits using this one must be done first
+    WaitForAsyncSubmits();
     if (auto sem_state = Get<vvl::Semaphore>(semaphore); sem_state && (sem_state->type == VK_SEMAPHORE_TYPE_TIMELINE)) {
         if (auto it = timeline_signals_.find(semaphore); it != timeline_signals_.end()) {
             stats.RemoveTimelineSignals((uint32_t)it->second.size());
@@ -3089,34 +3126,38 @@ void SyncValidator::PostCallRecordQueueWaitIdle(VkQueue queue, const RecordObjec
     }
     const auto queue_state = GetQueueSyncStateShared(queue);
     if (!queue_state) return;  // Invalid queue
-    QueueId waited_queue = queue_state->GetQueueId();
-    ApplyTaggedWait(waited_queue, ResourceUsageRecord::kMaxIndex);
-
-    // For each timeline, remove all signals signaled on the waited queue, except the last one.
-    // The last signal is needed to represent the current timeline state.
-    EnsureTimelineSignalsLimit(1, waited_queue);
-
-    // Eliminate host waitable objects from the current queue.
-    vvl::EraseIf(waitable_fences_, [waited_queue](const auto &sf) { return sf.second.queue_id == waited_queue; });
-    for (auto &[semaphore, sync_points] : host_waitable_semaphores_) {
-        vvl::EraseIf(sync_points, [waited_queue](const auto &sync_point) { return sync_point.queue_id == waited_queue; });
-    }
+    const QueueId waited_queue = queue_state->GetQueueId();
+    RecordBatchStateUpdate([this, waited_queue]() {
+        ApplyTaggedWait(waited_queue, ResourceUsageRecord::kMaxIndex);
+
+        // For each timeline, remove all signals signaled on the waited queue, except the last one.
+        // The last signal is needed to represent the current timeline state.
+        EnsureTimelineSignalsLimit(1, waited_queue);
+
+        // Eliminate host waitable objects from the current queue.
+        vvl::EraseIf(waitable_fences_, [waited_queue](const auto &sf) { return sf.second.queue_id == waited_queue; });
+        for (auto &[semaphore, sync_points] : host_waitable_semaphores_) {
+            vvl::EraseIf(sync_points, [waited_queue](const auto &sync_point) { return sync_point.queue_id == waited_queue; });
+        }
+    });
 }
 
 void SyncValidator::PostCallRecordDeviceWaitIdle(VkDevice device, const RecordObject &record_obj) {
     BaseClass::PostCallRecordDeviceWaitIdle(device, record_obj);
 
-    // We need to treat this a fence waits for all queues... noting that present engine ops will be preserved.
-    ForAllQueueBatchContexts(
-        [](const QueueBatchContext::Ptr &batch) { batch->ApplyTaggedWait(kQueueAny, ResourceUsageRecord::kMaxIndex); });
+    RecordBatchStateUpdate([this]() {
+        // We need to treat this a fence waits for all queues... noting that present engine ops will be preserved.
+        ForAllQueueBatchContexts(
+            [](const QueueBatchContext::Ptr &batch) { batch->ApplyTaggedWait(kQueueAny, ResourceUsageRecord::kMaxIndex); });
 
-    // For each timeline keep only the last signal per queue.
-    // The last signal is needed to represent the current timeline state.
-    EnsureTimelineSignalsLimit(1);
+        // For each timeline keep only the last signal per queue.
+        // The last signal is needed to represent the current timeline state.
+        EnsureTimelineSignalsLimit(1);
 
-    // As we we've waited for everything on device, any waits are mooted. (except for acquires)
-    vvl::EraseIf(waitable_fences_, [](const auto &waitable) { return waitable.second.acquired.Invalid(); });
-    host_waitable_semaphores_.clear();
+        // As we we've waited for everything on device, any waits are mooted. (except for acquires)
+        vvl::EraseIf(waitable_fences_, [](const auto &waitable) { return waitable.second.acquired.Invalid(); });
+        host_waitable_semaphores_.clear();
+    });
 }
 
 struct QueuePresentCmdState {
@@ -3133,6 +3174,7 @@ bool SyncValidator::PreCallValidateQueuePresentKHR(VkQueue queue, const VkPresen
     // Since this early return is above the TlsGuard, the Record phase must also be.
     if (!syncval_settings.submit_time_validation) return skip;
 
+    WaitForAsyncSubmits();
     ClearPending();
 
     vvl::TlsGuard<QueuePresentCmdState> cmd_state(&skip, *this);
@@ -3243,6 +3285,8 @@ void SyncValidator::RecordAcquireNextImageState(VkDevice device, VkSwapchainKHR
                                                 VkFence fence, uint32_t *pImageIndex, const RecordObject &record_obj) {
     if ((VK_SUCCESS != record_obj.result) && (VK_SUBOPTIMAL_KHR != record_obj.result)) return;
 
+    WaitForAsyncSubmits();
+
     // Get the image out of the presented list and create apppropriate fences/semaphores.
     auto swapchain_base = Get<vvl::Swapchain>(swapchain);
     if (vvl::StateObject::Invalid(swapchain_base)) return;  // Invalid acquire calls to be caught in CoreCheck/Parameter validation
@@ -3311,24 +3355,94 @@ bool SyncValidator::ValidateQueueSubmit(VkQueue queue, uint32_t submitCount, con
     // Since this early return is above the TlsGuard, the Record phase must also be.
     if (!syncval_settings.submit_time_validation) return skip;
 
+    if (syncval_settings.submit_time_validation_async) {
+        PostAsyncQueueSubmit(queue, submitCount, pSubmits, fence, error_obj);
+        return skip;
+    }
+
     std::lock_guard lock_guard(queue_submit_mutex_);
 
+    const auto queue_sync_state = GetQueueSyncStateShared(queue);
+    if (!queue_sync_state) return skip;  // Invalid Queue
+
+    std::vector<std::vector<CommandBufferConstPtr>> submit_command_buffers;
+    submit_command_buffers.reserve(submitCount);
+    for (uint32_t i = 0; i < submitCount; ++i) {
+        submit_command_buffers.emplace_back(GetCommandBuffers(*device_state, pSubmits[i]));
+    }
+    return ValidateAndRecordQueueSubmit(queue_sync_state, vvl::make_span(pSubmits, submitCount), submit_command_buffers, fence,
+                                        queue_sync_state->GetQueueState()->cmdbuf_label_stack, false, error_obj);
+}
+
+void SyncValidator::PostAsyncQueueSubmit(VkQueue queue, uint32_t submitCount, const VkSubmitInfo2 *pSubmits, VkFence fence,
+                                         const ErrorObject &error_obj) const {
+    auto queue_sync_state = GetQueueSyncStateShared(queue);
+    if (!queue_sync_state) return;  // Invalid Queue
+
+    // The submit infos only live for the duration of the call, and the queue label stack is updated as soon as it returns.
+    // Command buffers are looked up now, they can be freed once the host knows the submit is done, before the task ran.
+    std::vector<vku::safe_VkSubmitInfo2> submits;
+    std::vector<std::vector<CommandBufferConstPtr>> submit_command_buffers;
+    submits.reserve(submitCount);
+    submit_command_buffers.reserve(submitCount);
+    for (uint32_t i = 0; i < submitCount; ++i) {
+        submits.emplace_back(&pSubmits[i]);
+        submit_command_buffers.emplace_back(GetCommandBuffers(*device_state, pSubmits[i]));
+    }
+    std::vector<std::string> label_stack = queue_sync_state->GetQueueState()->cmdbuf_label_stack;
+    const vvl::Func command = error_obj.location.function;
+
+    // Re-recording or freeing the command buffers has to wait for the task to be done with them
+    std::vector<CommandBufferConstPtr> submitted_cbs;
+    for (const auto &command_buffers : submit_command_buffers) {
+        for (const auto &cb_state : command_buffers) {
+            if (cb_state) {
+                submitted_cbs.emplace_back(cb_state);
+            }
+        }
+    }
+
+    const uint64_t ticket = async_submit_worker_.Post(
+        [this, queue_sync_state, submits = std::move(submits), submit_command_buffers = std::move(submit_command_buffers), fence,
+         label_stack = std::move(label_stack), command]() {
+            std::vector<VkSubmitInfo2> submit_infos;
+            submit_infos.reserve(submits.size());
+            for (const auto &submit : submits) {
+                submit_infos.emplace_back(*submit.ptr());
+            }
+            const ErrorObject async_error_obj(command, queue_sync_state->Handle());
+            std::lock_guard lock_guard(queue_submit_mutex_);
+            // The submit has already been made, a hazard can't skip it, so the state is always recorded
+            ValidateAndRecordQueueSubmit(queue_sync_state, submit_infos, submit_command_buffers, fence, label_stack, true,
+                                         async_error_obj);
+        });
+
+    for (const auto &cb_state : submitted_cbs) {
+        syncval_state::SubState(*cb_state).SetAsyncSubmitTicket(ticket);
+    }
+}
+
+bool SyncValidator::ValidateAndRecordQueueSubmit(const std::shared_ptr<const QueueSyncState> &queue_sync_state,
+                                                 vvl::span<const VkSubmitInfo2> submits,
+                                                 const std::vector<std::vector<CommandBufferConstPtr>> &submit_command_buffers,
+                                                 VkFence fence,
+                                                 std::vector<std::string> current_label_stack, bool record_on_skip,
+                                                 const ErrorObject &error_obj) const {
+    const auto start_time = std::chrono::steady_clock::now();
+    bool skip = false;
+
     ClearPending();
 
     QueueSubmitCmdState cmd_state_obj(*this);
     QueueSubmitCmdState* cmd_state = &cmd_state_obj;
+    cmd_state->queue = queue_sync_state;
 
-    cmd_state->queue = GetQueueSyncStateShared(queue);
-    if (!cmd_state->queue) return skip;  // Invalid Queue
-
-    auto &queue_sync_state = cmd_state->queue;
     SignalsUpdate &signals_update = cmd_state->signals_update;
 
     // The submit id is a mutable automic which is not recoverable on a skip == true condition
     uint64_t submit_id = queue_sync_state->ReserveSubmitId();
 
-    // Update label stack as we progress through batches and command buffers
-    auto current_label_stack = queue_sync_state->GetQueueState()->cmdbuf_label_stack;
+    // current_label_stack is updated as we progress through batches and command buffers
 
     BatchContextConstPtr last_batch = queue_sync_state->LastBatch();
     bool has_unresolved_batches = !queue_sync_state->UnresolvedBatches().empty();
@@ -3337,8 +3451,8 @@ bool SyncValidator::ValidateQueueSubmit(VkQueue queue, uint32_t submitCount, con
     std::vector<UnresolvedBatch> new_unresolved_batches;
     bool new_timeline_signals = false;
 
-    for (uint32_t batch_idx = 0; batch_idx < submitCount; batch_idx++) {
-        const VkSubmitInfo2 &submit = pSubmits[batch_idx];
+    for (uint32_t batch_idx = 0; batch_idx < submits.size(); batch_idx++) {
+        const VkSubmitInfo2 &submit = submits[batch_idx];
         auto batch = std::make_shared<QueueBatchContext>(*this, *queue_sync_state);
 
         const auto wait_semaphores = vvl::make_span(submit.pWaitSemaphoreInfos, submit.waitSemaphoreInfoCount);
@@ -3351,7 +3465,7 @@ bool SyncValidator::ValidateQueueSubmit(VkQueue queue, uint32_t submitCount, con
             unresolved_batch.batch = std::move(batch);
             unresolved_batch.submit_index = submit_id;
             unresolved_batch.batch_index = batch_idx;
-            unresolved_batch.command_buffers = GetCommandBuffers(*device_state, submit);
+            unresolved_batch.command_buffers = submit_command_buffers[batch_idx];
             unresolved_batch.unresolved_waits = std::move(unresolved_waits);
             unresolved_batch.resolved_dependencies = std::move(resolved_batches);
             if (submit.pSignalSemaphoreInfos && submit.signalSemaphoreInfoCount) {
@@ -3377,8 +3491,7 @@ bool SyncValidator::ValidateQueueSubmit(VkQueue queue, uint32_t submitCount, con
         // TODO: All syncval tests pass when the return value is ignored. Write a regression test that fails/crashes in this case.
         const auto async_batches = batch->RegisterAsyncContexts(resolved_batches);
 
-        const auto command_buffers = GetCommandBuffers(*device_state, submit);
-        skip |= batch->ValidateSubmit(command_buffers, submit_id, batch_idx, current_label_stack, error_obj);
+        skip |= batch->ValidateSubmit(submit_command_buffers[batch_idx], submit_id, batch_idx, current_label_stack, error_obj);
 
         const auto submit_signals = vvl::make_span(submit.pSignalSemaphoreInfos, submit.signalSemaphoreInfoCount);
         new_timeline_signals |= signals_update.RegisterSignals(batch, submit_signals);
@@ -3403,14 +3516,49 @@ bool SyncValidator::ValidateQueueSubmit(VkQueue queue, uint32_t submitCount, con
         skip |= PropagateTimelineSignals(signals_update, error_obj);
     }
 
-    if (!skip) {
-        const_cast<SyncValidator *>(this)->RecordQueueSubmit(queue, fence, cmd_state);
+    if (!skip || record_on_skip) {
+        const_cast<SyncValidator *>(this)->RecordQueueSubmit(queue_sync_state->GetQueueState()->VkHandle(), fence, cmd_state);
+    }
+
+    stats.AddSubmitValidation(std::chrono::steady_clock::now() - start_time);
+    if (!syncval_settings.stats_file.empty()) {
+        UpdateStatsFile(false);
     }
 
     // Note that if we skip, guard cleans up for us, but cannot release the reserved tag range
     return skip;
 }
 
+void SyncValidator::UpdateStatsFile(bool force) const {
+    const auto now = std::chrono::steady_clock::now();
+    if (!force && (now - stats_file_update_time_) < std::chrono::seconds(syncval_settings.stats_file_period)) {
+        return;
+    }
+    stats_file_update_time_ = now;
+
+    std::vector<syncval_stats::QueueBatchStats> queues;
+    for (const auto &queue_sync_state : queue_sync_states_) {
+        if (const auto last_batch = queue_sync_state->LastBatch()) {
+            queues.emplace_back(last_batch->GetStats());
+        }
+    }
+    const std::string report = stats.CreateJsonReport(queues);
+
+    // Readers polling the file during a long run never see it half written
+    const std::filesystem::path path(syncval_settings.stats_file);
+    std::filesystem::path tmp_path = path;
+    tmp_path += ".tmp";
+    {
+        std::ofstream file(tmp_path, std::ios::out | std::ios::trunc);
+        if (!file) {
+            return;
+        }
+        file << report;
+    }
+    std::error_code error;
+    std::filesystem::rename(tmp_path, path, error);
+}
+
 bool SyncValidator::PropagateTimelineSignals(SignalsUpdate &signals_update, const ErrorObject &error_obj) const {
     bool skip = false;
     // Initialize per-queue unresolved batches state.
@@ -3551,7 +3699,7 @@ void SyncValidator::PostCallRecordGetFenceStatus(VkDevice device, VkFence fence,
     if (!syncval_settings.submit_time_validation) return;
     if (record_obj.result == VK_SUCCESS) {
         // fence is signalled, mark it as waited for
-        WaitForFence(fence);
+        RecordBatchStateUpdate([this, fence]() { WaitForFence(fence); });
     }
 }
 
@@ -3561,9 +3709,11 @@ void SyncValidator::PostCallRecordWaitForFences(VkDevice device, uint32_t fenceC
     if (!syncval_settings.submit_time_validation) return;
     if ((record_obj.result == VK_SUCCESS) && ((VK_TRUE == waitAll) || (1 == fenceCount))) {
         // We can only know the pFences have signal if we waited for all of them, or there was only one of them
-        for (uint32_t i = 0; i < fenceCount; i++) {
-            WaitForFence(pFences[i]);
-        }
+        RecordBatchStateUpdate([this, fences = std::vector<VkFence>(pFences, pFences + fenceCount)]() {
+            for (VkFence fence : fences) {
+                WaitForFence(fence);
+            }
+        });
     }
 }
 
@@ -3573,6 +3723,7 @@ bool SyncValidator::PreCallValidateSignalSemaphore(VkDevice device, const VkSema
     if (!syncval_settings.submit_time_validation) {
         return skip;
     }
+    WaitForAsyncSubmits();
     ClearPending();
     vvl::TlsGuard<QueueSubmitCmdState> cmd_state(&skip, *this);
     SignalsUpdate &signals_update = cmd_state->signals_update;
@@ -3633,9 +3784,16 @@ void SyncValidator::PostCallRecordWaitSemaphores(VkDevice device, const VkSemaph
     }
     const bool wait_all = pWaitInfo->semaphoreCount == 1 || (pWaitInfo->flags & VK_SEMAPHORE_WAIT_ANY_BIT) == 0;
     if (record_obj.result == VK_SUCCESS && wait_all) {
+        std::vector<std::pair<VkSemaphore, uint64_t>> waits;
+        waits.reserve(pWaitInfo->semaphoreCount);
         for (uint32_t i = 0; i < pWaitInfo->semaphoreCount; i++) {
-            WaitForSemaphore(pWaitInfo->pSemaphores[i], pWaitInfo->pValues[i]);
+            waits.emplace_back(pWaitInfo->pSemaphores[i], pWaitInfo->pValues[i]);
         }
+        RecordBatchStateUpdate([this, waits = std::move(waits)]() {
+            for (const auto &[semaphore, value] : waits) {
+                WaitForSemaphore(semaphore, value);
+            }
+        });
     }
 }
 
@@ -3651,7 +3809,7 @@ void SyncValidator::PostCallRecordGetSemaphoreCounterValue(VkDevice device, VkSe
         return;
     }
     if (record_obj.result == VK_SUCCESS) {
-        WaitForSemaphore(semaphore, *pValue);
+        RecordBatchStateUpdate([this, semaphore, value = *pValue]() { WaitForSemaphore(semaphore, value); });
     }
 }
 
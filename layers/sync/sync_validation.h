@@ -64,6 +64,11 @@ class SyncValidator : public vvl::DeviceProxy, public SyncStageAccess {
     QueueId queue_id_limit_ = 0;
 
     mutable std::mutex queue_submit_mutex_;
+    // Only used with syncval_stats_file, protected by queue_submit_mutex_
+    mutable std::chrono::steady_clock::time_point stats_file_update_time_;
+
+    // Only used with syncval_submit_time_validation_async
+    mutable AsyncSubmitWorker async_submit_worker_;
 
     // Semaphore signal registry
     vvl::unordered_map<VkSemaphore, SignalInfo> binary_signals_;
@@ -102,6 +107,12 @@ class SyncValidator : public vvl::DeviceProxy, public SyncStageAccess {
     bool ProcessUnresolvedBatch(UnresolvedBatch &unresolved_batch, SignalsUpdate &signals_update, BatchContextPtr &last_batch,
                                 bool &skip, const ErrorObject &error_obj) const;
 
+    // Changes to the batch state made outside of queue submit. With async submit validation they are queued behind the
+    // submits posted so far (the host has seen those complete, the worker may not have replayed them yet).
+    void RecordBatchStateUpdate(std::function<void()> &&update);
+    // Wait for async submit validation to catch up before reading the batch state
+    void WaitForAsyncSubmits() const;
+
     void ApplyTaggedWait(QueueId queue_id, ResourceUsageTag tag);
     void ApplyAcquireWait(const AcquiredImage &acquired);
 
@@ -602,7 +613,17 @@ class SyncValidator : public vvl::DeviceProxy, public SyncStageAccess {
                              const ErrorObject &error_obj) const;
     bool PreCallValidateQueueSubmit(VkQueue queue, uint32_t submitCount, const VkSubmitInfo *pSubmits, VkFence fence,
                                     const ErrorObject &error_obj) const override;
+    // submit_command_buffers holds the command buffers of each submit (same indexing as VkSubmitInfo2::pCommandBufferInfos)
+    bool ValidateAndRecordQueueSubmit(const std::shared_ptr<const QueueSyncState> &queue_sync_state,
+                                      vvl::span<const VkSubmitInfo2> submits,
+                                      const std::vector<std::vector<CommandBufferConstPtr>> &submit_command_buffers,
+                                      VkFence fence, std::vector<std::string> current_label_stack, bool record_on_skip,
+                                      const ErrorObject &error_obj) const;
+    void PostAsyncQueueSubmit(VkQueue queue, uint32_t submitCount, const VkSubmitInfo2 *pSubmits, VkFence fence,
+                              const ErrorObject &error_obj) const;
     void RecordQueueSubmit(VkQueue queue, VkFence fence, QueueSubmitCmdState *cmd_state);
+    // Rewrite the syncval_stats_file report when its period has elapsed (or force). Called with queue_submit_mutex_ held.
+    void UpdateStatsFile(bool force) const;
     bool PreCallValidateQueueSubmit2KHR(VkQueue queue, uint32_t submitCount, const VkSubmitInfo2KHR *pSubmits, VkFence fence,
                                         const ErrorObject &error_obj) const override;
     bool PreCallValidateQueueSubmit2(VkQueue queue, uint32_t submitCount, const VkSubmitInfo2 *pSubmits, VkFence fence,
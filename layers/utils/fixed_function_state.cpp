@@ -0,0 +1,176 @@
+/* Copyright (c) 2025 The Khronos Group Inc.
+ * Copyright (c) 2025 Valve Corporation
+ * Copyright (c) 2025 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "utils/fixed_function_state.h"
+#include "utils/hash_util.h"
+
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+
+namespace {
+// The fixed function state of pipelines is very often identical between pipelines (large PSO sets tend to differ in shaders and
+// specialization constants only), so the copies held by the sub states are interned and shared.
+// Only states without a pNext chain are interned, the rest is rare enough to not be worth the comparison.
+// Floats are compared by bits so a NaN can't make an entry that never matches.
+// The functors also take the Vulkan structs, so a state is only deep copied into a safe struct when it is not interned yet.
+template <typename T>
+bool SameBits(const T &lhs, const T &rhs) {
+    return std::memcmp(&lhs, &rhs, sizeof(T)) == 0;
+}
+
+template <typename T>
+size_t HashBits(const T &value) {
+    return hash_util::Hash64(&value, sizeof(T));
+}
+
+struct ColorBlendStateHash {
+    template <typename CreateInfo>
+    size_t operator()(const CreateInfo &value) const {
+        hash_util::HashCombiner hc;
+        hc << value.flags << value.logicOpEnable << value.logicOp << value.attachmentCount << HashBits(value.blendConstants);
+        if (value.pAttachments) {
+            for (uint32_t i = 0; i < value.attachmentCount; ++i) {
+                hc << HashBits(value.pAttachments[i]);
+            }
+        }
+        return hc.Value();
+    }
+};
+
+struct ColorBlendStateEqual {
+    template <typename CreateInfo>
+    bool operator()(const vku::safe_VkPipelineColorBlendStateCreateInfo &lhs, const CreateInfo &rhs) const {
+        if (lhs.flags != rhs.flags || lhs.logicOpEnable != rhs.logicOpEnable || lhs.logicOp != rhs.logicOp ||
+            lhs.attachmentCount != rhs.attachmentCount || !SameBits(lhs.blendConstants, rhs.blendConstants) ||
+            !hash_util::SimilarForNullity(lhs.pAttachments, rhs.pAttachments)) {
+            return false;
+        }
+        if (lhs.pAttachments) {
+            for (uint32_t i = 0; i < lhs.attachmentCount; ++i) {
+                if (!SameBits(lhs.pAttachments[i], rhs.pAttachments[i])) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+};
+
+template <typename CreateInfo>
+uint32_t SampleMaskWords(const CreateInfo &value) {
+    return (static_cast<uint32_t>(value.rasterizationSamples) + 31) / 32;
+}
+
+struct MultisampleStateHash {
+    template <typename CreateInfo>
+    size_t operator()(const CreateInfo &value) const {
+        hash_util::HashCombiner hc;
+        hc << value.flags << value.rasterizationSamples << value.sampleShadingEnable << HashBits(value.minSampleShading)
+           << value.alphaToCoverageEnable << value.alphaToOneEnable;
+        if (value.pSampleMask) {
+            hc.Combine(value.pSampleMask, value.pSampleMask + SampleMaskWords(value));
+        }
+        return hc.Value();
+    }
+};
+
+struct MultisampleStateEqual {
+    template <typename CreateInfo>
+    bool operator()(const vku::safe_VkPipelineMultisampleStateCreateInfo &lhs, const CreateInfo &rhs) const {
+        if (lhs.flags != rhs.flags || lhs.rasterizationSamples != rhs.rasterizationSamples ||
+            lhs.sampleShadingEnable != rhs.sampleShadingEnable || !SameBits(lhs.minSampleShading, rhs.minSampleShading) ||
+            lhs.alphaToCoverageEnable != rhs.alphaToCoverageEnable || lhs.alphaToOneEnable != rhs.alphaToOneEnable ||
+            !hash_util::SimilarForNullity(lhs.pSampleMask, rhs.pSampleMask)) {
+            return false;
+        }
+        return !lhs.pSampleMask || std::equal(lhs.pSampleMask, lhs.pSampleMask + SampleMaskWords(lhs), rhs.pSampleMask);
+    }
+};
+
+struct DepthStencilStateHash {
+    template <typename CreateInfo>
+    size_t operator()(const CreateInfo &value) const {
+        hash_util::HashCombiner hc;
+        hc << value.flags << value.depthTestEnable << value.depthWriteEnable << value.depthCompareOp << value.depthBoundsTestEnable
+           << value.stencilTestEnable << HashBits(value.front) << HashBits(value.back) << HashBits(value.minDepthBounds)
+           << HashBits(value.maxDepthBounds);
+        return hc.Value();
+    }
+};
+
+struct DepthStencilStateEqual {
+    template <typename CreateInfo>
+    bool operator()(const vku::safe_VkPipelineDepthStencilStateCreateInfo &lhs, const CreateInfo &rhs) const {
+        return lhs.flags == rhs.flags && lhs.depthTestEnable == rhs.depthTestEnable &&
+               lhs.depthWriteEnable == rhs.depthWriteEnable && lhs.depthCompareOp == rhs.depthCompareOp &&
+               lhs.depthBoundsTestEnable == rhs.depthBoundsTestEnable && lhs.stencilTestEnable == rhs.stencilTestEnable &&
+               SameBits(lhs.front, rhs.front) && SameBits(lhs.back, rhs.back) && SameBits(lhs.minDepthBounds, rhs.minDepthBounds) &&
+               SameBits(lhs.maxDepthBounds, rhs.maxDepthBounds);
+    }
+};
+
+using ColorBlendStateDict =
+    hash_util::Dictionary<vku::safe_VkPipelineColorBlendStateCreateInfo, ColorBlendStateHash, ColorBlendStateEqual>;
+using MultisampleStateDict =
+    hash_util::Dictionary<vku::safe_VkPipelineMultisampleStateCreateInfo, MultisampleStateHash, MultisampleStateEqual>;
+using DepthStencilStateDict =
+    hash_util::Dictionary<vku::safe_VkPipelineDepthStencilStateCreateInfo, DepthStencilStateHash, DepthStencilStateEqual>;
+
+ColorBlendStateDict color_blend_state_dict;
+MultisampleStateDict multisample_state_dict;
+DepthStencilStateDict depth_stencil_state_dict;
+
+// Value is either a safe struct or the Vulkan struct it is made from
+template <typename Dict, typename Value>
+std::shared_ptr<const typename Dict::Def> Intern(Dict &dict, const Value &value) {
+    using Def = typename Dict::Def;
+    if (!value.pNext) {
+        return dict.LookUp(value);
+    }
+    if constexpr (std::is_same_v<Value, Def>) {
+        return std::make_shared<const Def>(value);
+    } else {
+        return std::make_shared<const Def>(&value);
+    }
+}
+}  // namespace
+
+std::shared_ptr<const vku::safe_VkPipelineColorBlendStateCreateInfo> ToSafeColorBlendState(
+    const vku::safe_VkPipelineColorBlendStateCreateInfo &cbs) {
+    return Intern(color_blend_state_dict, cbs);
+}
+std::shared_ptr<const vku::safe_VkPipelineColorBlendStateCreateInfo> ToSafeColorBlendState(
+    const VkPipelineColorBlendStateCreateInfo &cbs) {
+    return Intern(color_blend_state_dict, cbs);
+}
+std::shared_ptr<const vku::safe_VkPipelineMultisampleStateCreateInfo> ToSafeMultisampleState(
+    const vku::safe_VkPipelineMultisampleStateCreateInfo &cbs) {
+    return Intern(multisample_state_dict, cbs);
+}
+std::shared_ptr<const vku::safe_VkPipelineMultisampleStateCreateInfo> ToSafeMultisampleState(
+    const VkPipelineMultisampleStateCreateInfo &cbs) {
+    return Intern(multisample_state_dict, cbs);
+}
+std::shared_ptr<const vku::safe_VkPipelineDepthStencilStateCreateInfo> ToSafeDepthStencilState(
+    const vku::safe_VkPipelineDepthStencilStateCreateInfo &cbs) {
+    return Intern(depth_stencil_state_dict, cbs);
+}
+std::shared_ptr<const vku::safe_VkPipelineDepthStencilStateCreateInfo> ToSafeDepthStencilState(
+    const VkPipelineDepthStencilStateCreateInfo &cbs) {
+    return Intern(depth_stencil_state_dict, cbs);
+}
@@ -47,4 +47,6 @@ uint64_t Hash64(const void *info, const size_t info_size) {
     return XXH64(info, info_size, seed);
 }
 
+uint64_t Hash64(const void *info, const size_t info_size, uint64_t seed) { return XXH64(info, info_size, seed); }
+
 }  // namespace hash_util
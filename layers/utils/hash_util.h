@@ -26,6 +26,7 @@
 #include <type_traits>
 #include <vector>
 #include "containers/custom_containers.h"
+#include "containers/small_vector.h"
 
 // Hash and equality utilities for supporting hashing containers (e.g. unordered_set, unordered_map)
 namespace hash_util {
@@ -121,9 +122,9 @@ struct IsOrderedContainer {
 //       execution.
 //
 // The entries of the dictionary are shared_pointers (the contents of
-// which are invariant with resize/insert), with the hash and equality
-// template arguments wrapped in a shared pointer dereferencing
-// function object
+// which are invariant with resize/insert), bucketed by the hash of
+// their value, so a value can be looked up without first being copied
+// into a new entry.
 template <typename T, typename Hasher = vvl::hash<T>, typename KeyEqual = std::equal_to<T>>
 class Dictionary {
   public:
@@ -131,27 +132,54 @@ class Dictionary {
     using Id = std::shared_ptr<const Def>;
 
     // Find the unique entry match the provided value, adding if needed
+    // The value is only copied (or moved) in when there is no match. It can also be a Vulkan struct when T is its safe struct,
+    // as long as Hasher and KeyEqual take it and hash it the same way as the safe struct made from it.
     // TODO: segregate lookup from insert, using reader/write locks to reduce contention -- if needed
     template <typename U = T>
     Id LookUp(U &&value) {
-        // We create an Id from the value, which will either be retained by dict (if new) or deleted on return (if extant)
-        Id from_input = std::make_shared<T>(std::forward<U>(value));
-
-        // Insert takes care of the "unique" id part by rejecting the insert if a key matching by_value exists, but returning us
-        // the Id of the extant shared_pointer(id->def) instead.
-        // return the value of the Iterator from the <Iterator, bool> pair returned by insert
-        Guard g(lock);  // Dict isn't thread safe, and use is presumed to be multi-threaded
-        return *dict.insert(from_input).first;
+        {
+            Guard g(lock);  // Dict isn't thread safe, and use is presumed to be multi-threaded
+            if (Id found = Find(value)) {
+                return found;
+            }
+        }
+        Id from_input = MakeDef(std::forward<U>(value));
+
+        Guard g(lock);
+        // Another thread can have added it since, and the def made from a Vulkan struct can normalize into an extant entry
+        if (Id found = Find(*from_input)) {
+            return found;
+        }
+        dict[Hasher()(*from_input)].emplace_back(from_input);
+        return from_input;
     }
 
   private:
-    struct HashKeyValue {
-        size_t operator()(const Id &value) const { return Hasher()(*value); }
-    };
-    struct KeyValueEqual {
-        bool operator()(const Id &lhs, const Id &rhs) const { return KeyEqual()(*lhs, *rhs); }
-    };
-    using Dict = vvl::unordered_set<Id, HashKeyValue, KeyValueEqual>;
+    template <typename U>
+    Id Find(const U &value) const {
+        auto bucket = dict.find(Hasher()(value));
+        if (bucket != dict.end()) {
+            for (const Id &entry : bucket->second) {
+                if (KeyEqual()(*entry, value)) {
+                    return entry;
+                }
+            }
+        }
+        return nullptr;
+    }
+
+    template <typename U>
+    static Id MakeDef(U &&value) {
+        if constexpr (std::is_constructible_v<T, U &&>) {
+            return std::make_shared<T>(std::forward<U>(value));
+        } else {
+            // Safe structs are made from a pointer to the Vulkan struct
+            return std::make_shared<T>(&value);
+        }
+    }
+
+    // Entries with the same hash but different values share a bucket
+    using Dict = vvl::unordered_map<size_t, small_vector<Id, 1, uint32_t>>;
     using Lock = std::mutex;
     using Guard = std::lock_guard<Lock>;
     Lock lock;
@@ -164,4 +192,6 @@ uint32_t Hash32(const void *info, const size_t info_size);
 
 uint64_t Hash64(const void *info, const size_t info_size);
 
+uint64_t Hash64(const void *info, const size_t info_size, uint64_t seed);
+
 }  // namespace hash_util
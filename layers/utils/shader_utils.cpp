@@ -19,6 +19,7 @@
 
 #include "shader_utils.h"
 
+#include "chassis/dispatch_object.h"
 #include "generated/device_features.h"
 #include "generated/vk_api_version.h"
 #include "generated/vk_extension_helper.h"
@@ -26,7 +27,23 @@
 
 #include "generated/spirv_tools_commit_id.h"
 
+#include <algorithm>
+#include <cstddef>
 #include <fstream>
+#include <iterator>
+#include <sstream>
+
+#if defined(__linux__) || defined(__FreeBSD__) || defined(__OpenBSD__) || defined(__GNU__) || defined(__APPLE__)
+#define VVL_VALIDATION_CACHE_FILE_LOCKING
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Bump when the layout of the data after the header changes, old blobs will then be rejected by the UUID check
+static constexpr uint32_t kValidationCacheFormatVersion = 2;
 
 void ValidationCache::GetUUID(uint8_t *uuid) {
     const char *sha1_str = SPIRV_TOOLS_COMMIT_ID;
@@ -47,12 +64,41 @@ void ValidationCache::GetUUID(uint8_t *uuid) {
         uuid[i] = static_cast<uint8_t>(std::strtoul(byte_str, nullptr, 16));
     }
 
-    // Replace the last 4 bytes (likely padded with zero anyway)
+    // Replace the last 8 bytes with the format version and the spirv-val options
+    std::memcpy(uuid + (VK_UUID_SIZE - 2 * sizeof(uint32_t)), &kValidationCacheFormatVersion, sizeof(uint32_t));
     std::memcpy(uuid + (VK_UUID_SIZE - sizeof(uint32_t)), &spirv_val_option_hash_, sizeof(uint32_t));
 }
 
+ValidationCache::Key ValidationCache::MakeKey(const uint32_t *code, size_t code_size) const {
+    return hash_util::Hash64(code, code_size, device_state_hash_);
+}
+
+ValidationCache::Entry ValidationCache::MakeEntry(Key key, uint32_t passed_checks) {
+    Entry entry{key, passed_checks, 0};
+    entry.checksum = hash_util::Hash32(&entry, offsetof(Entry, checksum));
+    return entry;
+}
+
+void ValidationCache::Insert(Key key, uint32_t checks) {
+    Entry entry;
+    std::shared_ptr<ValidationCacheFile> log;
+    {
+        auto guard = WriteLock();
+        uint32_t &passed_checks = good_shaders_[key];
+        if ((passed_checks & checks) == checks) {
+            return;
+        }
+        passed_checks |= checks;
+        entry = MakeEntry(key, passed_checks);
+        log = log_;
+    }
+    if (log) {
+        log->Append(entry);
+    }
+}
+
 void ValidationCache::Load(VkValidationCacheCreateInfoEXT const *pCreateInfo) {
-    const auto headerSize = 2 * sizeof(uint32_t) + VK_UUID_SIZE;
+    const auto headerSize = kHeaderSize;
     auto size = headerSize;
     if (!pCreateInfo->pInitialData || pCreateInfo->initialDataSize < size) return;
 
@@ -63,18 +109,25 @@ void ValidationCache::Load(VkValidationCacheCreateInfoEXT const *pCreateInfo) {
     GetUUID(expected_uuid);
     if (memcmp(&data[2], expected_uuid, VK_UUID_SIZE) != 0) return;  // different version
 
-    data = (uint32_t const *)(reinterpret_cast<uint8_t const *>(data) + headerSize);
+    const uint8_t *entry_data = reinterpret_cast<uint8_t const *>(data) + headerSize;
 
     auto guard = WriteLock();
-    for (; size < pCreateInfo->initialDataSize; data++, size += sizeof(uint32_t)) {
-        good_shader_hashes_.insert(*data);
+    for (; size + sizeof(Entry) <= pCreateInfo->initialDataSize; entry_data += sizeof(Entry), size += sizeof(Entry)) {
+        // initial data has no alignment guarantee
+        Entry entry;
+        std::memcpy(&entry, entry_data, sizeof(Entry));
+        if (entry.checksum != MakeEntry(entry.key, entry.passed_checks).checksum) {
+            continue;
+        }
+        good_shaders_[entry.key] |= entry.passed_checks;
     }
 }
 
 void ValidationCache::Write(size_t *pDataSize, void *pData) {
-    const auto header_size = 2 * sizeof(uint32_t) + VK_UUID_SIZE;  // 4 bytes for header size + 4 bytes for version number + UUID
+    const auto header_size = kHeaderSize;
     if (!pData) {
-        *pDataSize = header_size + good_shader_hashes_.size() * sizeof(uint32_t);
+        auto guard = ReadLock();
+        *pDataSize = header_size + good_shaders_.size() * sizeof(Entry);
         return;
     }
 
@@ -90,13 +143,15 @@ void ValidationCache::Write(size_t *pDataSize, void *pData) {
     *out++ = header_size;
     *out++ = VK_VALIDATION_CACHE_HEADER_VERSION_ONE_EXT;
     GetUUID(reinterpret_cast<uint8_t *>(out));
-    out = (uint32_t *)(reinterpret_cast<uint8_t *>(out) + VK_UUID_SIZE);
+    uint8_t *entry_out = reinterpret_cast<uint8_t *>(out) + VK_UUID_SIZE;
 
     {
         auto guard = ReadLock();
-        for (auto it = good_shader_hashes_.begin(); it != good_shader_hashes_.end() && actual_size < *pDataSize;
-             it++, out++, actual_size += sizeof(uint32_t)) {
-            *out = *it;
+        // Only write whole entries
+        for (auto it = good_shaders_.begin(); it != good_shaders_.end() && actual_size + sizeof(Entry) <= *pDataSize;
+             it++, entry_out += sizeof(Entry), actual_size += sizeof(Entry)) {
+            const Entry entry = MakeEntry(it->first, it->second);
+            std::memcpy(entry_out, &entry, sizeof(Entry));
         }
     }
 
@@ -110,8 +165,256 @@ void ValidationCache::Merge(ValidationCache const *other) {
     }
     auto other_guard = other->ReadLock();
     auto guard = WriteLock();
-    good_shader_hashes_.reserve(good_shader_hashes_.size() + other->good_shader_hashes_.size());
-    for (auto h : other->good_shader_hashes_) good_shader_hashes_.insert(h);
+    good_shaders_.reserve(good_shaders_.size() + other->good_shaders_.size());
+    for (const auto &[key, passed_checks] : other->good_shaders_) good_shaders_[key] |= passed_checks;
+}
+
+ValidationCacheFile::~ValidationCacheFile() {
+#if defined(VVL_VALIDATION_CACHE_FILE_LOCKING)
+    if (fd_ >= 0) {
+        close(fd_);
+    }
+#endif
+}
+
+bool ValidationCacheFile::Attach(ValidationCache &cache) {
+    std::lock_guard<std::mutex> guard(lock_);
+    // An empty cache only has room for its header
+    header_.resize(ValidationCache::kHeaderSize);
+    size_t header_size = header_.size();
+    cache.Write(&header_size, header_.data());
+    std::stringstream path;
+    path << base_path_ << "-" << std::hex << hash_util::Hash32(header_.data(), header_.size()) << ".bin";
+    path_ = path.str();
+    RemoveStaleFiles();
+
+#if defined(VVL_VALIDATION_CACHE_FILE_LOCKING)
+    fd_ = open(path_.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+    if (fd_ < 0) {
+        return false;
+    }
+    flock(fd_, LOCK_EX);
+    bool result = ReopenIfReplaced();
+    if (result && !LoadFromFile(cache, nullptr)) {
+        // New file, or one left torn by a crash (different settings use a different file), start over
+        result = ftruncate(fd_, 0) == 0 && pwrite(fd_, header_.data(), header_.size(), 0) == ssize_t(header_.size());
+    }
+    if (!result) {
+        if (fd_ >= 0) {
+            close(fd_);
+        }
+        fd_ = -1;
+        return false;
+    }
+    // Marks the file as used, see RemoveStaleFiles
+    futimens(fd_, nullptr);
+    flock(fd_, LOCK_UN);
+    cache.SetLog(shared_from_this());
+    return true;
+#else
+    // Nothing to load from a missing file, it is created at Detach
+    LoadFromFile(cache, nullptr);
+    return true;
+#endif
+}
+
+bool ValidationCacheFile::Detach(ValidationCache &cache) {
+    cache.SetLog(nullptr);
+    std::lock_guard<std::mutex> guard(lock_);
+#if defined(VVL_VALIDATION_CACHE_FILE_LOCKING)
+    if (fd_ < 0) {
+        return false;
+    }
+    flock(fd_, LOCK_EX);
+    bool result = ReopenIfReplaced();
+    if (result) {
+        // The pending entries are also in |cache|, but compaction below is skipped most of the time
+        FlushPending();
+        // Picks up what concurrent processes appended since Attach, so compacting doesn't drop it
+        size_t file_size = 0;
+        const bool loaded = LoadFromFile(cache, &file_size);
+        size_t compact_size = 0;
+        cache.Write(&compact_size, nullptr);
+        if (!loaded || file_size > 2 * compact_size) {
+            result = Replace(cache);
+        }
+    }
+    if (fd_ >= 0) {
+        flock(fd_, LOCK_UN);
+        close(fd_);
+        fd_ = -1;
+    }
+    return result;
+#else
+    // Picks up what other processes wrote since Attach, without a file lock a concurrent write can still be lost
+    LoadFromFile(cache, nullptr);
+    return Replace(cache);
+#endif
+}
+
+void ValidationCacheFile::Append(const ValidationCache::Entry &entry) {
+#if defined(VVL_VALIDATION_CACHE_FILE_LOCKING)
+    std::lock_guard<std::mutex> guard(lock_);
+    // Detached
+    if (fd_ < 0) {
+        return;
+    }
+    pending_.emplace_back(entry);
+    if (pending_.size() < kAppendBatchSize) {
+        return;
+    }
+    flock(fd_, LOCK_EX);
+    if (ReopenIfReplaced()) {
+        FlushPending();
+    }
+    if (fd_ >= 0) {
+        flock(fd_, LOCK_UN);
+    }
+#else
+    (void)entry;
+#endif
+}
+
+// Removes the cache files (and temp files left by a crash during compaction) of other settings that were not attached for
+// kStaleFileAge. A process still using one just recreates it.
+void ValidationCacheFile::RemoveStaleFiles() const {
+    const fs::path base_path(base_path_);
+    const std::string prefix = base_path.filename().string() + "-";
+    const auto stale_time = fs::file_time_type::clock::now() - kStaleFileAge;
+    std::error_code ec;
+    for (const auto &entry : fs::directory_iterator(base_path.parent_path(), ec)) {
+        const fs::path &path = entry.path();
+        const bool is_cache_file = path.filename().string().rfind(prefix, 0) == 0 &&
+                                   (path.extension() == ".bin" || path.extension() == ".tmp");
+        if (!is_cache_file || path == fs::path(path_)) {
+            continue;
+        }
+        const auto write_time = entry.last_write_time(ec);
+        if (!ec && write_time < stale_time) {
+            fs::remove(path, ec);
+        }
+    }
+}
+
+#if defined(VVL_VALIDATION_CACHE_FILE_LOCKING)
+// Must hold the file lock. Writes all the pending entries with a single pwrite.
+void ValidationCacheFile::FlushPending() {
+    if (pending_.empty()) {
+        return;
+    }
+    struct stat file_stat;
+    if (fstat(fd_, &file_stat) == 0) {
+        off_t end = file_stat.st_size;
+        // Someone removed the file
+        if (end == 0 && pwrite(fd_, header_.data(), header_.size(), 0) == ssize_t(header_.size())) {
+            end = header_.size();
+        }
+        // Don't append to a file owned by a process with different settings
+        if (end >= off_t(header_.size()) && HeaderMatches()) {
+            // Drop an entry torn by a process that crashed in the middle of appending it
+            const off_t aligned_end = end - (end - header_.size()) % sizeof(ValidationCache::Entry);
+            if (aligned_end == end || ftruncate(fd_, aligned_end) == 0) {
+                [[maybe_unused]] const ssize_t written =
+                    pwrite(fd_, pending_.data(), pending_.size() * sizeof(ValidationCache::Entry), aligned_end);
+            }
+        }
+    }
+    pending_.clear();
+}
+
+// Must hold the file lock. Compaction in another process renames a new file over |path_|, in which case the lock we hold is on a
+// file nobody will read anymore, so follow the rename.
+bool ValidationCacheFile::ReopenIfReplaced() {
+    while (fd_ >= 0) {
+        struct stat path_stat, fd_stat;
+        if (stat(path_.c_str(), &path_stat) == 0 && fstat(fd_, &fd_stat) == 0 && path_stat.st_dev == fd_stat.st_dev &&
+            path_stat.st_ino == fd_stat.st_ino) {
+            return true;
+        }
+        flock(fd_, LOCK_UN);
+        close(fd_);
+        fd_ = open(path_.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+        if (fd_ >= 0) {
+            flock(fd_, LOCK_EX);
+        }
+    }
+    return false;
+}
+
+bool ValidationCacheFile::HeaderMatches() const {
+    std::vector<uint8_t> file_header(header_.size());
+    return pread(fd_, file_header.data(), file_header.size(), 0) == ssize_t(file_header.size()) && file_header == header_;
+}
+
+// Must hold the file lock
+bool ValidationCacheFile::LoadFromFile(ValidationCache &cache, size_t *out_file_size) const {
+    struct stat file_stat;
+    if (fstat(fd_, &file_stat) != 0 || file_stat.st_size < off_t(header_.size())) {
+        return false;
+    }
+    const size_t file_size = static_cast<size_t>(file_stat.st_size);
+    void *data = mmap(nullptr, file_size, PROT_READ, MAP_SHARED, fd_, 0);
+    if (data == MAP_FAILED) {
+        return false;
+    }
+    const bool header_matches = std::memcmp(data, header_.data(), header_.size()) == 0;
+    if (header_matches) {
+        VkValidationCacheCreateInfoEXT create_info = {VK_STRUCTURE_TYPE_VALIDATION_CACHE_CREATE_INFO_EXT, nullptr, 0, file_size,
+                                                      data};
+        cache.Load(&create_info);
+    }
+    munmap(data, file_size);
+    if (out_file_size) {
+        *out_file_size = file_size;
+    }
+    return header_matches;
+}
+#else
+bool ValidationCacheFile::LoadFromFile(ValidationCache &cache, size_t *out_file_size) const {
+    std::ifstream read_file(path_.c_str(), std::ios::in | std::ios::binary);
+    if (!read_file) {
+        return false;
+    }
+    std::vector<char> data;
+    std::copy(std::istreambuf_iterator<char>(read_file), {}, std::back_inserter(data));
+    VkValidationCacheCreateInfoEXT create_info = {VK_STRUCTURE_TYPE_VALIDATION_CACHE_CREATE_INFO_EXT, nullptr, 0, data.size(),
+                                                  data.data()};
+    cache.Load(&create_info);
+    if (out_file_size) {
+        *out_file_size = data.size();
+    }
+    return data.size() >= header_.size() && std::memcmp(data.data(), header_.data(), header_.size()) == 0;
+}
+#endif
+
+// Writes the whole cache in a new file, then swaps it in
+bool ValidationCacheFile::Replace(ValidationCache &cache) {
+    size_t size = 0;
+    cache.Write(&size, nullptr);
+    std::vector<char> data(size);
+    cache.Write(&size, data.data());
+
+#if defined(VVL_VALIDATION_CACHE_FILE_LOCKING)
+    const std::string tmp_path = path_ + "." + std::to_string(getpid()) + ".tmp";
+    const int tmp_fd = open(tmp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+    if (tmp_fd < 0) {
+        return false;
+    }
+    const bool written = write(tmp_fd, data.data(), size) == ssize_t(size) && fsync(tmp_fd) == 0;
+    close(tmp_fd);
+    if (!written || rename(tmp_path.c_str(), path_.c_str()) != 0) {
+        unlink(tmp_path.c_str());
+        return false;
+    }
+    return true;
+#else
+    std::ofstream write_file(path_.c_str(), std::ios::out | std::ios::binary);
+    if (!write_file) {
+        return false;
+    }
+    write_file.write(data.data(), size);
+    return true;
+#endif
 }
 
 spv_target_env PickSpirvEnv(const APIVersion &api_version, bool spirv_1_4) {
@@ -186,6 +489,177 @@ void AdjustValidatorOptions(const DeviceExtensions &device_extensions, const Dev
     }
 }
 
+// VkPhysicalDeviceLimits has padding (after maxSamplerAllocationCount for one), so it can't be hashed as raw bytes
+static void CombineLimits(hash_util::HashCombiner &hc, const VkPhysicalDeviceLimits &limits) {
+    hc.Combine(limits.maxImageDimension1D);
+    hc.Combine(limits.maxImageDimension2D);
+    hc.Combine(limits.maxImageDimension3D);
+    hc.Combine(limits.maxImageDimensionCube);
+    hc.Combine(limits.maxImageArrayLayers);
+    hc.Combine(limits.maxTexelBufferElements);
+    hc.Combine(limits.maxUniformBufferRange);
+    hc.Combine(limits.maxStorageBufferRange);
+    hc.Combine(limits.maxPushConstantsSize);
+    hc.Combine(limits.maxMemoryAllocationCount);
+    hc.Combine(limits.maxSamplerAllocationCount);
+    hc.Combine(limits.bufferImageGranularity);
+    hc.Combine(limits.sparseAddressSpaceSize);
+    hc.Combine(limits.maxBoundDescriptorSets);
+    hc.Combine(limits.maxPerStageDescriptorSamplers);
+    hc.Combine(limits.maxPerStageDescriptorUniformBuffers);
+    hc.Combine(limits.maxPerStageDescriptorStorageBuffers);
+    hc.Combine(limits.maxPerStageDescriptorSampledImages);
+    hc.Combine(limits.maxPerStageDescriptorStorageImages);
+    hc.Combine(limits.maxPerStageDescriptorInputAttachments);
+    hc.Combine(limits.maxPerStageResources);
+    hc.Combine(limits.maxDescriptorSetSamplers);
+    hc.Combine(limits.maxDescriptorSetUniformBuffers);
+    hc.Combine(limits.maxDescriptorSetUniformBuffersDynamic);
+    hc.Combine(limits.maxDescriptorSetStorageBuffers);
+    hc.Combine(limits.maxDescriptorSetStorageBuffersDynamic);
+    hc.Combine(limits.maxDescriptorSetSampledImages);
+    hc.Combine(limits.maxDescriptorSetStorageImages);
+    hc.Combine(limits.maxDescriptorSetInputAttachments);
+    hc.Combine(limits.maxVertexInputAttributes);
+    hc.Combine(limits.maxVertexInputBindings);
+    hc.Combine(limits.maxVertexInputAttributeOffset);
+    hc.Combine(limits.maxVertexInputBindingStride);
+    hc.Combine(limits.maxVertexOutputComponents);
+    hc.Combine(limits.maxTessellationGenerationLevel);
+    hc.Combine(limits.maxTessellationPatchSize);
+    hc.Combine(limits.maxTessellationControlPerVertexInputComponents);
+    hc.Combine(limits.maxTessellationControlPerVertexOutputComponents);
+    hc.Combine(limits.maxTessellationControlPerPatchOutputComponents);
+    hc.Combine(limits.maxTessellationControlTotalOutputComponents);
+    hc.Combine(limits.maxTessellationEvaluationInputComponents);
+    hc.Combine(limits.maxTessellationEvaluationOutputComponents);
+    hc.Combine(limits.maxGeometryShaderInvocations);
+    hc.Combine(limits.maxGeometryInputComponents);
+    hc.Combine(limits.maxGeometryOutputComponents);
+    hc.Combine(limits.maxGeometryOutputVertices);
+    hc.Combine(limits.maxGeometryTotalOutputComponents);
+    hc.Combine(limits.maxFragmentInputComponents);
+    hc.Combine(limits.maxFragmentOutputAttachments);
+    hc.Combine(limits.maxFragmentDualSrcAttachments);
+    hc.Combine(limits.maxFragmentCombinedOutputResources);
+    hc.Combine(limits.maxComputeSharedMemorySize);
+    hc.Combine(limits.maxComputeWorkGroupCount, limits.maxComputeWorkGroupCount + 3);
+    hc.Combine(limits.maxComputeWorkGroupInvocations);
+    hc.Combine(limits.maxComputeWorkGroupSize, limits.maxComputeWorkGroupSize + 3);
+    hc.Combine(limits.subPixelPrecisionBits);
+    hc.Combine(limits.subTexelPrecisionBits);
+    hc.Combine(limits.mipmapPrecisionBits);
+    hc.Combine(limits.maxDrawIndexedIndexValue);
+    hc.Combine(limits.maxDrawIndirectCount);
+    hc.Combine(limits.maxSamplerLodBias);
+    hc.Combine(limits.maxSamplerAnisotropy);
+    hc.Combine(limits.maxViewports);
+    hc.Combine(limits.maxViewportDimensions, limits.maxViewportDimensions + 2);
+    hc.Combine(limits.viewportBoundsRange, limits.viewportBoundsRange + 2);
+    hc.Combine(limits.viewportSubPixelBits);
+    hc.Combine(limits.minMemoryMapAlignment);
+    hc.Combine(limits.minTexelBufferOffsetAlignment);
+    hc.Combine(limits.minUniformBufferOffsetAlignment);
+    hc.Combine(limits.minStorageBufferOffsetAlignment);
+    hc.Combine(limits.minTexelOffset);
+    hc.Combine(limits.maxTexelOffset);
+    hc.Combine(limits.minTexelGatherOffset);
+    hc.Combine(limits.maxTexelGatherOffset);
+    hc.Combine(limits.minInterpolationOffset);
+    hc.Combine(limits.maxInterpolationOffset);
+    hc.Combine(limits.subPixelInterpolationOffsetBits);
+    hc.Combine(limits.maxFramebufferWidth);
+    hc.Combine(limits.maxFramebufferHeight);
+    hc.Combine(limits.maxFramebufferLayers);
+    hc.Combine(limits.framebufferColorSampleCounts);
+    hc.Combine(limits.framebufferDepthSampleCounts);
+    hc.Combine(limits.framebufferStencilSampleCounts);
+    hc.Combine(limits.framebufferNoAttachmentsSampleCounts);
+    hc.Combine(limits.maxColorAttachments);
+    hc.Combine(limits.sampledImageColorSampleCounts);
+    hc.Combine(limits.sampledImageIntegerSampleCounts);
+    hc.Combine(limits.sampledImageDepthSampleCounts);
+    hc.Combine(limits.sampledImageStencilSampleCounts);
+    hc.Combine(limits.storageImageSampleCounts);
+    hc.Combine(limits.maxSampleMaskWords);
+    hc.Combine(limits.timestampComputeAndGraphics);
+    hc.Combine(limits.timestampPeriod);
+    hc.Combine(limits.maxClipDistances);
+    hc.Combine(limits.maxCullDistances);
+    hc.Combine(limits.maxCombinedClipAndCullDistances);
+    hc.Combine(limits.discreteQueuePriorities);
+    hc.Combine(limits.pointSizeRange, limits.pointSizeRange + 2);
+    hc.Combine(limits.lineWidthRange, limits.lineWidthRange + 2);
+    hc.Combine(limits.pointSizeGranularity);
+    hc.Combine(limits.lineWidthGranularity);
+    hc.Combine(limits.strictLines);
+    hc.Combine(limits.standardSampleLocations);
+    hc.Combine(limits.optimalBufferCopyOffsetAlignment);
+    hc.Combine(limits.optimalBufferCopyRowPitchAlignment);
+    hc.Combine(limits.nonCoherentAtomSize);
+}
+
+// Everything a cached module-level check can depend on besides the SPIR-V itself
+uint64_t GetValidationCacheDeviceStateHash(const APIVersion &api_version, const DeviceExtensions &device_extensions,
+                                           const DeviceFeatures &enabled_features, const VkPhysicalDeviceProperties &props,
+                                           const VkPhysicalDeviceVulkan11Properties &props_core11,
+                                           const VkPhysicalDeviceVulkan12Properties &props_core12,
+                                           const vvl::DeviceExtensionProperties &ext_props, bool has_format_feature2) {
+    // Hashing the DeviceExtensions struct would also hash its padding, so only hash which extensions are enabled (and how).
+    // The info map is unordered, sort to not depend on its iteration order.
+    std::vector<uint64_t> enabled_extensions;
+    for (const auto &[extension, info] : DeviceExtensions::GetInfoMap()) {
+        const ExtEnabled state = device_extensions.*(info.state);
+        if (state != kNotEnabled) {
+            enabled_extensions.emplace_back((uint64_t(extension) << 32) | uint64_t(state));
+        }
+    }
+    std::sort(enabled_extensions.begin(), enabled_extensions.end());
+
+    const uint32_t api_version_value = api_version.Value();
+    hash_util::HashCombiner hc;
+    hc.Combine(api_version_value)
+        .Combine(enabled_extensions)
+        .Combine(hash_util::Hash64(&enabled_features, sizeof(DeviceFeatures)))
+        .Combine(props.vendorID)
+        .Combine(props.deviceID)
+        .Combine(props.driverVersion)
+        .Combine(has_format_feature2);
+    CombineLimits(hc, props.limits);
+
+    // The properties read by stateless::SpirvValidator, field by field as the structs also have sType/pNext
+    hc.Combine(props_core11.subgroupSupportedStages).Combine(props_core11.subgroupQuadOperationsInAllStages);
+    hc.Combine(props_core12.shaderSignedZeroInfNanPreserveFloat16)
+        .Combine(props_core12.shaderSignedZeroInfNanPreserveFloat32)
+        .Combine(props_core12.shaderSignedZeroInfNanPreserveFloat64)
+        .Combine(props_core12.shaderDenormPreserveFloat16)
+        .Combine(props_core12.shaderDenormPreserveFloat32)
+        .Combine(props_core12.shaderDenormPreserveFloat64)
+        .Combine(props_core12.shaderDenormFlushToZeroFloat16)
+        .Combine(props_core12.shaderDenormFlushToZeroFloat32)
+        .Combine(props_core12.shaderDenormFlushToZeroFloat64)
+        .Combine(props_core12.shaderRoundingModeRTEFloat16)
+        .Combine(props_core12.shaderRoundingModeRTEFloat32)
+        .Combine(props_core12.shaderRoundingModeRTEFloat64)
+        .Combine(props_core12.shaderRoundingModeRTZFloat16)
+        .Combine(props_core12.shaderRoundingModeRTZFloat32)
+        .Combine(props_core12.shaderRoundingModeRTZFloat64);
+    const auto &xfb_props = ext_props.transform_feedback_props;
+    hc.Combine(xfb_props.maxTransformFeedbackStreams)
+        .Combine(xfb_props.maxTransformFeedbackBufferDataSize)
+        .Combine(xfb_props.maxTransformFeedbackStreamDataSize)
+        .Combine(xfb_props.maxTransformFeedbackBufferDataStride)
+        .Combine(xfb_props.transformFeedbackStreamsLinesTriangles);
+    hc.Combine(ext_props.mesh_shader_props_nv.maxMeshOutputVertices)
+        .Combine(ext_props.mesh_shader_props_nv.maxMeshOutputPrimitives)
+        .Combine(ext_props.mesh_shader_props_ext.maxMeshOutputVertices)
+        .Combine(ext_props.mesh_shader_props_ext.maxMeshOutputPrimitives);
+    hc.Combine(ext_props.subgroup_props.supportedStages)
+        .Combine(ext_props.compute_shader_derivatives_props.meshAndTaskShaderDerivatives)
+        .Combine(ext_props.conservative_rasterization_props.conservativeRasterizationPostDepthCoverage);
+    return hc.Value();
+}
+
 // This is used to help dump SPIR-V while debugging intermediate phases of any altercations to the SPIR-V
 void DumpSpirvToFile(const fs::path &file_path, const uint32_t *spirv, size_t spirv_dwords_count) {
     std::ofstream debug_file(file_path, std::ios::out | std::ios::binary);
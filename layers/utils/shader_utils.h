@@ -25,12 +25,19 @@
 #include "containers/custom_containers.h"
 
 #include <spirv-tools/libspirv.hpp>
+#include <chrono>
 #include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
 namespace fs = std::filesystem;
 
 struct DeviceFeatures;
 struct DeviceExtensions;
 class APIVersion;
+namespace vvl {
+struct DeviceExtensionProperties;
+}  // namespace vvl
 
 enum class ShaderObjectStage : uint32_t {
     VERTEX = 0u,
@@ -47,6 +54,8 @@ enum class ShaderObjectStage : uint32_t {
 
 constexpr uint32_t kShaderObjectStageCount = 8u;
 
+class ValidationCacheFile;
+
 inline ShaderObjectStage VkShaderStageToShaderObjectStage(VkShaderStageFlagBits stage) {
     switch (stage) {
         case VK_SHADER_STAGE_VERTEX_BIT:
@@ -73,8 +82,23 @@ inline ShaderObjectStage VkShaderStageToShaderObjectStage(VkShaderStageFlagBits
 
 class ValidationCache {
   public:
-    static VkValidationCacheEXT Create(VkValidationCacheCreateInfoEXT const *pCreateInfo, uint32_t spirv_val_option_hash) {
-        auto cache = new ValidationCache(spirv_val_option_hash);
+    // Module-level checks whose outcome only depends on the SPIR-V and the state the device was created with (api version,
+    // extensions, features and properties). A module only records the checks it passed.
+    enum CachedCheck : uint32_t {
+        kSpirvVal = 1u << 0,        // spirv-val (CoreChecks::RunSpirvValidation)
+        kStatelessSpirv = 1u << 1,  // stateless::SpirvValidator::Validate
+    };
+
+    // 64-bit key of the SPIR-V seeded with the device state hash, so the same module used with different features/extensions
+    // (which can make it legal/illegal) does not collide.
+    using Key = uint64_t;
+
+    // 4 bytes for header size + 4 bytes for version number + UUID
+    static constexpr size_t kHeaderSize = 2 * sizeof(uint32_t) + VK_UUID_SIZE;
+
+    static VkValidationCacheEXT Create(VkValidationCacheCreateInfoEXT const *pCreateInfo, uint32_t spirv_val_option_hash,
+                                       uint64_t device_state_hash) {
+        auto cache = new ValidationCache(spirv_val_option_hash, device_state_hash);
         cache->Load(pCreateInfo);
         return VkValidationCacheEXT(cache);
     }
@@ -83,18 +107,37 @@ class ValidationCache {
     void Write(size_t *pDataSize, void *pData);
     void Merge(ValidationCache const *other);
 
-    bool Contains(uint32_t hash) {
+    Key MakeKey(const uint32_t *code, size_t code_size) const;
+
+    // Returns true if all the |checks| were already passed by the module
+    bool Contains(Key key, uint32_t checks) const {
         auto guard = ReadLock();
-        return good_shader_hashes_.count(hash) != 0;
+        auto it = good_shaders_.find(key);
+        return it != good_shaders_.end() && (it->second & checks) == checks;
     }
 
-    void Insert(uint32_t hash) {
+    void Insert(Key key, uint32_t checks);
+
+    // Newly passed checks are also appended to |log| as soon as they are inserted. An Insert racing with SetLog(nullptr) keeps
+    // its reference to the old log, so the log must be shared.
+    void SetLog(std::shared_ptr<ValidationCacheFile> log) {
         auto guard = WriteLock();
-        good_shader_hashes_.insert(hash);
+        log_ = std::move(log);
     }
 
+    // What is written after the header for each module
+    struct Entry {
+        Key key;
+        uint32_t passed_checks;
+        // Lets Load drop entries torn by a crash in the middle of appending to a ValidationCacheFile
+        uint32_t checksum;
+    };
+
   private:
-    ValidationCache(uint32_t spirv_val_option_hash) : spirv_val_option_hash_(spirv_val_option_hash) {}
+    static Entry MakeEntry(Key key, uint32_t passed_checks);
+
+    ValidationCache(uint32_t spirv_val_option_hash, uint64_t device_state_hash)
+        : spirv_val_option_hash_(spirv_val_option_hash), device_state_hash_(device_state_hash) {}
     ReadLockGuard ReadLock() const { return ReadLockGuard(lock_); }
     WriteLockGuard WriteLock() { return WriteLockGuard(lock_); }
 
@@ -103,13 +146,58 @@ class ValidationCache {
     // Can hit cases where error appear/disappear if spirv-val settings are adjusted
     // see https://github.com/KhronosGroup/Vulkan-ValidationLayers/issues/8031
     uint32_t spirv_val_option_hash_;
+    // Covers everything (not just spirv-val options) the cached checks depend on, used to seed the keys
+    uint64_t device_state_hash_;
 
-    // hashes of shaders that have passed validation before, and can be skipped.
+    // modules that have passed validation before, mapped to the CachedCheck bits they passed, so those can be skipped.
     // we don't store negative results, as we would have to also store what was
     // wrong with them; also, we expect they will get fixed, so we're less
     // likely to see them again.
-    vvl::unordered_set<uint32_t> good_shader_hashes_;
+    vvl::unordered_map<Key, uint32_t> good_shaders_;
     mutable std::shared_mutex lock_;
+    std::shared_ptr<ValidationCacheFile> log_;
+};
+
+// Persists the default ValidationCache (the one not provided by the app) in a file shared by every process of the user.
+// The file is a regular validation cache blob. New entries are appended in batches of kAppendBatchSize while the device is
+// alive, so a crash only loses the last batch. Concurrent processes serialize appends with a file lock, and compaction writes a
+// new file that is atomically renamed over the old one, so readers never see a partially written file.
+// The file name is suffixed with a hash of the cache header, so processes with different spirv-val options (or layer versions)
+// each get their own file instead of truncating each other's. Attach removes the files of other settings that have not been
+// used for kStaleFileAge, so they don't pile up after every settings or SPIRV-Tools change.
+// (Platforms without flock/mmap fall back to reading the file at Attach and writing it whole at Detach.)
+class ValidationCacheFile : public std::enable_shared_from_this<ValidationCacheFile> {
+  public:
+    static constexpr size_t kAppendBatchSize = 64;
+    static constexpr std::chrono::hours kStaleFileAge{24 * 30};
+
+    explicit ValidationCacheFile(std::string base_path) : base_path_(std::move(base_path)) {}
+    ~ValidationCacheFile();
+
+    // Loads the entries left by previous (or concurrent) runs into |cache| and starts logging its new entries.
+    // A missing file is not an error, it is created.
+    bool Attach(ValidationCache &cache);
+    // Stops logging, and rewrites the file without duplicated entries if it has grown enough to be worth it
+    bool Detach(ValidationCache &cache);
+    // Queues the entry, the file is only written once a batch is full (or at Detach)
+    void Append(const ValidationCache::Entry &entry);
+
+    const std::string &Path() const { return path_; }
+
+  private:
+    void RemoveStaleFiles() const;
+    void FlushPending();
+    bool ReopenIfReplaced();
+    bool HeaderMatches() const;
+    bool LoadFromFile(ValidationCache &cache, size_t *out_file_size) const;
+    bool Replace(ValidationCache &cache);
+
+    const std::string base_path_;
+    std::string path_;
+    std::vector<uint8_t> header_;
+    std::mutex lock_;
+    std::vector<ValidationCache::Entry> pending_;
+    int fd_ = -1;
 };
 
 spv_target_env PickSpirvEnv(const APIVersion &api_version, bool spirv_1_4);
@@ -117,4 +205,10 @@ spv_target_env PickSpirvEnv(const APIVersion &api_version, bool spirv_1_4);
 void AdjustValidatorOptions(const DeviceExtensions &device_extensions, const DeviceFeatures &enabled_features,
                             spvtools::ValidatorOptions &out_options, uint32_t *out_hash);
 
+uint64_t GetValidationCacheDeviceStateHash(const APIVersion &api_version, const DeviceExtensions &device_extensions,
+                                           const DeviceFeatures &enabled_features, const VkPhysicalDeviceProperties &props,
+                                           const VkPhysicalDeviceVulkan11Properties &props_core11,
+                                           const VkPhysicalDeviceVulkan12Properties &props_core12,
+                                           const vvl::DeviceExtensionProperties &ext_props, bool has_format_feature2);
+
 void DumpSpirvToFile(const fs::path &file_path, const uint32_t *spirv, size_t spirv_dwords_count);
\ No newline at end of file
@@ -0,0 +1,128 @@
+/* Copyright (c) 2025 The Khronos Group Inc.
+ * Copyright (c) 2025 Valve Corporation
+ * Copyright (c) 2025 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "utils/thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+// State shared between the caller of ParallelFor and the helper tasks. Helpers can start after all the work is done
+// (the pool may be busy with another job), so the state is kept alive by the helpers themselves.
+struct vvl::ThreadPool::Job {
+    const std::function<void(size_t)> *fn = nullptr;
+    size_t count = 0;
+    std::atomic<size_t> next{0};
+    std::atomic<size_t> done{0};
+    std::mutex lock;
+    std::condition_variable finished;
+
+    // Claim and run items until there are none left
+    void Run() {
+        size_t local_done = 0;
+        for (size_t i = next.fetch_add(1); i < count; i = next.fetch_add(1)) {
+            (*fn)(i);
+            ++local_done;
+        }
+        if (local_done != 0 && done.fetch_add(local_done) + local_done == count) {
+            std::lock_guard<std::mutex> guard(lock);
+            finished.notify_all();
+        }
+    }
+};
+
+void vvl::ThreadPool::Start() {
+    uint32_t worker_count = max_workers_;
+    if (worker_count == 0) {
+        const uint32_t cores = std::thread::hardware_concurrency();
+        worker_count = std::clamp(cores > 1 ? cores - 1 : 1u, 1u, kMaxWorkers);
+    }
+    threads_.reserve(worker_count);
+    for (uint32_t i = 0; i < worker_count; ++i) {
+        threads_.emplace_back(&ThreadPool::WorkerFunc, this);
+    }
+}
+
+uint32_t vvl::ThreadPool::Concurrency() {
+    std::call_once(start_once_, [this]() { Start(); });
+    std::lock_guard<std::mutex> guard(lock_);
+    return exit_ ? 1 : static_cast<uint32_t>(threads_.size()) + 1;
+}
+
+void vvl::ThreadPool::WorkerFunc() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> guard(lock_);
+            wake_.wait(guard, [this]() { return exit_ || !tasks_.empty(); });
+            if (exit_) {
+                break;
+            }
+            task = std::move(tasks_.front());
+            tasks_.pop_front();
+        }
+        task();
+    }
+}
+
+void vvl::ThreadPool::ParallelFor(size_t count, const std::function<void(size_t)> &fn) {
+    if (count == 0) {
+        return;
+    }
+    const uint32_t helpers = static_cast<uint32_t>(std::min<size_t>(Concurrency() - 1, count - 1));
+    if (helpers == 0) {
+        for (size_t i = 0; i < count; ++i) {
+            fn(i);
+        }
+        return;
+    }
+
+    auto job = std::make_shared<Job>();
+    job->fn = &fn;
+    job->count = count;
+    {
+        std::lock_guard<std::mutex> guard(lock_);
+        for (uint32_t i = 0; i < helpers; ++i) {
+            tasks_.emplace_back([job]() { job->Run(); });
+        }
+    }
+    if (helpers == 1) {
+        wake_.notify_one();
+    } else {
+        wake_.notify_all();
+    }
+
+    job->Run();
+
+    // fn is only called for claimed items, so once they are all done no helper can touch it anymore
+    std::unique_lock<std::mutex> guard(job->lock);
+    job->finished.wait(guard, [&job]() { return job->done.load() == job->count; });
+}
+
+void vvl::ThreadPool::Shutdown() {
+    {
+        std::lock_guard<std::mutex> guard(lock_);
+        exit_ = true;
+        tasks_.clear();
+    }
+    wake_.notify_all();
+    for (auto &thread : threads_) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+    threads_.clear();
+}
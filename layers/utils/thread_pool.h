@@ -0,0 +1,70 @@
+/* Copyright (c) 2025 The Khronos Group Inc.
+ * Copyright (c) 2025 Valve Corporation
+ * Copyright (c) 2025 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace vvl {
+
+// Small pool of worker threads for splitting validation work that is known to be independent.
+//
+// Meant for short CPU bound jobs. Tasks must not block on other tasks of the same pool, and must not wait on
+// queue retirement (that has its own pool, see QueueRetirementPool).
+// Threads are only started on first use.
+class ThreadPool {
+  public:
+    // max_workers == 0 means one worker per core (minus the calling thread), capped at kMaxWorkers
+    explicit ThreadPool(uint32_t max_workers = 0) : max_workers_(max_workers) {}
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+    ~ThreadPool() { Shutdown(); }
+
+    static constexpr uint32_t kMaxWorkers = 8;
+
+    // Calls fn(i) for every i in [0, count). The calling thread takes part and the call returns once all are done.
+    // fn is called concurrently from several threads, and in no particular order.
+    void ParallelFor(size_t count, const std::function<void(size_t)> &fn);
+
+    // Number of threads (including the caller) ParallelFor can spread work over
+    uint32_t Concurrency();
+
+    // Stop and join all workers. ParallelFor keeps working after this, on the calling thread only.
+    void Shutdown();
+
+  private:
+    struct Job;
+
+    void Start();
+    void WorkerFunc();
+
+    const uint32_t max_workers_;
+    std::once_flag start_once_;
+    std::vector<std::thread> threads_;
+
+    std::mutex lock_;
+    std::condition_variable wake_;
+    std::deque<std::function<void()>> tasks_;
+    bool exit_{false};
+};
+
+}  // namespace vvl
@@ -290,6 +290,22 @@ class VkSyncValTest : public VkLayerTest {
     void InitRayTracing();
 };
 
+// Tests that read the syncval stats file, which is written to a temporary path removed after the test
+class VkSyncValStatsFileTest : public VkSyncValTest {
+  public:
+    VkSyncValStatsFileTest();
+    ~VkSyncValStatsFileTest();
+
+  protected:
+    std::string ReadStatsFile() const;
+    // The report has no strings with brackets in them, so matching brackets is enough to tell it was not truncated
+    static bool BracketsMatch(const std::string &report);
+    // Number after the first occurrence of key in the report
+    static uint64_t GetStatsValue(const std::string &report, const char *key);
+
+    std::string stats_file_;
+};
+
 class AndroidExternalResolveTest : public VkLayerTest {
   public:
     void InitBasicAndroidExternalResolve();
@@ -122,6 +122,84 @@ TEST_F(NegativeDescriptorIndexing, UpdateAfterBind) {
     m_errorMonitor->VerifyFound();
 }
 
+TEST_F(NegativeDescriptorIndexing, UpdateAfterBindNewPipelineUsesUnwrittenBinding) {
+    TEST_DESCRIPTION("Update a binding between draws, then bind a pipeline that also uses a binding that was never written.");
+
+    SetTargetApiVersion(VK_API_VERSION_1_1);
+    AddRequiredExtensions(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME);
+    AddRequiredFeature(vkt::Feature::descriptorBindingStorageBufferUpdateAfterBind);
+    AddRequiredFeature(vkt::Feature::fragmentStoresAndAtomics);
+    RETURN_IF_SKIP(Init());
+    InitRenderTarget();
+
+    vkt::Buffer buffer1(*m_device, 4096, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT);
+    vkt::Buffer buffer2(*m_device, 4096, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT);
+
+    OneOffDescriptorIndexingSet descriptor_set(
+        m_device,
+        {{0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_ALL, nullptr, VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT},
+         {1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_ALL, nullptr, 0}});
+    const vkt::PipelineLayout pipeline_layout(*m_device, {&descriptor_set.layout_});
+
+    // Binding 1 is never written, it is not UPDATE_AFTER_BIND so it is checked at draw time
+    descriptor_set.WriteDescriptorBufferInfo(0, buffer1, 0, VK_WHOLE_SIZE, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER);
+    descriptor_set.UpdateDescriptorSets();
+    descriptor_set.Clear();
+
+    const char fs_source_0[] = R"glsl(
+        #version 450
+        layout (set = 0, binding = 0) buffer buf1 {
+            float a;
+        } ubuf1;
+        void main() {
+           float f = ubuf1.a;
+        }
+    )glsl";
+    VkShaderObj fs_0(this, fs_source_0, VK_SHADER_STAGE_FRAGMENT_BIT);
+
+    const char fs_source_01[] = R"glsl(
+        #version 450
+        layout (set = 0, binding = 0) buffer buf1 {
+            float a;
+        } ubuf1;
+        layout (set = 0, binding = 1) buffer buf2 {
+            float a;
+        } ubuf2;
+        void main() {
+           float f = ubuf1.a * ubuf2.a;
+        }
+    )glsl";
+    VkShaderObj fs_01(this, fs_source_01, VK_SHADER_STAGE_FRAGMENT_BIT);
+
+    CreatePipelineHelper pipe_0(*this);
+    pipe_0.shader_stages_ = {pipe_0.vs_->GetStageCreateInfo(), fs_0.GetStageCreateInfo()};
+    pipe_0.gp_ci_.layout = pipeline_layout.handle();
+    pipe_0.CreateGraphicsPipeline();
+
+    CreatePipelineHelper pipe_01(*this);
+    pipe_01.shader_stages_ = {pipe_01.vs_->GetStageCreateInfo(), fs_01.GetStageCreateInfo()};
+    pipe_01.gp_ci_.layout = pipeline_layout.handle();
+    pipe_01.CreateGraphicsPipeline();
+
+    m_command_buffer.Begin();
+    m_command_buffer.BeginRenderPass(m_renderPassBeginInfo);
+    vk::CmdBindDescriptorSets(m_command_buffer.handle(), VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline_layout.handle(), 0, 1,
+                              &descriptor_set.set_, 0, nullptr);
+    vk::CmdBindPipeline(m_command_buffer.handle(), VK_PIPELINE_BIND_POINT_GRAPHICS, pipe_0.Handle());
+    vk::CmdDraw(m_command_buffer.handle(), 3, 1, 0, 0);
+
+    // Only binding 0 changed since the last validated draw, but the new pipeline also uses binding 1
+    descriptor_set.WriteDescriptorBufferInfo(0, buffer2, 0, VK_WHOLE_SIZE, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER);
+    descriptor_set.UpdateDescriptorSets();
+    vk::CmdBindPipeline(m_command_buffer.handle(), VK_PIPELINE_BIND_POINT_GRAPHICS, pipe_01.Handle());
+    m_errorMonitor->SetDesiredError("VUID-vkCmdDraw-None-08114");
+    vk::CmdDraw(m_command_buffer.handle(), 3, 1, 0, 0);
+    m_errorMonitor->VerifyFound();
+
+    m_command_buffer.EndRenderPass();
+    m_command_buffer.End();
+}
+
 TEST_F(NegativeDescriptorIndexing, SetNonIdenticalWrite) {
     TEST_DESCRIPTION("VkWriteDescriptorSet must have identical VkDescriptorBindingFlagBits");
 
@@ -716,6 +716,83 @@ TEST_F(NegativeDescriptors, DrawDescriptorSetBufferDestroyed) {
     m_errorMonitor->VerifyFound();
 }
 
+TEST_F(NegativeDescriptors, DrawReusedSetNotUpdated) {
+    TEST_DESCRIPTION("A set allocated in the memory of a freed set must not inherit its updates or its cached validation.");
+    RETURN_IF_SKIP(Init());
+    InitRenderTarget();
+
+    vkt::Buffer buffer(*m_device, 1024, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT);
+    const vkt::DescriptorSetLayout ds_layout(*m_device, {{0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1, VK_SHADER_STAGE_ALL, nullptr}});
+    const vkt::PipelineLayout pipeline_layout(*m_device, {&ds_layout});
+
+    VkDescriptorPoolSize ds_type_count = {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1};
+    VkDescriptorPoolCreateInfo ds_pool_ci = vku::InitStructHelper();
+    ds_pool_ci.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
+    ds_pool_ci.maxSets = 1;
+    ds_pool_ci.poolSizeCount = 1;
+    ds_pool_ci.pPoolSizes = &ds_type_count;
+    vkt::DescriptorPool ds_pool(*m_device, ds_pool_ci);
+
+    char const *fsSource = R"glsl(
+        #version 450
+        layout(location=0) out vec4 x;
+        layout(set=0) layout(binding=0) uniform foo { int x; int y; } bar;
+        void main(){
+           x = vec4(bar.y);
+        }
+    )glsl";
+    VkShaderObj fs(this, fsSource, VK_SHADER_STAGE_FRAGMENT_BIT);
+    CreatePipelineHelper pipe(*this);
+    pipe.shader_stages_ = {pipe.vs_->GetStageCreateInfo(), fs.GetStageCreateInfo()};
+    pipe.gp_ci_.layout = pipeline_layout.handle();
+    pipe.CreateGraphicsPipeline();
+
+    VkDescriptorSet descriptor_set = VK_NULL_HANDLE;
+    VkDescriptorSetAllocateInfo alloc_info = vku::InitStructHelper();
+    alloc_info.descriptorSetCount = 1;
+    alloc_info.descriptorPool = ds_pool;
+    alloc_info.pSetLayouts = &ds_layout.handle();
+
+    VkDescriptorBufferInfo buffer_info = {buffer, 0, VK_WHOLE_SIZE};
+    VkWriteDescriptorSet descriptor_write = vku::InitStructHelper();
+    descriptor_write.dstBinding = 0;
+    descriptor_write.descriptorCount = 1;
+    descriptor_write.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    descriptor_write.pBufferInfo = &buffer_info;
+
+    for (uint32_t i = 0; i < 4; ++i) {
+        // Each set takes the blocks the previous one gave back to the pool
+        ASSERT_EQ(VK_SUCCESS, vk::AllocateDescriptorSets(device(), &alloc_info, &descriptor_set));
+
+        m_command_buffer.Begin();
+        m_command_buffer.BeginRenderPass(m_renderPassBeginInfo);
+        vk::CmdBindPipeline(m_command_buffer.handle(), VK_PIPELINE_BIND_POINT_GRAPHICS, pipe.Handle());
+        vk::CmdBindDescriptorSets(m_command_buffer.handle(), VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline_layout.handle(), 0, 1,
+                                  &descriptor_set, 0, nullptr);
+        m_errorMonitor->SetDesiredError("VUID-vkCmdDraw-None-08114");
+        vk::CmdDraw(m_command_buffer.handle(), 1, 0, 0, 0);
+        m_errorMonitor->VerifyFound();
+        m_command_buffer.EndRenderPass();
+        m_command_buffer.End();
+        m_command_buffer.Reset();
+
+        descriptor_write.dstSet = descriptor_set;
+        vk::UpdateDescriptorSets(device(), 1, &descriptor_write, 0, nullptr);
+
+        m_command_buffer.Begin();
+        m_command_buffer.BeginRenderPass(m_renderPassBeginInfo);
+        vk::CmdBindPipeline(m_command_buffer.handle(), VK_PIPELINE_BIND_POINT_GRAPHICS, pipe.Handle());
+        vk::CmdBindDescriptorSets(m_command_buffer.handle(), VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline_layout.handle(), 0, 1,
+                                  &descriptor_set, 0, nullptr);
+        vk::CmdDraw(m_command_buffer.handle(), 1, 0, 0, 0);
+        m_command_buffer.EndRenderPass();
+        m_command_buffer.End();
+        m_command_buffer.Reset();
+
+        vk::FreeDescriptorSets(device(), ds_pool, 1, &descriptor_set);
+    }
+}
+
 TEST_F(NegativeDescriptors, CmdBufferDescriptorSetImageSamplerDestroyed) {
     TEST_DESCRIPTION(
         "Attempt to draw with a command buffer that is invalid due to a bound descriptor sets with a combined image sampler having "
@@ -2492,6 +2569,56 @@ TEST_F(NegativeDescriptors, UpdateIndexSmaller) {
     m_errorMonitor->VerifyFound();
 }
 
+TEST_F(NegativeDescriptors, UpdateSparseBindingNumbers) {
+    TEST_DESCRIPTION("Update sparse and very large binding numbers, hitting both the dense table and the map lookup");
+    RETURN_IF_SKIP(Init());
+    vkt::Buffer buffer(*m_device, 32, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT);
+
+    // Packed enough to be looked up through the dense table
+    OneOffDescriptorSet dense_set(m_device, {
+                                                {0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1, VK_SHADER_STAGE_ALL, nullptr},
+                                                {5, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1, VK_SHADER_STAGE_ALL, nullptr},
+                                                {9, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1, VK_SHADER_STAGE_ALL, nullptr},
+                                            });
+    dense_set.WriteDescriptorBufferInfo(5, buffer, 0, VK_WHOLE_SIZE);
+    dense_set.WriteDescriptorBufferInfo(9, buffer, 0, VK_WHOLE_SIZE);
+    dense_set.UpdateDescriptorSets();
+
+    dense_set.Clear();
+    dense_set.WriteDescriptorBufferInfo(3, buffer, 0, VK_WHOLE_SIZE);
+    m_errorMonitor->SetDesiredError("VUID-VkWriteDescriptorSet-dstBinding-00316");
+    dense_set.UpdateDescriptorSets();
+    m_errorMonitor->VerifyFound();
+
+    dense_set.Clear();
+    dense_set.WriteDescriptorBufferInfo(100, buffer, 0, VK_WHOLE_SIZE);
+    m_errorMonitor->SetDesiredError("VUID-VkWriteDescriptorSet-dstBinding-00315");
+    dense_set.UpdateDescriptorSets();
+    m_errorMonitor->VerifyFound();
+
+    // Too sparse for a table, so the layout falls back to the map
+    OneOffDescriptorSet sparse_set(m_device, {
+                                                 {0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1, VK_SHADER_STAGE_ALL, nullptr},
+                                                 {1000, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1, VK_SHADER_STAGE_ALL, nullptr},
+                                                 {100000, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1, VK_SHADER_STAGE_ALL, nullptr},
+                                             });
+    sparse_set.WriteDescriptorBufferInfo(1000, buffer, 0, VK_WHOLE_SIZE);
+    sparse_set.WriteDescriptorBufferInfo(100000, buffer, 0, VK_WHOLE_SIZE);
+    sparse_set.UpdateDescriptorSets();
+
+    sparse_set.Clear();
+    sparse_set.WriteDescriptorBufferInfo(500, buffer, 0, VK_WHOLE_SIZE);
+    m_errorMonitor->SetDesiredError("VUID-VkWriteDescriptorSet-dstBinding-00316");
+    sparse_set.UpdateDescriptorSets();
+    m_errorMonitor->VerifyFound();
+
+    sparse_set.Clear();
+    sparse_set.WriteDescriptorBufferInfo(100001, buffer, 0, VK_WHOLE_SIZE);
+    m_errorMonitor->SetDesiredError("VUID-VkWriteDescriptorSet-dstBinding-00315");
+    sparse_set.UpdateDescriptorSets();
+    m_errorMonitor->VerifyFound();
+}
+
 TEST_F(NegativeDescriptors, DSUpdateStruct) {
     TEST_DESCRIPTION("Call UpdateDS w/ struct type other than valid VK_STRUCTUR_TYPE_UPDATE_* types");
     m_errorMonitor->SetDesiredError(".sType must be VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET");
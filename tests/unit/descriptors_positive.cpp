@@ -1602,3 +1602,137 @@ TEST_F(PositiveDescriptors, DescriptorSetLayoutBinding0Count) {
     m_errorMonitor->ExpectSuccess(kErrorBit | kWarningBit);
     vk::AllocateDescriptorSets(device(), &alloc_info, &descriptor_set);
 }
+
+TEST_F(PositiveDescriptors, AllocateFreeResetReuse) {
+    TEST_DESCRIPTION("Allocate, free and reset sets of different layouts so the pool recycles their state");
+    RETURN_IF_SKIP(Init());
+
+    VkDescriptorPoolSize ds_type_count = {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 16};
+    VkDescriptorPoolCreateInfo ds_pool_ci = vku::InitStructHelper();
+    ds_pool_ci.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
+    ds_pool_ci.maxSets = 4;
+    ds_pool_ci.poolSizeCount = 1;
+    ds_pool_ci.pPoolSizes = &ds_type_count;
+    vkt::DescriptorPool ds_pool(*m_device, ds_pool_ci);
+
+    // Sets with a different number of bindings still share the same arena blocks
+    VkDescriptorSetLayoutBinding bindings[3] = {{0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1, VK_SHADER_STAGE_ALL, nullptr},
+                                                {1, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1, VK_SHADER_STAGE_ALL, nullptr},
+                                                {2, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 2, VK_SHADER_STAGE_ALL, nullptr}};
+    const vkt::DescriptorSetLayout ds_layout_one(*m_device, {bindings[0]});
+    const vkt::DescriptorSetLayout ds_layout_three(*m_device, {bindings[0], bindings[1], bindings[2]});
+    const VkDescriptorSetLayout layouts[4] = {ds_layout_one, ds_layout_three, ds_layout_one, ds_layout_three};
+
+    VkDescriptorSetAllocateInfo alloc_info = vku::InitStructHelper();
+    alloc_info.descriptorPool = ds_pool;
+
+    for (uint32_t i = 0; i < 32; ++i) {
+        VkDescriptorSet descriptor_sets[4];
+        alloc_info.descriptorSetCount = 4;
+        alloc_info.pSetLayouts = layouts;
+        ASSERT_EQ(VK_SUCCESS, vk::AllocateDescriptorSets(device(), &alloc_info, descriptor_sets));
+
+        // Freed blocks go back to the free list and are handed out by the next allocation
+        vk::FreeDescriptorSets(device(), ds_pool, 2, &descriptor_sets[1]);
+        alloc_info.descriptorSetCount = 2;
+        alloc_info.pSetLayouts = &layouts[2];
+        ASSERT_EQ(VK_SUCCESS, vk::AllocateDescriptorSets(device(), &alloc_info, &descriptor_sets[1]));
+
+        if (i % 2 == 0) {
+            vk::ResetDescriptorPool(device(), ds_pool, 0);
+        } else {
+            vk::FreeDescriptorSets(device(), ds_pool, 4, descriptor_sets);
+        }
+    }
+}
+
+TEST_F(PositiveDescriptors, AllocateFreeBindingCounts) {
+    TEST_DESCRIPTION("Recycle sets whose binding storage falls in different arena size classes, or is too large for the arena");
+    RETURN_IF_SKIP(Init());
+
+    vkt::Buffer buffer(*m_device, 64, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT);
+    const uint32_t binding_counts[3] = {1, 8, 256};
+    std::vector<std::unique_ptr<vkt::DescriptorSetLayout>> ds_layouts;
+    for (uint32_t binding_count : binding_counts) {
+        std::vector<VkDescriptorSetLayoutBinding> bindings;
+        for (uint32_t i = 0; i < binding_count; ++i) {
+            bindings.push_back({i, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1, VK_SHADER_STAGE_ALL, nullptr});
+        }
+        ds_layouts.emplace_back(std::make_unique<vkt::DescriptorSetLayout>(*m_device, bindings));
+    }
+
+    VkDescriptorPoolSize ds_type_count = {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1 + 8 + 256};
+    VkDescriptorPoolCreateInfo ds_pool_ci = vku::InitStructHelper();
+    ds_pool_ci.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
+    ds_pool_ci.maxSets = 3;
+    ds_pool_ci.poolSizeCount = 1;
+    ds_pool_ci.pPoolSizes = &ds_type_count;
+    vkt::DescriptorPool ds_pool(*m_device, ds_pool_ci);
+
+    VkDescriptorBufferInfo buffer_info = {buffer, 0, VK_WHOLE_SIZE};
+    VkWriteDescriptorSet descriptor_write = vku::InitStructHelper();
+    descriptor_write.descriptorCount = 1;
+    descriptor_write.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    descriptor_write.pBufferInfo = &buffer_info;
+
+    VkDescriptorSetAllocateInfo alloc_info = vku::InitStructHelper();
+    alloc_info.descriptorPool = ds_pool;
+    alloc_info.descriptorSetCount = 1;
+    for (uint32_t round = 0; round < 8; ++round) {
+        // Alternate the order so the freed blocks of one size are offered to sets of the others
+        VkDescriptorSet descriptor_sets[3];
+        for (uint32_t i = 0; i < 3; ++i) {
+            const uint32_t layout_index = (round % 2 == 0) ? i : 2 - i;
+            alloc_info.pSetLayouts = &ds_layouts[layout_index]->handle();
+            ASSERT_EQ(VK_SUCCESS, vk::AllocateDescriptorSets(device(), &alloc_info, &descriptor_sets[i]));
+            descriptor_write.dstSet = descriptor_sets[i];
+            descriptor_write.dstBinding = binding_counts[layout_index] - 1;
+            vk::UpdateDescriptorSets(device(), 1, &descriptor_write, 0, nullptr);
+        }
+        vk::FreeDescriptorSets(device(), ds_pool, 3, descriptor_sets);
+    }
+}
+
+TEST_F(PositiveDescriptors, BoundSetOutlivesPool) {
+    TEST_DESCRIPTION("A set bound in a command buffer keeps its state after the pool is reset and destroyed");
+    RETURN_IF_SKIP(Init());
+
+    vkt::Buffer buffer(*m_device, 64, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT);
+    const vkt::DescriptorSetLayout ds_layout(*m_device, {{0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1, VK_SHADER_STAGE_ALL, nullptr}});
+    const vkt::PipelineLayout pipeline_layout(*m_device, {&ds_layout});
+
+    VkDescriptorPoolSize ds_type_count = {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 2};
+    VkDescriptorPoolCreateInfo ds_pool_ci = vku::InitStructHelper();
+    ds_pool_ci.maxSets = 2;
+    ds_pool_ci.poolSizeCount = 1;
+    ds_pool_ci.pPoolSizes = &ds_type_count;
+    auto ds_pool = std::make_unique<vkt::DescriptorPool>(*m_device, ds_pool_ci);
+
+    VkDescriptorSet descriptor_set = VK_NULL_HANDLE;
+    VkDescriptorSetAllocateInfo alloc_info = vku::InitStructHelper();
+    alloc_info.descriptorSetCount = 1;
+    alloc_info.descriptorPool = *ds_pool;
+    alloc_info.pSetLayouts = &ds_layout.handle();
+    ASSERT_EQ(VK_SUCCESS, vk::AllocateDescriptorSets(device(), &alloc_info, &descriptor_set));
+
+    VkDescriptorBufferInfo buffer_info = {buffer, 0, VK_WHOLE_SIZE};
+    VkWriteDescriptorSet descriptor_write = vku::InitStructHelper();
+    descriptor_write.dstSet = descriptor_set;
+    descriptor_write.dstBinding = 0;
+    descriptor_write.descriptorCount = 1;
+    descriptor_write.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    descriptor_write.pBufferInfo = &buffer_info;
+    vk::UpdateDescriptorSets(device(), 1, &descriptor_write, 0, nullptr);
+
+    m_command_buffer.Begin();
+    vk::CmdBindDescriptorSets(m_command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline_layout, 0, 1, &descriptor_set, 0,
+                              nullptr);
+
+    // The command buffer still references the set state while its pool memory is recycled and then released
+    vk::ResetDescriptorPool(device(), *ds_pool, 0);
+    ASSERT_EQ(VK_SUCCESS, vk::AllocateDescriptorSets(device(), &alloc_info, &descriptor_set));
+    ds_pool.reset();
+
+    m_command_buffer.End();
+    m_command_buffer.Reset();
+}
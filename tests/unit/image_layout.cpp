@@ -1052,3 +1052,80 @@ TEST_F(NegativeImageLayout, LayoutTransitionRenderPassObject2) {
     m_command_buffer.EndRenderPass();
     m_command_buffer.End();
 }
+
+TEST_F(NegativeImageLayout, FingerprintedCommandBufferLayoutChanged) {
+    TEST_DESCRIPTION("Re-record an identical command buffer with fingerprinting after the image layout changed");
+    const VkBool32 enable = VK_TRUE;
+    const VkLayerSettingEXT setting = {OBJECT_LAYER_NAME, "command_buffer_fingerprinting", VK_LAYER_SETTING_TYPE_BOOL32_EXT, 1,
+                                       &enable};
+    VkLayerSettingsCreateInfoEXT layer_settings_create_info = vku::InitStructHelper();
+    layer_settings_create_info.settingCount = 1;
+    layer_settings_create_info.pSettings = &setting;
+    RETURN_IF_SKIP(InitFramework(&layer_settings_create_info));
+    RETURN_IF_SKIP(InitState());
+
+    const VkFormat format = VK_FORMAT_R8G8B8A8_UNORM;
+    const VkImageUsageFlags usage = VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+    vkt::Image src_image(*m_device, 64, 64, format, usage);
+    vkt::Image dst_image(*m_device, 64, 64, format, usage);
+    src_image.SetLayout(VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
+    dst_image.SetLayout(VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+
+    VkImageCopy region = {};
+    region.srcSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1};
+    region.dstSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1};
+    region.extent = {64, 64, 1};
+
+    auto record = [&]() {
+        m_command_buffer.Reset(0);
+        m_command_buffer.Begin();
+        vk::CmdCopyImage(m_command_buffer.handle(), src_image.handle(), VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, dst_image.handle(),
+                         VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+        m_command_buffer.End();
+    };
+
+    // Identical clean recordings
+    record();
+    m_default_queue->Submit(m_command_buffer);
+    m_default_queue->Wait();
+    record();
+    m_default_queue->Submit(m_command_buffer);
+    m_default_queue->Wait();
+
+    // The recording is identical, but the source image is no longer in the expected layout
+    src_image.SetLayout(VK_IMAGE_LAYOUT_GENERAL);
+    record();
+    m_errorMonitor->SetDesiredError("VUID-vkCmdDraw-None-09600");
+    m_default_queue->Submit(m_command_buffer);
+    m_errorMonitor->VerifyFound();
+    m_default_queue->Wait();
+}
+
+TEST_F(NegativeImageLayout, ManyImagesSubmitLayoutMismatch) {
+    TEST_DESCRIPTION("Submit a command buffer referencing enough images for the layout checks to be split across threads");
+    RETURN_IF_SKIP(Init());
+
+    const VkFormat format = VK_FORMAT_R8G8B8A8_UNORM;
+    const VkImageUsageFlags usage = VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+    std::vector<std::unique_ptr<vkt::Image>> images;
+    for (uint32_t i = 0; i < 48; ++i) {
+        images.emplace_back(std::make_unique<vkt::Image>(*m_device, 16, 16, format, usage));
+        images.back()->SetLayout(VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+    }
+    // Only one image is not in the layout the command buffer expects
+    images[37]->SetLayout(VK_IMAGE_LAYOUT_GENERAL);
+
+    const VkClearColorValue clear_color = {};
+    const VkImageSubresourceRange range = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
+    m_command_buffer.Begin();
+    for (const auto &image : images) {
+        vk::CmdClearColorImage(m_command_buffer.handle(), image->handle(), VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, &clear_color, 1,
+                               &range);
+    }
+    m_command_buffer.End();
+
+    m_errorMonitor->SetDesiredError("VUID-vkCmdDraw-None-09600");
+    m_default_queue->Submit(m_command_buffer);
+    m_errorMonitor->VerifyFound();
+    m_default_queue->Wait();
+}
@@ -13,8 +13,15 @@
 
 #include "../framework/layer_validation_tests.h"
 #include "generated/vk_extension_helper.h"
+#include "utils/vk_layer_utils.h"
 
+#include <chrono>
 #include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <random>
 
 class VkPositiveLayerTest : public VkLayerTest {};
 
@@ -711,3 +718,183 @@ TEST_F(VkPositiveLayerTest, PhysicalDeviceLayeredApiVulkanProperties) {
     VkPhysicalDeviceProperties2 phys_dev_props_2 = vku::InitStructHelper(&api_prop_lists);
     vk::GetPhysicalDeviceProperties2(Gpu(), &phys_dev_props_2);
 }
+
+TEST_F(VkPositiveLayerTest, ValidationCacheRoundTrip) {
+    TEST_DESCRIPTION("Write a validation cache with a validated module, then load and merge it into another one.");
+    AddRequiredExtensions(VK_EXT_VALIDATION_CACHE_EXTENSION_NAME);
+    RETURN_IF_SKIP(Init());
+
+    VkValidationCacheCreateInfoEXT cache_ci = vku::InitStructHelper();
+    VkValidationCacheEXT src_cache = VK_NULL_HANDLE;
+    ASSERT_EQ(VK_SUCCESS, vk::CreateValidationCacheEXT(device(), &cache_ci, nullptr, &src_cache));
+
+    const auto spv = GLSLToSPV(VK_SHADER_STAGE_VERTEX_BIT, kVertexMinimalGlsl);
+    VkShaderModuleValidationCacheCreateInfoEXT shader_cache_ci = vku::InitStructHelper();
+    shader_cache_ci.validationCache = src_cache;
+    VkShaderModuleCreateInfo module_ci = vku::InitStructHelper(&shader_cache_ci);
+    module_ci.codeSize = spv.size() * sizeof(uint32_t);
+    module_ci.pCode = spv.data();
+    // The second module hits the cache
+    vkt::ShaderModule module_a(*m_device, module_ci);
+    vkt::ShaderModule module_b(*m_device, module_ci);
+
+    size_t data_size = 0;
+    ASSERT_EQ(VK_SUCCESS, vk::GetValidationCacheDataEXT(device(), src_cache, &data_size, nullptr));
+    const size_t header_size = 2 * sizeof(uint32_t) + VK_UUID_SIZE;
+    ASSERT_GT(data_size, header_size);
+    std::vector<uint8_t> data(data_size);
+    ASSERT_EQ(VK_SUCCESS, vk::GetValidationCacheDataEXT(device(), src_cache, &data_size, data.data()));
+
+    // Entries are never partially written
+    size_t small_size = data_size - 1;
+    std::vector<uint8_t> small_data(small_size);
+    ASSERT_EQ(VK_INCOMPLETE, vk::GetValidationCacheDataEXT(device(), src_cache, &small_size, small_data.data()));
+    ASSERT_LT(small_size, data_size - 1);
+
+    cache_ci.initialDataSize = data.size();
+    cache_ci.pInitialData = data.data();
+    VkValidationCacheEXT loaded_cache = VK_NULL_HANDLE;
+    ASSERT_EQ(VK_SUCCESS, vk::CreateValidationCacheEXT(device(), &cache_ci, nullptr, &loaded_cache));
+    size_t loaded_size = 0;
+    vk::GetValidationCacheDataEXT(device(), loaded_cache, &loaded_size, nullptr);
+    ASSERT_EQ(data_size, loaded_size);
+
+    // Merging the same modules does not grow the cache
+    ASSERT_EQ(VK_SUCCESS, vk::MergeValidationCachesEXT(device(), loaded_cache, 1, &src_cache));
+    vk::GetValidationCacheDataEXT(device(), loaded_cache, &loaded_size, nullptr);
+    ASSERT_EQ(data_size, loaded_size);
+
+    vk::DestroyValidationCacheEXT(device(), loaded_cache, nullptr);
+    vk::DestroyValidationCacheEXT(device(), src_cache, nullptr);
+}
+
+// Points the default shader validation cache at a directory owned by the test, so files of other tests or processes using the
+// validation layers are never seen, and removes it at the end
+class PositiveShaderValidationCacheFile : public VkLayerTest {
+  public:
+    PositiveShaderValidationCacheFile() {
+        const auto *test_info = ::testing::UnitTest::GetInstance()->current_test_info();
+        cache_dir_ = std::filesystem::path(GetTempFilePath()) /
+                     ("vvl_test_" + std::string(test_info->name()) + "_" + std::to_string(std::random_device{}()));
+        cache_dir_string_ = cache_dir_.string();
+        cache_dir_cstr_ = cache_dir_string_.c_str();
+        std::filesystem::create_directories(cache_dir_);
+    }
+    ~PositiveShaderValidationCacheFile() {
+        // Devices write the file when destroyed
+        ShutdownFramework();
+        std::error_code ec;
+        std::filesystem::remove_all(cache_dir_, ec);
+    }
+
+  protected:
+    void InitFrameworkWithCacheDir() {
+        VkLayerSettingEXT setting = {OBJECT_LAYER_NAME, "check_shaders_caching_path", VK_LAYER_SETTING_TYPE_STRING_EXT, 1,
+                                     &cache_dir_cstr_};
+        VkLayerSettingsCreateInfoEXT layer_settings_ci = {VK_STRUCTURE_TYPE_LAYER_SETTINGS_CREATE_INFO_EXT, nullptr, 1, &setting};
+        RETURN_IF_SKIP(InitFramework(&layer_settings_ci));
+    }
+
+    // Contents of the cache files, by path
+    std::map<std::string, std::string> ReadCacheFiles() const {
+        std::map<std::string, std::string> files;
+        for (const auto &entry : std::filesystem::directory_iterator(cache_dir_)) {
+            if (entry.path().extension() != ".bin") {
+                continue;
+            }
+            std::ifstream file(entry.path(), std::ios::in | std::ios::binary);
+            files[entry.path().string()] = std::string(std::istreambuf_iterator<char>(file), {});
+        }
+        return files;
+    }
+
+    // Creates a device with a module that goes through the cache, and destroys it so the file is written
+    void ValidateShaderOnNewDevice(void *create_device_pnext = nullptr) {
+        std::vector<const char *> device_extension_names;
+        auto features = m_device->Physical().Features();
+        vkt::Device test_device(Gpu(), device_extension_names, &features, create_device_pnext);
+        const auto spv = GLSLToSPV(VK_SHADER_STAGE_VERTEX_BIT, kVertexMinimalGlsl);
+        VkShaderModuleCreateInfo module_ci = vku::InitStructHelper();
+        module_ci.codeSize = spv.size() * sizeof(uint32_t);
+        module_ci.pCode = spv.data();
+        vkt::ShaderModule module(test_device, module_ci);
+    }
+
+    std::filesystem::path cache_dir_;
+    std::string cache_dir_string_;
+    const char *cache_dir_cstr_ = nullptr;
+};
+
+TEST_F(PositiveShaderValidationCacheFile, Created) {
+    TEST_DESCRIPTION("The default validation cache file is created when it does not exist.");
+    RETURN_IF_SKIP(InitFrameworkWithCacheDir());
+    RETURN_IF_SKIP(InitState());
+
+    ValidateShaderOnNewDevice();
+    auto files = ReadCacheFiles();
+    ASSERT_EQ(1u, files.size());
+    const std::string path = files.begin()->first;
+    const size_t header_size = 2 * sizeof(uint32_t) + VK_UUID_SIZE;
+    ASSERT_GT(files.begin()->second.size(), header_size);
+
+    std::filesystem::remove(path);
+    ValidateShaderOnNewDevice();
+    files = ReadCacheFiles();
+    ASSERT_EQ(1u, files.size());
+    ASSERT_EQ(path, files.begin()->first);
+    ASSERT_GT(files.begin()->second.size(), header_size);
+}
+
+TEST_F(PositiveShaderValidationCacheFile, DifferentSettings) {
+    TEST_DESCRIPTION("Devices with different spirv-val options do not overwrite each other's validation cache file.");
+    SetTargetApiVersion(VK_API_VERSION_1_2);
+    RETURN_IF_SKIP(InitFrameworkWithCacheDir());
+    RETURN_IF_SKIP(InitState());
+    if (DeviceValidationVersion() < VK_API_VERSION_1_2) {
+        GTEST_SKIP() << "At least Vulkan version 1.2 is required";
+    }
+    VkPhysicalDeviceScalarBlockLayoutFeatures supported_scalar_features = vku::InitStructHelper();
+    VkPhysicalDeviceFeatures2 features_2 = vku::InitStructHelper(&supported_scalar_features);
+    vk::GetPhysicalDeviceFeatures2(Gpu(), &features_2);
+    if (!supported_scalar_features.scalarBlockLayout) {
+        GTEST_SKIP() << "scalarBlockLayout not supported";
+    }
+
+    ValidateShaderOnNewDevice();
+    const auto after_default = ReadCacheFiles();
+    ASSERT_EQ(1u, after_default.size());
+    const std::string default_path = after_default.begin()->first;
+
+    // scalarBlockLayout changes the spirv-val options
+    VkPhysicalDeviceScalarBlockLayoutFeatures scalar_features = vku::InitStructHelper();
+    scalar_features.scalarBlockLayout = VK_TRUE;
+    ValidateShaderOnNewDevice(&scalar_features);
+    const auto after_scalar = ReadCacheFiles();
+    ASSERT_EQ(2u, after_scalar.size());
+    ASSERT_EQ(after_default.at(default_path), after_scalar.at(default_path));
+}
+
+TEST_F(PositiveShaderValidationCacheFile, StaleFilesRemoved) {
+    TEST_DESCRIPTION("Cache files of other settings that have not been used for a long time are removed.");
+    RETURN_IF_SKIP(InitFrameworkWithCacheDir());
+    RETURN_IF_SKIP(InitState());
+
+    ValidateShaderOnNewDevice();
+    const auto files = ReadCacheFiles();
+    ASSERT_EQ(1u, files.size());
+    const std::string path = files.begin()->first;
+
+    // Files named like the ones of other settings
+    const std::string prefix = path.substr(0, path.rfind('-'));
+    const std::string stale_path = prefix + "-0.bin";
+    const std::string recent_path = prefix + "-1.bin";
+    std::ofstream(stale_path, std::ios::out | std::ios::binary) << "stale";
+    std::ofstream(recent_path, std::ios::out | std::ios::binary) << "recent";
+    std::filesystem::last_write_time(stale_path,
+                                     std::filesystem::file_time_type::clock::now() - std::chrono::hours(24 * 31));
+
+    ValidateShaderOnNewDevice();
+    ASSERT_FALSE(std::filesystem::exists(stale_path));
+    ASSERT_TRUE(std::filesystem::exists(recent_path));
+    ASSERT_TRUE(std::filesystem::exists(path));
+}
@@ -583,6 +583,107 @@ TEST_F(VkLayerTest, ValidationCacheTestBadMerge) {
     vk::DestroyValidationCacheEXT(device(), validationCache, nullptr);
 }
 
+TEST_F(VkLayerTest, ValidationCacheStatelessSpirv) {
+    TEST_DESCRIPTION("A module is only cached as passing the stateless SPIR-V checks if none of them logged an error.");
+    AddRequiredExtensions(VK_EXT_VALIDATION_CACHE_EXTENSION_NAME);
+    RETURN_IF_SKIP(Init());
+    if (m_device->Physical().limits_.maxTexelGatherOffset >= 100) {
+        GTEST_SKIP() << "test needs maxTexelGatherOffset less than 100";
+    }
+
+    // Valid for spirv-val, but the offset is over maxTexelGatherOffset
+    const char *spv_source = R"(
+               OpCapability Shader
+               OpMemoryModel Logical GLSL450
+               OpEntryPoint GLCompute %main "main"
+               OpExecutionMode %main LocalSize 1 1 1
+               OpDecorate %samp DescriptorSet 0
+               OpDecorate %samp Binding 0
+       %void = OpTypeVoid
+          %3 = OpTypeFunction %void
+      %float = OpTypeFloat 32
+    %v4float = OpTypeVector %float 4
+         %10 = OpTypeImage %float 2D 0 0 0 1 Unknown
+         %11 = OpTypeSampledImage %10
+%_ptr_UniformConstant_11 = OpTypePointer UniformConstant %11
+       %samp = OpVariable %_ptr_UniformConstant_11 UniformConstant
+    %v2float = OpTypeVector %float 2
+  %float_0_5 = OpConstant %float 0.5
+         %17 = OpConstantComposite %v2float %float_0_5 %float_0_5
+       %uint = OpTypeInt 32 0
+        %int = OpTypeInt 32 1
+     %v2uint = OpTypeVector %uint 2
+     %uint_0 = OpConstant %uint 0
+      %int_0 = OpConstant %int 0
+  %uint_n100 = OpConstant %uint 4294967196
+%offset_n100 = OpConstantComposite %v2uint %uint_0 %uint_n100
+       %main = OpFunction %void None %3
+          %5 = OpLabel
+         %14 = OpLoad %11 %samp
+         %25 = OpImageGather %v4float %14 %17 %int_0 ConstOffset %offset_n100
+               OpReturn
+               OpFunctionEnd
+        )";
+    std::vector<uint32_t> spv;
+    ASSERT_TRUE(ASMtoSPV(SPV_ENV_VULKAN_1_0, 0, spv_source, spv));
+
+    VkValidationCacheCreateInfoEXT cache_ci = vku::InitStructHelper();
+    VkValidationCacheEXT cache = VK_NULL_HANDLE;
+    ASSERT_EQ(VK_SUCCESS, vk::CreateValidationCacheEXT(device(), &cache_ci, nullptr, &cache));
+
+    VkShaderModuleValidationCacheCreateInfoEXT shader_cache_ci = vku::InitStructHelper();
+    shader_cache_ci.validationCache = cache;
+    VkShaderModuleCreateInfo module_ci = vku::InitStructHelper(&shader_cache_ci);
+    module_ci.codeSize = spv.size() * sizeof(uint32_t);
+    module_ci.pCode = spv.data();
+    const auto create_module = [&]() {
+        VkShaderModule module = VK_NULL_HANDLE;
+        vk::CreateShaderModule(device(), &module_ci, nullptr, &module);
+        if (module != VK_NULL_HANDLE) {
+            vk::DestroyShaderModule(device(), module, nullptr);
+        }
+    };
+
+    // The callback does not ask to skip the call, so the error is logged but the check still returns false
+    m_errorMonitor->SetAllowedFailureMsg("VUID-RuntimeSpirv-OpImage-06377");
+    create_module();
+    m_errorMonitor->Reset();
+
+    m_errorMonitor->SetDesiredError("VUID-RuntimeSpirv-OpImage-06377");
+    create_module();
+    m_errorMonitor->VerifyFound();
+
+    // Only spirv-val passed, the module is the only entry
+    struct Entry {
+        uint64_t key;
+        uint32_t passed_checks;
+        uint32_t checksum;
+    };
+    const size_t header_size = 2 * sizeof(uint32_t) + VK_UUID_SIZE;
+    size_t data_size = 0;
+    ASSERT_EQ(VK_SUCCESS, vk::GetValidationCacheDataEXT(device(), cache, &data_size, nullptr));
+    ASSERT_EQ(header_size + sizeof(Entry), data_size);
+    std::vector<uint8_t> data(data_size);
+    ASSERT_EQ(VK_SUCCESS, vk::GetValidationCacheDataEXT(device(), cache, &data_size, data.data()));
+    Entry entry;
+    std::memcpy(&entry, data.data() + header_size, sizeof(Entry));
+    const uint32_t spirv_val_check = 1u << 0;
+    const uint32_t stateless_spirv_check = 1u << 1;
+    ASSERT_EQ(spirv_val_check, entry.passed_checks);
+    vk::DestroyValidationCacheEXT(device(), cache, nullptr);
+
+    // Once the stateless checks are marked as passed, they are skipped and the error is not reported anymore
+    entry.passed_checks |= stateless_spirv_check;
+    entry.checksum = hash_util::Hash32(&entry, offsetof(Entry, checksum));
+    std::memcpy(data.data() + header_size, &entry, sizeof(Entry));
+    cache_ci.initialDataSize = data.size();
+    cache_ci.pInitialData = data.data();
+    ASSERT_EQ(VK_SUCCESS, vk::CreateValidationCacheEXT(device(), &cache_ci, nullptr, &cache));
+    shader_cache_ci.validationCache = cache;
+    create_module();
+    vk::DestroyValidationCacheEXT(device(), cache, nullptr);
+}
+
 TEST_F(VkLayerTest, UnclosedAndDuplicateQueries) {
     TEST_DESCRIPTION("End a command buffer with a query still in progress, create nested queries.");
 
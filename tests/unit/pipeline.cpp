@@ -13,6 +13,7 @@
  */
 
 #include "utils/cast_utils.h"
+#include "utils/fixed_function_state.h"
 #include "../framework/layer_validation_tests.h"
 #include "../framework/pipeline_helper.h"
 #include "../framework/descriptor_helper.h"
@@ -3834,3 +3835,69 @@ TEST_F(NegativePipeline, Viewport) {
         CreatePipelineHelper::OneshotTest(*this, break_vp, kErrorBit, test_case.vuids);
     }
 }
+
+TEST_F(NegativePipeline, SharedFixedFunctionState) {
+    TEST_DESCRIPTION("Pipelines with identical fixed function state share it, pipelines with different state must not");
+    AddRequiredFeature(vkt::Feature::depthBounds);
+    RETURN_IF_SKIP(Init());
+
+    m_depth_stencil_fmt = FindSupportedDepthStencilFormat(Gpu());
+    m_depthStencil->Init(*m_device, m_width, m_height, 1, m_depth_stencil_fmt, VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT);
+    vkt::ImageView depth_image_view = m_depthStencil->CreateView(VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT);
+    InitRenderTarget(&depth_image_view.handle());
+
+    auto create_pipeline = [this](CreatePipelineHelper &pipe, VkBool32 depth_bounds_test_enable) {
+        pipe.ds_ci_ = vku::InitStructHelper();
+        pipe.ds_ci_.depthBoundsTestEnable = depth_bounds_test_enable;
+        pipe.AddDynamicState(VK_DYNAMIC_STATE_DEPTH_BOUNDS);
+        pipe.CreateGraphicsPipeline();
+    };
+    CreatePipelineHelper pipe_enabled(*this);
+    create_pipeline(pipe_enabled, VK_TRUE);
+    CreatePipelineHelper pipe_disabled(*this);
+    create_pipeline(pipe_disabled, VK_FALSE);
+    CreatePipelineHelper pipe_enabled_2(*this);
+    create_pipeline(pipe_enabled_2, VK_TRUE);
+
+    // The states kept by the layer come from the same interning, equal states (even made from different structs, or from a
+    // safe struct copy) are the same object
+    const auto ds_state = ToSafeDepthStencilState(pipe_enabled.ds_ci_);
+    ASSERT_EQ(ds_state, ToSafeDepthStencilState(pipe_enabled_2.ds_ci_));
+    ASSERT_EQ(ds_state, ToSafeDepthStencilState(vku::safe_VkPipelineDepthStencilStateCreateInfo(&pipe_enabled_2.ds_ci_)));
+    ASSERT_NE(ds_state, ToSafeDepthStencilState(pipe_disabled.ds_ci_));
+
+    // Each helper has its own attachment array
+    const auto cb_state = ToSafeColorBlendState(pipe_enabled.cb_ci_);
+    ASSERT_EQ(cb_state, ToSafeColorBlendState(pipe_disabled.cb_ci_));
+    ASSERT_EQ(cb_state, ToSafeColorBlendState(vku::safe_VkPipelineColorBlendStateCreateInfo(&pipe_enabled_2.cb_ci_)));
+    VkPipelineColorBlendAttachmentState blend_attachment = pipe_enabled.cb_attachments_;
+    blend_attachment.blendEnable = blend_attachment.blendEnable ? VK_FALSE : VK_TRUE;
+    VkPipelineColorBlendStateCreateInfo cb_ci = pipe_enabled.cb_ci_;
+    cb_ci.pAttachments = &blend_attachment;
+    ASSERT_NE(cb_state, ToSafeColorBlendState(cb_ci));
+
+    const VkSampleMask sample_mask = 0x1;
+    const VkSampleMask sample_mask_2 = 0x1;
+    VkPipelineMultisampleStateCreateInfo ms_ci = pipe_enabled.ms_ci_;
+    ms_ci.pSampleMask = &sample_mask;
+    VkPipelineMultisampleStateCreateInfo ms_ci_2 = pipe_disabled.ms_ci_;
+    ms_ci_2.pSampleMask = &sample_mask_2;
+    const auto ms_state = ToSafeMultisampleState(ms_ci);
+    ASSERT_EQ(ms_state, ToSafeMultisampleState(ms_ci_2));
+    ASSERT_EQ(ms_state, ToSafeMultisampleState(vku::safe_VkPipelineMultisampleStateCreateInfo(&ms_ci_2)));
+    ASSERT_NE(ms_state, ToSafeMultisampleState(pipe_enabled.ms_ci_));
+
+    m_command_buffer.Begin();
+    m_command_buffer.BeginRenderPass(m_renderPassBeginInfo);
+    vk::CmdBindPipeline(m_command_buffer.handle(), VK_PIPELINE_BIND_POINT_GRAPHICS, pipe_disabled.Handle());
+    vk::CmdDraw(m_command_buffer.handle(), 3, 1, 0, 0);
+
+    for (const auto *pipe : {&pipe_enabled, &pipe_enabled_2}) {
+        vk::CmdBindPipeline(m_command_buffer.handle(), VK_PIPELINE_BIND_POINT_GRAPHICS, pipe->Handle());
+        m_errorMonitor->SetDesiredError("VUID-vkCmdDraw-None-07836");
+        vk::CmdDraw(m_command_buffer.handle(), 3, 1, 0, 0);
+        m_errorMonitor->VerifyFound();
+    }
+    m_command_buffer.EndRenderPass();
+    m_command_buffer.End();
+}
@@ -1280,4 +1280,52 @@ TEST_F(PositiveRenderPass, RenderPassSampleLocationsBeginInfo) {
     vk::CmdBindPipeline(m_command_buffer.handle(), VK_PIPELINE_BIND_POINT_GRAPHICS, pipe.Handle());
     m_command_buffer.EndRenderPass();
     m_command_buffer.End();
-}
\ No newline at end of file
+}
+
+TEST_F(PositiveRenderPass, CompatibleRenderPassesDifferentOps) {
+    TEST_DESCRIPTION("Use pipelines and framebuffers across render passes that only differ in load/store ops and layouts.");
+    RETURN_IF_SKIP(Init());
+    InitRenderTarget();
+
+    RenderPassSingleSubpass rp_load(*this);
+    rp_load.AddAttachmentDescription(m_render_target_fmt, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+                                     VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, VK_ATTACHMENT_LOAD_OP_LOAD,
+                                     VK_ATTACHMENT_STORE_OP_STORE);
+    rp_load.AddAttachmentReference({0, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL});
+    rp_load.AddColorAttachment(0);
+    rp_load.CreateRenderPass();
+
+    RenderPassSingleSubpass rp_dont_care(*this);
+    rp_dont_care.AddAttachmentDescription(m_render_target_fmt, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_GENERAL,
+                                          VK_ATTACHMENT_LOAD_OP_DONT_CARE, VK_ATTACHMENT_STORE_OP_DONT_CARE);
+    rp_dont_care.AddAttachmentReference({0, VK_IMAGE_LAYOUT_GENERAL});
+    rp_dont_care.AddColorAttachment(0);
+    rp_dont_care.CreateRenderPass();
+
+    CreatePipelineHelper pipe_load(*this);
+    pipe_load.gp_ci_.renderPass = rp_load.Handle();
+    pipe_load.CreateGraphicsPipeline();
+
+    CreatePipelineHelper pipe_dont_care(*this);
+    pipe_dont_care.gp_ci_.renderPass = rp_dont_care.Handle();
+    pipe_dont_care.CreateGraphicsPipeline();
+
+    vkt::Image image(*m_device, 32, 32, m_render_target_fmt, VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT);
+    vkt::ImageView view = image.CreateView();
+    vkt::Framebuffer fb(*m_device, rp_load.Handle(), 1, &view.handle());
+
+    m_command_buffer.Begin();
+    m_command_buffer.BeginRenderPass(m_renderPassBeginInfo);
+    vk::CmdBindPipeline(m_command_buffer.handle(), VK_PIPELINE_BIND_POINT_GRAPHICS, pipe_load.Handle());
+    vk::CmdDraw(m_command_buffer.handle(), 3, 1, 0, 0);
+    vk::CmdBindPipeline(m_command_buffer.handle(), VK_PIPELINE_BIND_POINT_GRAPHICS, pipe_dont_care.Handle());
+    vk::CmdDraw(m_command_buffer.handle(), 3, 1, 0, 0);
+    m_command_buffer.EndRenderPass();
+
+    // Framebuffer was created with rp_load
+    m_command_buffer.BeginRenderPass(rp_dont_care.Handle(), fb.handle(), 32, 32);
+    vk::CmdBindPipeline(m_command_buffer.handle(), VK_PIPELINE_BIND_POINT_GRAPHICS, pipe_load.Handle());
+    vk::CmdDraw(m_command_buffer.handle(), 3, 1, 0, 0);
+    m_command_buffer.EndRenderPass();
+    m_command_buffer.End();
+}
@@ -4917,3 +4917,30 @@ TEST_F(NegativeSyncObject, MicromapBuildStageWithoutEnabledFeature) {
     m_errorMonitor->VerifyFound();
     m_command_buffer.End();
 }
+
+TEST_F(NegativeSyncObject, ManySubmissionsPartialWait) {
+    TEST_DESCRIPTION("Waiting for a submission must not retire the ones submitted after it, even in a later block of the ring");
+    RETURN_IF_SKIP(Init());
+
+    constexpr uint32_t kSubmissions = 200;
+    constexpr uint32_t kWaited = 100;
+    vkt::CommandBuffer cmd_buffers[kSubmissions];
+    vkt::Fence fences[kSubmissions];
+    for (uint32_t i = 0; i < kSubmissions; ++i) {
+        cmd_buffers[i].Init(*m_device, m_command_pool);
+        fences[i].Init(*m_device);
+        cmd_buffers[i].Begin();
+        cmd_buffers[i].End();
+        m_default_queue->Submit(cmd_buffers[i], fences[i]);
+    }
+    fences[kWaited].Wait(kWaitTimeout);
+
+    cmd_buffers[kWaited].Begin();
+    cmd_buffers[kWaited].End();
+
+    VkCommandBufferBeginInfo begin_info = vku::InitStructHelper();
+    m_errorMonitor->SetDesiredError("VUID-vkBeginCommandBuffer-commandBuffer-00049");
+    vk::BeginCommandBuffer(cmd_buffers[kWaited + 50], &begin_info);
+    m_errorMonitor->VerifyFound();
+    m_default_queue->Wait();
+}
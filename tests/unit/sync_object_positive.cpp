@@ -328,6 +328,125 @@ TEST_F(PositiveSyncObject, TwoFencesThreeFrames) {
     }
 }
 
+TEST_F(PositiveSyncObject, ManySubmissionsPartialWait) {
+    TEST_DESCRIPTION("Retire submissions spanning several blocks of the queue's in-flight ring, then reuse the reclaimed blocks");
+    RETURN_IF_SKIP(Init());
+
+    // Submissions are stored in blocks of 64, so this uses several blocks and waits in the middle of one
+    constexpr uint32_t kSubmissions = 200;
+    constexpr uint32_t kWaited = 150;
+    vkt::CommandBuffer cmd_buffers[kSubmissions];
+    vkt::Fence fences[kSubmissions];
+    for (uint32_t i = 0; i < kSubmissions; ++i) {
+        cmd_buffers[i].Init(*m_device, m_command_pool);
+        fences[i].Init(*m_device);
+    }
+
+    for (uint32_t round = 0; round < 2; ++round) {
+        for (uint32_t i = 0; i < kSubmissions; ++i) {
+            cmd_buffers[i].Begin();
+            cmd_buffers[i].End();
+            m_default_queue->Submit(cmd_buffers[i], fences[i]);
+        }
+        // Everything up to the waited submission is retired, so those command buffers can be recorded again
+        fences[kWaited].Wait(kWaitTimeout);
+        for (uint32_t i = 0; i <= kWaited; ++i) {
+            cmd_buffers[i].Begin();
+            cmd_buffers[i].End();
+        }
+        m_default_queue->Wait();
+        for (uint32_t i = 0; i < kSubmissions; ++i) {
+            fences[i].Reset();
+        }
+    }
+}
+
+TEST_F(PositiveSyncObject, FenceWaitRetiresSignalingQueueFirst) {
+    TEST_DESCRIPTION("Waiting for a submission that waits on another queue retires the signaling submission before returning");
+    all_queue_count_ = true;
+    RETURN_IF_SKIP(Init());
+    if (!m_second_queue) {
+        GTEST_SKIP() << "Test requires two queues";
+    }
+
+    vkt::CommandPool second_pool(*m_device, m_second_queue->family_index);
+    vkt::CommandBuffer signal_cb(*m_device, m_command_pool);
+    vkt::CommandBuffer wait_cb(*m_device, second_pool);
+    vkt::Semaphore semaphore(*m_device);
+    vkt::Fence fence(*m_device);
+
+    for (uint32_t frame = 0; frame < 3; ++frame) {
+        signal_cb.Begin();
+        signal_cb.End();
+        wait_cb.Begin();
+        wait_cb.End();
+
+        m_default_queue->Submit(signal_cb, vkt::Signal(semaphore));
+        m_second_queue->Submit(wait_cb, vkt::Wait(semaphore), fence);
+        // Only the second queue is waited on, the first queue is retired because the wait depends on it
+        fence.Wait(kWaitTimeout);
+        fence.Reset();
+    }
+    m_device->Wait();
+}
+
+TEST_F(PositiveSyncObject, WaitForFencesOnSeveralQueues) {
+    TEST_DESCRIPTION("Wait for all fences signaled by different queues, then reuse their command buffers");
+    all_queue_count_ = true;
+    RETURN_IF_SKIP(Init());
+    if (!m_second_queue) {
+        GTEST_SKIP() << "Test requires two queues";
+    }
+
+    vkt::CommandPool second_pool(*m_device, m_second_queue->family_index);
+    vkt::CommandBuffer cb0(*m_device, m_command_pool);
+    vkt::CommandBuffer cb1(*m_device, second_pool);
+    vkt::Fence fence0(*m_device);
+    vkt::Fence fence1(*m_device);
+    VkFence fences[] = {fence0.handle(), fence1.handle()};
+
+    for (uint32_t frame = 0; frame < 3; ++frame) {
+        cb0.Begin();
+        cb0.End();
+        cb1.Begin();
+        cb1.End();
+
+        // Several submissions per queue, so the waits target the last one of a batch
+        for (uint32_t i = 0; i < 4; ++i) {
+            m_default_queue->Submit(vkt::no_cmd);
+            m_second_queue->Submit(vkt::no_cmd);
+        }
+        m_default_queue->Submit(cb0, fence0);
+        m_second_queue->Submit(cb1, fence1);
+
+        vk::WaitForFences(device(), 2, fences, VK_TRUE, kWaitTimeout);
+        vk::ResetFences(device(), 2, fences);
+    }
+}
+
+TEST_F(PositiveSyncObject, DestroyRetiredObjectsWhileQueueInFlight) {
+    TEST_DESCRIPTION("Free the objects of a retired submission while later submissions on the same queue are still in flight");
+    AddRequiredExtensions(VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME);
+    AddRequiredFeature(vkt::Feature::timelineSemaphore);
+    RETURN_IF_SKIP(Init());
+
+    vkt::Semaphore timeline(*m_device, VK_SEMAPHORE_TYPE_TIMELINE);
+    vkt::Fence pending_fence(*m_device);
+    {
+        vkt::CommandBuffer cb(*m_device, m_command_pool);
+        vkt::Fence fence(*m_device);
+        cb.Begin();
+        cb.End();
+        m_default_queue->Submit(cb, fence);
+        // Can't complete before the host signal below
+        m_default_queue->Submit(vkt::no_cmd, vkt::TimelineWait(timeline, 1), pending_fence);
+        fence.Wait(kWaitTimeout);
+        // The command buffer and fence are destroyed here, while the queue still has the pending submission
+    }
+    timeline.Signal(1);
+    pending_fence.Wait(kWaitTimeout);
+}
+
 TEST_F(PositiveSyncObject, TwoQueueSubmitsSeparateQueuesWithSemaphoreAndOneFenceQWI) {
     TEST_DESCRIPTION(
         "Two command buffers, each in a separate QueueSubmit call submitted on separate queues followed by a QueueWaitIdle.");
@@ -2310,6 +2429,63 @@ TEST_F(PositiveSyncObject, TimelineSubmitWaitThenHostSignalLargerValue) {
     m_default_queue->Wait();
 }
 
+TEST_F(PositiveSyncObject, TimelineOutOfOrderWaits) {
+    TEST_DESCRIPTION("Submit waits with decreasing values, before and after the semaphore tracks them out of order");
+    SetTargetApiVersion(VK_API_VERSION_1_2);
+    AddRequiredFeature(vkt::Feature::timelineSemaphore);
+    RETURN_IF_SKIP(Init());
+
+    vkt::Semaphore semaphore(*m_device, VK_SEMAPHORE_TYPE_TIMELINE);
+    vkt::Fence fence(*m_device);
+
+    // Increasing values
+    m_default_queue->Submit(vkt::no_cmd, vkt::TimelineWait(semaphore, 1));
+    m_default_queue->Submit(vkt::no_cmd, vkt::TimelineWait(semaphore, 2));
+    semaphore.Signal(2);
+    m_default_queue->Wait();
+
+    // A wait below the last pending value switches the semaphore to out of order tracking
+    m_default_queue->Submit(vkt::no_cmd, vkt::TimelineWait(semaphore, 10));
+    m_default_queue->Submit(vkt::no_cmd, vkt::TimelineWait(semaphore, 5));
+    m_default_queue->Submit(vkt::no_cmd, vkt::TimelineWait(semaphore, 7), fence);
+    semaphore.Signal(6);
+    semaphore.Signal(10);
+    fence.Wait(kWaitTimeout);
+    fence.Reset();
+
+    // Everything pending was retired, increasing values again
+    m_default_queue->Submit(vkt::no_cmd, vkt::TimelineSignal(semaphore, 11));
+    m_default_queue->Submit(vkt::no_cmd, vkt::TimelineWait(semaphore, 11));
+    m_default_queue->Submit(vkt::no_cmd, vkt::TimelineWait(semaphore, 12), fence);
+    semaphore.Signal(12);
+    fence.Wait(kWaitTimeout);
+}
+
+TEST_F(PositiveSyncObject, TimelineDestroyWithPendingTimepoints) {
+    TEST_DESCRIPTION("Destroy timeline semaphores that still have host waits pending, in increasing and decreasing order");
+    SetTargetApiVersion(VK_API_VERSION_1_2);
+    AddRequiredFeature(vkt::Feature::timelineSemaphore);
+    RETURN_IF_SKIP(Init());
+    if (IsPlatformMockICD()) {
+        GTEST_SKIP() << "Test not supported by MockICD (WaitSemaphores)";
+    }
+
+    // Host waits that time out are never retired
+    vkt::Semaphore increasing(*m_device, VK_SEMAPHORE_TYPE_TIMELINE);
+    m_default_queue->Submit(vkt::no_cmd, vkt::TimelineSignal(increasing, 1));
+    m_default_queue->Wait();
+    ASSERT_EQ(VK_TIMEOUT, increasing.Wait(3, 0));
+    ASSERT_EQ(VK_TIMEOUT, increasing.Wait(7, 0));
+    increasing.destroy();
+
+    vkt::Semaphore decreasing(*m_device, VK_SEMAPHORE_TYPE_TIMELINE);
+    m_default_queue->Submit(vkt::no_cmd, vkt::TimelineSignal(decreasing, 1));
+    m_default_queue->Wait();
+    ASSERT_EQ(VK_TIMEOUT, decreasing.Wait(7, 0));
+    ASSERT_EQ(VK_TIMEOUT, decreasing.Wait(3, 0));
+    decreasing.destroy();
+}
+
 TEST_F(PositiveSyncObject, PollSemaphoreCounter) {
     TEST_DESCRIPTION("Basic semaphore polling test");
     SetTargetApiVersion(VK_API_VERSION_1_2);
@@ -16,6 +16,7 @@
 #include "../framework/render_pass_helper.h"
 #include "../framework/descriptor_helper.h"
 #include "../framework/queue_submit_context.h"
+#include "../layers/sync/sync_settings.h"
 #include <utils/vk_layer_utils.h>
 
 class NegativeSyncVal : public VkSyncValTest {};
@@ -5493,6 +5494,228 @@ TEST_F(NegativeSyncVal, WriteSameLocationFromTwoSubmits) {
     m_default_queue->Wait();
 }
 
+TEST_F(NegativeSyncVal, SubmitTimeHazardManyRegions) {
+    TEST_DESCRIPTION("Submit time hazard in a command buffer with enough accesses to be checked by several threads");
+    RETURN_IF_SKIP(InitSyncVal());
+
+    // Gaps between the regions keep them as separate entries in the access map
+    constexpr uint32_t region_count = 1024;
+    constexpr VkDeviceSize region_size = 16;
+    vkt::Buffer buffer_a(*m_device, region_count * region_size * 2, VK_BUFFER_USAGE_TRANSFER_SRC_BIT);
+    vkt::Buffer buffer_b(*m_device, region_count * region_size * 2,
+                         VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT);
+    vkt::Buffer buffer_c(*m_device, region_count * region_size * 2, VK_BUFFER_USAGE_TRANSFER_DST_BIT);
+    std::vector<VkBufferCopy> regions(region_count);
+    for (uint32_t i = 0; i < region_count; ++i) {
+        regions[i] = {i * region_size * 2, i * region_size * 2, region_size};
+    }
+
+    vkt::CommandBuffer cb0(*m_device, m_command_pool);
+    vkt::CommandBuffer cb1(*m_device, m_command_pool);
+    cb0.Begin();
+    vk::CmdCopyBuffer(cb0, buffer_a, buffer_b, region_count, regions.data());
+    cb0.End();
+    cb1.Begin();
+    vk::CmdCopyBuffer(cb1, buffer_b, buffer_c, region_count, regions.data());
+    cb1.End();
+
+    VkCommandBuffer command_buffers[2] = {cb0, cb1};
+    VkSubmitInfo submit = vku::InitStructHelper();
+    submit.commandBufferCount = 2;
+    submit.pCommandBuffers = command_buffers;
+    // Every region of b is read without waiting for the copy into it, only the first hazard is reported
+    m_errorMonitor->SetDesiredError("SYNC-HAZARD-READ-AFTER-WRITE");
+    vk::QueueSubmit(m_default_queue->handle(), 1, &submit, VK_NULL_HANDLE);
+    m_errorMonitor->VerifyFound();
+    m_default_queue->Wait();
+}
+
+TEST_F(NegativeSyncVal, HazardAmongSynchronizedEntries) {
+    TEST_DESCRIPTION("One unsynchronized entry among many synchronized ones is found by each kind of access that scans them");
+    RETURN_IF_SKIP(InitSyncVal());
+
+    // Gaps between the regions keep them as separate entries in the access map
+    constexpr uint32_t region_count = 64;
+    constexpr uint32_t hazard_region = 37;
+    constexpr VkDeviceSize region_size = 16;
+    const VkBufferUsageFlags buffer_usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    vkt::Buffer buffer_a(*m_device, region_count * region_size * 2, buffer_usage);
+    vkt::Buffer buffer_b(*m_device, region_count * region_size * 2, buffer_usage);
+    std::vector<VkBufferCopy> regions(region_count);
+    for (uint32_t i = 0; i < region_count; ++i) {
+        regions[i] = {i * region_size * 2, i * region_size * 2, region_size};
+    }
+    const VkBufferCopy &hazard_copy = regions[hazard_region];
+
+    VkMemoryBarrier barrier = vku::InitStructHelper();
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+
+    // Read after write
+    vkt::CommandBuffer cb_raw(*m_device, m_command_pool);
+    cb_raw.Begin();
+    vk::CmdCopyBuffer(cb_raw, buffer_a, buffer_b, region_count, regions.data());
+    vk::CmdPipelineBarrier(cb_raw, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 1, &barrier, 0, nullptr, 0,
+                           nullptr);
+    vk::CmdFillBuffer(cb_raw, buffer_b, hazard_copy.dstOffset, region_size, 0);
+    m_errorMonitor->SetDesiredError("SYNC-HAZARD-READ-AFTER-WRITE");
+    vk::CmdCopyBuffer(cb_raw, buffer_b, buffer_a, region_count, regions.data());
+    m_errorMonitor->VerifyFound();
+    cb_raw.End();
+
+    // Write after read, the read of the hazard region is repeated after the execution barrier
+    vkt::CommandBuffer cb_war(*m_device, m_command_pool);
+    cb_war.Begin();
+    vk::CmdCopyBuffer(cb_war, buffer_a, buffer_b, region_count, regions.data());
+    vk::CmdPipelineBarrier(cb_war, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 0,
+                           nullptr);
+    const VkBufferCopy reread = {hazard_copy.srcOffset, hazard_copy.dstOffset + region_size, region_size};
+    vk::CmdCopyBuffer(cb_war, buffer_a, buffer_b, 1, &reread);
+    m_errorMonitor->SetDesiredError("SYNC-HAZARD-WRITE-AFTER-READ");
+    vk::CmdFillBuffer(cb_war, buffer_a, 0, VK_WHOLE_SIZE, 0);
+    m_errorMonitor->VerifyFound();
+    cb_war.End();
+
+    // Write after write
+    vkt::CommandBuffer cb_waw(*m_device, m_command_pool);
+    cb_waw.Begin();
+    for (const VkBufferCopy &region : regions) {
+        vk::CmdFillBuffer(cb_waw, buffer_b, region.dstOffset, region_size, 0);
+    }
+    vk::CmdPipelineBarrier(cb_waw, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 1, &barrier, 0, nullptr, 0,
+                           nullptr);
+    vk::CmdFillBuffer(cb_waw, buffer_b, hazard_copy.dstOffset, region_size, 0);
+    m_errorMonitor->SetDesiredError("SYNC-HAZARD-WRITE-AFTER-WRITE");
+    vk::CmdFillBuffer(cb_waw, buffer_b, 0, VK_WHOLE_SIZE, 0);
+    m_errorMonitor->VerifyFound();
+    cb_waw.End();
+
+    // Layout transition, the clears of every mip but one are in the barrier's dependency chain
+    constexpr uint32_t mip_count = 8;
+    constexpr uint32_t hazard_mip = 5;
+    vkt::Image image(*m_device, vkt::Image::ImageCreateInfo2D(128, 128, mip_count, 1, VK_FORMAT_R8G8B8A8_UNORM,
+                                                              VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT));
+    const VkClearColorValue color = {};
+
+    VkImageMemoryBarrier image_barrier = vku::InitStructHelper();
+    image_barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    image_barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    image_barrier.newLayout = VK_IMAGE_LAYOUT_GENERAL;
+    image_barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    image_barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    image_barrier.image = image;
+    image_barrier.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, mip_count, 0, 1};
+
+    vkt::CommandBuffer cb_ilt(*m_device, m_command_pool);
+    cb_ilt.Begin();
+    vk::CmdPipelineBarrier(cb_ilt, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1,
+                           &image_barrier);
+    for (uint32_t mip = 0; mip < mip_count; ++mip) {
+        const VkImageSubresourceRange mip_range = {VK_IMAGE_ASPECT_COLOR_BIT, mip, 1, 0, 1};
+        vk::CmdClearColorImage(cb_ilt, image, VK_IMAGE_LAYOUT_GENERAL, &color, 1, &mip_range);
+    }
+    vk::CmdPipelineBarrier(cb_ilt, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 1, &barrier, 0, nullptr, 0,
+                           nullptr);
+    const VkImageSubresourceRange hazard_mip_range = {VK_IMAGE_ASPECT_COLOR_BIT, hazard_mip, 1, 0, 1};
+    vk::CmdClearColorImage(cb_ilt, image, VK_IMAGE_LAYOUT_GENERAL, &color, 1, &hazard_mip_range);
+
+    // Execution dependency only, which makes the clears before the memory barrier available but not the last one
+    image_barrier.srcAccessMask = 0;
+    image_barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+    image_barrier.oldLayout = VK_IMAGE_LAYOUT_GENERAL;
+    image_barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+    m_errorMonitor->SetDesiredError("SYNC-HAZARD-WRITE-AFTER-WRITE");
+    vk::CmdPipelineBarrier(cb_ilt, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1,
+                           &image_barrier);
+    m_errorMonitor->VerifyFound();
+    cb_ilt.End();
+}
+
+TEST_F(NegativeSyncVal, AsyncSubmitTimeValidation) {
+    TEST_DESCRIPTION("Submit time hazard reported by the background submit validation");
+    SyncValSettings settings;
+    settings.submit_time_validation = true;
+    settings.submit_time_validation_async = true;
+    RETURN_IF_SKIP(InitSyncVal(&settings));
+
+    vkt::Buffer buffer_a(*m_device, 256, VK_BUFFER_USAGE_TRANSFER_SRC_BIT);
+    vkt::Buffer buffer_b(*m_device, 256, VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT);
+    vkt::Buffer buffer_c(*m_device, 256, VK_BUFFER_USAGE_TRANSFER_DST_BIT);
+
+    vkt::CommandBuffer cb0(*m_device, m_command_pool);
+    vkt::CommandBuffer cb1(*m_device, m_command_pool);
+    cb0.Begin();
+    cb0.Copy(buffer_a, buffer_b);
+    cb0.End();
+    cb1.Begin();
+    cb1.Copy(buffer_b, buffer_c);
+    cb1.End();
+
+    VkCommandBuffer command_buffers[2] = {cb0, cb1};
+    VkSubmitInfo submit = vku::InitStructHelper();
+    submit.commandBufferCount = 2;
+    submit.pCommandBuffers = command_buffers;
+    m_errorMonitor->SetDesiredError("SYNC-HAZARD-READ-AFTER-WRITE");
+    vk::QueueSubmit(m_default_queue->handle(), 1, &submit, VK_NULL_HANDLE);
+    m_default_queue->Wait();
+
+    // Re-recording waits for the validation of the submit that used the command buffer
+    cb1.Begin();
+    m_errorMonitor->VerifyFound();
+    cb1.End();
+
+    // State recorded by the background validation is seen by the following submits
+    m_default_queue->Submit(cb1);
+    m_default_queue->Wait();
+    cb1.Begin();
+    cb1.End();
+}
+
+TEST_F(NegativeSyncVal, FirstUseSummaryRerecord) {
+    TEST_DESCRIPTION("Submit time validation of re-submitted and re-recorded command buffers");
+    SyncValSettings settings;
+    settings.submit_time_validation = true;
+    RETURN_IF_SKIP(InitSyncVal(&settings));
+
+    vkt::Buffer buffer_a(*m_device, 256, VK_BUFFER_USAGE_TRANSFER_SRC_BIT);
+    vkt::Buffer buffer_b(*m_device, 256, VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT);
+    vkt::Buffer buffer_c(*m_device, 256, VK_BUFFER_USAGE_TRANSFER_DST_BIT);
+
+    vkt::CommandBuffer cb0(*m_device, m_command_pool);
+    vkt::CommandBuffer cb1(*m_device, m_command_pool);
+    cb0.Begin();
+    cb0.Copy(buffer_a, buffer_b);
+    cb0.End();
+
+    // The read of buffer_b is after a barrier, submitting it several times reuses its first access summary
+    VkMemoryBarrier mem_barrier = vku::InitStructHelper();
+    mem_barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    mem_barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+    cb1.Begin();
+    vk::CmdPipelineBarrier(cb1, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 1, &mem_barrier, 0, nullptr, 0,
+                           nullptr);
+    cb1.Copy(buffer_b, buffer_c);
+    cb1.End();
+
+    VkCommandBuffer command_buffers[2] = {cb0, cb1};
+    VkSubmitInfo submit = vku::InitStructHelper();
+    submit.commandBufferCount = 2;
+    submit.pCommandBuffers = command_buffers;
+    for (int i = 0; i < 2; ++i) {
+        vk::QueueSubmit(m_default_queue->handle(), 1, &submit, VK_NULL_HANDLE);
+        m_default_queue->Wait();
+    }
+
+    // Without the barrier the summary built for the previous recording must not be used
+    cb1.Begin();
+    cb1.Copy(buffer_b, buffer_c);
+    cb1.End();
+    m_errorMonitor->SetDesiredError("SYNC-HAZARD-READ-AFTER-WRITE");
+    vk::QueueSubmit(m_default_queue->handle(), 1, &submit, VK_NULL_HANDLE);
+    m_errorMonitor->VerifyFound();
+    m_default_queue->Wait();
+}
+
 TEST_F(NegativeSyncVal, ResourceHandleIndexStability) {
     TEST_DESCRIPTION("Test that stale handle indices (inconsistent state after core validation error) are handled correctly");
     RETURN_IF_SKIP(InitSyncVal());
@@ -11,6 +11,10 @@
  *     http://www.apache.org/licenses/LICENSE-2.0
  */
 
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <random>
 #include <thread>
 #include "../framework/layer_validation_tests.h"
 #include "../framework/pipeline_helper.h"
@@ -19,6 +23,7 @@
 #include "../framework/thread_helper.h"
 #include "../framework/queue_submit_context.h"
 #include "../layers/sync/sync_settings.h"
+#include "utils/vk_layer_utils.h"
 
 class PositiveSyncVal : public VkSyncValTest {};
 
@@ -47,10 +52,29 @@ void VkSyncValTest::InitSyncValFramework(const SyncValSettings *p_sync_settings)
     settings.emplace_back(VkLayerSettingEXT{OBJECT_LAYER_NAME, "syncval_submit_time_validation", VK_LAYER_SETTING_TYPE_BOOL32_EXT,
                                             1, &submit_time_validation});
 
+    const auto submit_time_validation_async = static_cast<VkBool32>(sync_settings.submit_time_validation_async);
+    settings.emplace_back(VkLayerSettingEXT{OBJECT_LAYER_NAME, "syncval_submit_time_validation_async",
+                                            VK_LAYER_SETTING_TYPE_BOOL32_EXT, 1, &submit_time_validation_async});
+
     const auto shader_accesses_heuristic = static_cast<VkBool32>(sync_settings.shader_accesses_heuristic);
     settings.emplace_back(VkLayerSettingEXT{OBJECT_LAYER_NAME, "syncval_shader_accesses_heuristic",
                                             VK_LAYER_SETTING_TYPE_BOOL32_EXT, 1, &shader_accesses_heuristic});
 
+    const uint32_t access_log_memory_budget = sync_settings.access_log_memory_budget;
+    if (access_log_memory_budget != 0) {
+        settings.emplace_back(VkLayerSettingEXT{OBJECT_LAYER_NAME, "syncval_access_log_memory_budget",
+                                                VK_LAYER_SETTING_TYPE_UINT32_EXT, 1, &access_log_memory_budget});
+    }
+
+    const char *stats_file = sync_settings.stats_file.c_str();
+    const uint32_t stats_file_period = sync_settings.stats_file_period;
+    if (!sync_settings.stats_file.empty()) {
+        settings.emplace_back(
+            VkLayerSettingEXT{OBJECT_LAYER_NAME, "syncval_stats_file", VK_LAYER_SETTING_TYPE_STRING_EXT, 1, &stats_file});
+        settings.emplace_back(VkLayerSettingEXT{OBJECT_LAYER_NAME, "syncval_stats_file_period", VK_LAYER_SETTING_TYPE_UINT32_EXT,
+                                                1, &stats_file_period});
+    }
+
     VkLayerSettingsCreateInfoEXT settings_create_info = vku::InitStructHelper();
     settings_create_info.settingCount = size32(settings);
     settings_create_info.pSettings = settings.data();
@@ -73,6 +97,50 @@ void VkSyncValTest::InitSyncVal(const SyncValSettings *p_sync_settings) {
     RETURN_IF_SKIP(InitState());
 }
 
+VkSyncValStatsFileTest::VkSyncValStatsFileTest() {
+    const auto *test_info = ::testing::UnitTest::GetInstance()->current_test_info();
+    const std::string file_name =
+        "syncval_stats_" + std::string(test_info->name()) + "_" + std::to_string(std::random_device{}()) + ".json";
+    stats_file_ = (std::filesystem::path(GetTempFilePath()) / file_name).string();
+}
+
+VkSyncValStatsFileTest::~VkSyncValStatsFileTest() {
+    // The device writes the file again when destroyed
+    ShutdownFramework();
+    std::error_code ec;
+    std::filesystem::remove(stats_file_, ec);
+    std::filesystem::remove(stats_file_ + ".tmp", ec);
+}
+
+std::string VkSyncValStatsFileTest::ReadStatsFile() const {
+    std::ifstream file(stats_file_, std::ios::in);
+    return std::string(std::istreambuf_iterator<char>(file), {});
+}
+
+bool VkSyncValStatsFileTest::BracketsMatch(const std::string &report) {
+    std::string open;
+    for (const char c : report) {
+        if (c == '{' || c == '[') {
+            open.push_back(c);
+        } else if (c == '}' || c == ']') {
+            if (open.empty() || open.back() != (c == '}' ? '{' : '[')) {
+                return false;
+            }
+            open.pop_back();
+        }
+    }
+    return open.empty() && report.find('{') != std::string::npos;
+}
+
+uint64_t VkSyncValStatsFileTest::GetStatsValue(const std::string &report, const char *key) {
+    const size_t key_pos = report.find(key);
+    if (key_pos == std::string::npos) {
+        ADD_FAILURE() << key << " not found in " << report;
+        return 0;
+    }
+    return std::stoull(report.substr(report.find(':', key_pos) + 1));
+}
+
 void VkSyncValTest::InitTimelineSemaphore() {
     SetTargetApiVersion(VK_API_VERSION_1_3);
     AddRequiredFeature(vkt::Feature::synchronization2);
@@ -787,6 +855,35 @@ TEST_F(PositiveSyncVal, QSBufferCopyHazardsDisabled) {
     test.DeviceWait();
 }
 
+class PositiveSyncValStatsFile : public VkSyncValStatsFileTest {};
+
+TEST_F(PositiveSyncValStatsFile, WrittenOnSubmit) {
+    TEST_DESCRIPTION("The stats file is written on submit and has the expected keys.");
+    SyncValSettings settings;
+    settings.submit_time_validation = true;
+    settings.stats_file = stats_file_;
+    RETURN_IF_SKIP(InitSyncVal(&settings));
+
+    vkt::Buffer buffer_a(*m_device, 256, VK_BUFFER_USAGE_TRANSFER_SRC_BIT);
+    vkt::Buffer buffer_b(*m_device, 256, VK_BUFFER_USAGE_TRANSFER_DST_BIT);
+    m_command_buffer.Begin();
+    m_command_buffer.Copy(buffer_a, buffer_b);
+    m_command_buffer.End();
+
+    // The first submit writes the file, the period only limits the later updates
+    m_default_queue->Submit(m_command_buffer);
+    m_default_queue->Wait();
+
+    const std::string report = ReadStatsFile();
+    ASSERT_TRUE(BracketsMatch(report)) << report;
+    for (const char *key : {"\"command_buffer_contexts\"", "\"handle_records\"", "\"handle_record_bytes\"",
+                            "\"submit_validation\"", "\"queues\""}) {
+        ASSERT_NE(std::string::npos, report.find(key)) << key;
+    }
+    // A negative handle record count must not wrap around
+    ASSERT_LT(GetStatsValue(report, "\"handle_record_bytes\""), uint64_t(1) << 48) << report;
+}
+
 TEST_F(PositiveSyncVal, QSTransitionWithSrcNoneStage) {
     TEST_DESCRIPTION(
         "Two submission batches synchronized with binary semaphore. Layout transition in the second batch should not interfere "
@@ -1157,6 +1254,53 @@ TEST_F(PositiveSyncVal, QSSynchronizedWritesAndAsyncWait) {
     transfer_queue->Wait();
 }
 
+TEST_F(PositiveSyncVal, QSFirstAccessSplitCopyOnWrite) {
+    TEST_DESCRIPTION("A write to part of a range must not add to the first accesses recorded for the rest of the range");
+    RETURN_IF_SKIP(InitSyncVal());
+
+    constexpr VkDeviceSize size = 256;
+    constexpr VkDeviceSize write_size = 16;
+    vkt::Buffer buffer(*m_device, size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT);
+    vkt::Buffer dst_buffer(*m_device, size, VK_BUFFER_USAGE_TRANSFER_DST_BIT);
+
+    // The fill is made visible to later writes only for the part that cb2 writes again, the rest only to reads
+    VkBufferMemoryBarrier barriers[2];
+    barriers[0] = vku::InitStructHelper();
+    barriers[0].srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barriers[0].dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+    barriers[0].buffer = buffer;
+    barriers[0].offset = 0;
+    barriers[0].size = write_size;
+    barriers[1] = barriers[0];
+    barriers[1].dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+    barriers[1].offset = write_size;
+    barriers[1].size = size - write_size;
+
+    vkt::CommandBuffer cb1(*m_device, m_command_pool);
+    cb1.Begin();
+    vk::CmdFillBuffer(cb1, buffer, 0, size, 1);
+    vk::CmdPipelineBarrier(cb1, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 2, barriers, 0,
+                           nullptr);
+    cb1.End();
+
+    // The copy records the same first access for the whole buffer, which the entries share until one of them changes. The
+    // fill then splits off the start of the buffer and adds a write to its first accesses only. If that write leaked into the
+    // shared state, the rest of the buffer would get a WAW hazard with the fill from cb1 at submit time.
+    VkBufferCopy region{};
+    region.size = size;
+    vkt::CommandBuffer cb2(*m_device, m_command_pool);
+    cb2.Begin();
+    vk::CmdCopyBuffer(cb2, buffer, dst_buffer, 1, &region);
+    vk::CmdPipelineBarrier(cb2, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 0,
+                           nullptr);
+    vk::CmdFillBuffer(cb2, buffer, 0, write_size, 2);
+    cb2.End();
+
+    m_default_queue->Submit(cb1);
+    m_default_queue->Submit(cb2);
+    m_default_queue->Wait();
+}
+
 // TODO:
 // It has to be this test found a bug in the existing code, so it's disabled until it's fixed.
 // Draw access happen-after loadOp access so it's enough to synchronize with FRAGMENT_SHADER read.
@@ -17,6 +17,7 @@
 
 #include "../framework/layer_validation_tests.h"
 #include "../framework/pipeline_helper.h"
+#include "../layers/sync/sync_settings.h"
 
 struct NegativeSyncValReporting : public VkSyncValTest {};
 
@@ -275,6 +276,54 @@ TEST_F(NegativeSyncValReporting, QSDebugRegion) {
     m_default_queue->Wait();
 }
 
+TEST_F(NegativeSyncValReporting, QSDebugRegionAsyncRerecord) {
+    TEST_DESCRIPTION("Prior access debug region reporting: command buffers re-recorded before async submit validation ran");
+
+    AddRequiredExtensions(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
+    SyncValSettings settings;
+    settings.submit_time_validation = true;
+    settings.submit_time_validation_async = true;
+    RETURN_IF_SKIP(InitSyncValFramework(&settings));
+    RETURN_IF_SKIP(InitState());
+
+    const VkBufferUsageFlags buffer_usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    vkt::Buffer buffer_a(*m_device, 256, buffer_usage);
+    vkt::Buffer buffer_b(*m_device, 256, buffer_usage);
+    vkt::Buffer buffer_c(*m_device, 256, buffer_usage);
+    VkDebugUtilsLabelEXT label = vku::InitStructHelper();
+
+    vkt::CommandBuffer cb0(*m_device, m_command_pool);
+    vkt::CommandBuffer cb1(*m_device, m_command_pool);
+
+    label.pLabelName = "RegionA";
+    cb0.Begin();
+    vk::CmdBeginDebugUtilsLabelEXT(cb0, &label);
+    cb0.Copy(buffer_a, buffer_b);
+    vk::CmdEndDebugUtilsLabelEXT(cb0);
+    cb0.End();
+
+    label.pLabelName = "RegionB";
+    cb1.Begin();
+    vk::CmdBeginDebugUtilsLabelEXT(cb1, &label);
+    cb1.Copy(buffer_c, buffer_a);
+    vk::CmdEndDebugUtilsLabelEXT(cb1);
+    cb1.End();
+
+    std::array command_buffers = {&cb0, &cb1};
+    m_errorMonitor->SetDesiredError("RegionA");
+    m_default_queue->Submit(command_buffers);
+    m_default_queue->Wait();
+
+    // The device is done with the submit, the background validation of it may not be. Re-recording clears the labels and
+    // accesses that validation reads, so it must not start before the validation is finished.
+    cb0.Begin();
+    cb0.Copy(buffer_c, buffer_b);
+    cb0.End();
+    cb1.Begin();
+    cb1.End();
+    m_errorMonitor->VerifyFound();  // SYNC-HAZARD-WRITE-AFTER-READ error message
+}
+
 TEST_F(NegativeSyncValReporting, QSDebugRegion2) {
     TEST_DESCRIPTION("Prior access debug region reporting: previous access is in the previous submission");
 
@@ -578,6 +627,83 @@ TEST_F(NegativeSyncValReporting, QSDebugRegion_Secondary) {
     m_default_queue->Wait();
 }
 
+struct NegativeSyncValReportingStatsFile : public VkSyncValStatsFileTest {};
+
+TEST_F(NegativeSyncValReportingStatsFile, QSDebugRegionCompactedLog) {
+    TEST_DESCRIPTION("Prior access debug region reporting: the previous submission log was compacted to stay in the memory budget");
+
+    AddRequiredExtensions(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
+    SyncValSettings settings;
+    settings.submit_time_validation = true;
+    settings.access_log_memory_budget = 1;  // MB
+    settings.stats_file = stats_file_;
+    settings.stats_file_period = 0;
+    RETURN_IF_SKIP(InitSyncValFramework(&settings));
+    RETURN_IF_SKIP(InitState());
+
+    // More than the budget (at least 32 bytes per record), and every record is still referenced so nothing can be dropped
+    constexpr uint32_t fill_count = 32768;
+    constexpr uint32_t region_count = 48;
+    constexpr VkDeviceSize region_size = 16;
+    const VkBufferUsageFlags buffer_usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    vkt::Buffer buffer_a(*m_device, region_size, buffer_usage);
+    vkt::Buffer buffer_b(*m_device, region_count * region_size, buffer_usage);
+    vkt::Buffer buffer_c(*m_device, region_size, buffer_usage);
+    vkt::Buffer buffer_d(*m_device, region_size, buffer_usage);
+    vkt::Buffer buffer_fill(*m_device, fill_count * region_size, buffer_usage);
+
+    vkt::CommandBuffer cb_fill(*m_device, m_command_pool);
+    cb_fill.Begin();
+    for (uint32_t i = 0; i < fill_count; ++i) {
+        vk::CmdFillBuffer(cb_fill, buffer_fill, i * region_size, region_size, i);
+    }
+    cb_fill.End();
+    m_default_queue->Submit(cb_fill);
+
+    // Too small to be compacted unless the logs are over the budget. The copies are overwritten, only the last copy's read of
+    // buffer_c, the fill and the read of buffer_a stay referenced.
+    VkDebugUtilsLabelEXT label = vku::InitStructHelper();
+    label.pLabelName = "RegionA";
+    vkt::CommandBuffer cb0(*m_device, m_command_pool);
+    cb0.Begin();
+    vk::CmdBeginDebugUtilsLabelEXT(cb0, &label);
+    for (uint32_t i = 0; i < region_count; ++i) {
+        const VkBufferCopy region = {0, i * region_size, region_size};
+        vk::CmdCopyBuffer(cb0, buffer_c, buffer_b, 1, &region);
+    }
+    VkMemoryBarrier barrier = vku::InitStructHelper();
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    vk::CmdPipelineBarrier(cb0, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 1, &barrier, 0, nullptr, 0,
+                           nullptr);
+    vk::CmdFillBuffer(cb0, buffer_b, 0, VK_WHOLE_SIZE, 0);
+    cb0.Copy(buffer_a, buffer_d);
+    vk::CmdEndDebugUtilsLabelEXT(cb0);
+    cb0.End();
+    m_default_queue->Submit(cb0);
+
+    // Stats are written during submit validation, before the submitted batch replaces the previous one
+    const uint64_t fill_log_bytes = GetStatsValue(ReadStatsFile(), "\"access_log_bytes\"");
+    ASSERT_GE(fill_log_bytes, fill_count * 32u);
+
+    vkt::CommandBuffer cb1(*m_device, m_command_pool);
+    cb1.Begin();
+    cb1.Copy(buffer_c, buffer_a);
+    cb1.End();
+    m_errorMonitor->SetDesiredError("RegionA");
+    m_default_queue->Submit(cb1);
+    m_errorMonitor->VerifyFound();  // SYNC-HAZARD-WRITE-AFTER-READ error message
+    const std::string report = ReadStatsFile();
+    m_default_queue->Wait();
+
+    // The fill log takes at most twice its record size per record (vector growth), so uncompacted cb0 would take at least half
+    // of that for each of its records. Compacted, only the few referenced records are left.
+    const uint64_t log_bytes = GetStatsValue(report, "\"access_log_bytes\"");
+    ASSERT_GE(log_bytes, fill_log_bytes);
+    const uint64_t cb0_record_count = region_count + 2;
+    ASSERT_LT(log_bytes - fill_log_bytes, cb0_record_count * fill_log_bytes / (2 * fill_count));
+}
+
 TEST_F(NegativeSyncValReporting, StaleLabelCommand) {
     TEST_DESCRIPTION("Try to access stale label command when core validation error breaks state invariants");
     AddRequiredExtensions(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2025 The Khronos Group Inc.
+ * Copyright (c) 2025 Valve Corporation
+ * Copyright (c) 2025 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ */
+
+#include "../framework/test_common.h"
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "containers/inline_function.h"
+
+namespace {
+
+// Counts the live copies of a callable, to check that every one of them is destroyed
+struct CountedCallable {
+    explicit CountedCallable(int *live_count, int value) : live_count(live_count), value(value) { ++*live_count; }
+    CountedCallable(const CountedCallable &other) : live_count(other.live_count), value(other.value) { ++*live_count; }
+    CountedCallable(CountedCallable &&other) noexcept : live_count(other.live_count), value(other.value) { ++*live_count; }
+    ~CountedCallable() { --*live_count; }
+    int operator()(int x) const { return x + value; }
+
+    int *live_count;
+    int value;
+};
+
+// Bigger than the inline store
+struct LargeCallable {
+    std::array<uint64_t, 16> payload{};
+    int operator()(int x) const { return x + static_cast<int>(payload[15]); }
+};
+
+// Fits in the inline store, but can't be moved without throwing
+struct ThrowingMoveCallable {
+    ThrowingMoveCallable() = default;
+    ThrowingMoveCallable(const ThrowingMoveCallable &) = default;
+    ThrowingMoveCallable(ThrowingMoveCallable &&) noexcept(false) {}
+    int operator()(int x) const { return x * 2; }
+};
+
+}  // namespace
+
+TEST(InlineFunction, Empty) {
+    vvl::inline_function<void()> f;
+    ASSERT_FALSE(f);
+    vvl::inline_function<void()> g(nullptr);
+    ASSERT_FALSE(g);
+}
+
+TEST(InlineFunction, VoidSignatureDiscardsResult) {
+    int calls = 0;
+    vvl::inline_function<void(int)> f([&calls](int x) {
+        ++calls;
+        return x * 2;
+    });
+    f(1);
+    ASSERT_EQ(1, calls);
+
+    LargeCallable large;
+    vvl::inline_function<void(int)> g(large);
+    g(1);
+}
+
+TEST(InlineFunction, InlineCopyMove) {
+    int live_count = 0;
+    {
+        vvl::inline_function<int(int)> f(CountedCallable(&live_count, 10));
+        ASSERT_TRUE(f);
+        ASSERT_EQ(1, live_count);
+        ASSERT_EQ(11, f(1));
+
+        vvl::inline_function<int(int)> copy(f);
+        ASSERT_EQ(2, live_count);
+        ASSERT_EQ(12, copy(2));
+        ASSERT_EQ(12, f(2));
+
+        vvl::inline_function<int(int)> moved(std::move(f));
+        ASSERT_FALSE(f);
+        ASSERT_EQ(2, live_count);
+        ASSERT_EQ(13, moved(3));
+
+        copy = moved;
+        ASSERT_EQ(2, live_count);
+        f = std::move(copy);
+        ASSERT_FALSE(copy);
+        ASSERT_EQ(2, live_count);
+        ASSERT_EQ(14, f(4));
+
+        f.reset();
+        ASSERT_FALSE(f);
+        ASSERT_EQ(1, live_count);
+    }
+    ASSERT_EQ(0, live_count);
+}
+
+TEST(InlineFunction, HeapFallback) {
+    LargeCallable large;
+    large.payload[15] = 100;
+    static_assert(sizeof(LargeCallable) > vvl::inline_function<int(int)>::kInlineSize);
+
+    vvl::inline_function<int(int)> f(large);
+    ASSERT_EQ(101, f(1));
+
+    vvl::inline_function<int(int)> copy(f);
+    ASSERT_EQ(102, copy(2));
+    ASSERT_EQ(102, f(2));
+
+    vvl::inline_function<int(int)> moved(std::move(f));
+    ASSERT_FALSE(f);
+    ASSERT_EQ(103, moved(3));
+
+    // Callables that could throw while moved are also heap allocated, so moving the inline_function never throws
+    vvl::inline_function<int(int)> throwing_move{ThrowingMoveCallable()};
+    vvl::inline_function<int(int)> throwing_move_moved(std::move(throwing_move));
+    ASSERT_EQ(8, throwing_move_moved(4));
+}
+
+TEST(InlineFunction, HeapDestructorCalls) {
+    int live_count = 0;
+    {
+        // Large enough to not fit inline
+        std::array<uint64_t, 16> payload{};
+        auto shared = std::make_shared<CountedCallable>(&live_count, 5);
+        vvl::inline_function<int(int)> f([payload, shared](int x) { return (*shared)(x) + static_cast<int>(payload[0]); });
+        ASSERT_EQ(6, f(1));
+
+        vvl::inline_function<int(int)> copy(f);
+        vvl::inline_function<int(int)> moved(std::move(f));
+        shared.reset();
+        ASSERT_EQ(1, live_count);
+        copy.reset();
+        ASSERT_EQ(1, live_count);
+        ASSERT_EQ(7, moved(2));
+    }
+    ASSERT_EQ(0, live_count);
+}
+
+TEST(InlineFunction, InVector) {
+    int live_count = 0;
+    {
+        std::vector<vvl::inline_function<int(int)>> functions;
+        for (int i = 0; i < 32; ++i) {
+            functions.emplace_back(CountedCallable(&live_count, i));
+        }
+        ASSERT_EQ(32, live_count);
+        for (int i = 0; i < 32; ++i) {
+            ASSERT_EQ(i + 1, functions[i](1));
+        }
+        functions.clear();
+        ASSERT_EQ(0, live_count);
+    }
+    ASSERT_EQ(0, live_count);
+}
@@ -0,0 +1,392 @@
+/*
+ * Copyright (c) 2025 The Khronos Group Inc.
+ * Copyright (c) 2025 Valve Corporation
+ * Copyright (c) 2025 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ */
+
+#include "../framework/test_common.h"
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "containers/node_pool_allocator.h"
+#include "containers/range_map.h"
+#include "containers/segmented_map.h"
+
+namespace {
+
+// Stand in for the syncval access state, big enough that node allocation and layout matter
+struct AccessValue {
+    uint64_t tag = 0;
+    std::array<uint64_t, 31> payload{};
+    bool operator==(const AccessValue &other) const { return tag == other.tag; }
+    bool operator!=(const AccessValue &other) const { return tag != other.tag; }
+};
+
+using Range = vvl::range<uint64_t>;
+using StdRangeMap = sparse_container::range_map<uint64_t, AccessValue>;
+using PooledRangeMap =
+    sparse_container::range_map<uint64_t, AccessValue, Range,
+                                std::map<Range, AccessValue, std::less<Range>,
+                                         vvl::node_pool_allocator<std::pair<const Range, AccessValue>>>>;
+// Small segments so that the access pattern below spreads over many of them and ranges cross segment boundaries
+using SegmentedRangeMap =
+    sparse_container::range_map<uint64_t, AccessValue, Range, sparse_container::segmented_map<Range, AccessValue, 12>>;
+
+template <typename Map>
+struct UpdateOps {
+    uint64_t tag;
+    void infill(Map &map, const typename Map::iterator &pos, const Range &range) const {
+        AccessValue value;
+        value.tag = tag;
+        map.insert(pos, std::make_pair(range, value));
+    }
+    void update(const typename Map::iterator &pos) const { pos->second.tag = tag; }
+};
+
+// Roughly what a frame of recorded commands does to an access map: whole resource writes, small sub-range
+// updates (buffer regions, image subresources) that split existing entries, and context copies that get merged back
+struct RecordedAccess {
+    Range range;
+    bool copy_and_merge;
+};
+
+std::vector<RecordedAccess> MakeAccessPattern(uint32_t count) {
+    constexpr uint64_t kResourceCount = 64;
+    constexpr uint64_t kResourceSize = 1 << 16;
+    std::vector<RecordedAccess> pattern;
+    pattern.reserve(count);
+    uint64_t seed = 0x9E3779B97F4A7C15ull;
+    auto next = [&seed]() {
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        return seed;
+    };
+    for (uint32_t i = 0; i < count; ++i) {
+        const uint64_t resource_base = (next() % kResourceCount) * kResourceSize;
+        const uint64_t kind = next() % 8;
+        Range range;
+        if (kind == 0) {
+            range = Range(resource_base, resource_base + kResourceSize);
+        } else {
+            const uint64_t begin = next() % kResourceSize;
+            const uint64_t size = 1 + next() % 2048;
+            range = Range(resource_base + begin, resource_base + std::min(begin + size, kResourceSize));
+        }
+        pattern.push_back({range, (i % 97) == 0});
+    }
+    return pattern;
+}
+
+template <typename Map>
+void Replay(Map &map, const std::vector<RecordedAccess> &pattern) {
+    uint64_t tag = 1;
+    for (const auto &access : pattern) {
+        if (access.copy_and_merge) {
+            // Child context style: copy, touch, splice back
+            Map child(map);
+            sparse_container::infill_update_range(child, access.range, UpdateOps<Map>{tag++});
+            sparse_container::splice(map, child, sparse_container::value_precedence::prefer_source);
+            sparse_container::consolidate(map);
+        } else {
+            sparse_container::infill_update_range(map, access.range, UpdateOps<Map>{tag++});
+        }
+    }
+}
+
+template <typename Map>
+int64_t TimeReplay(Map &map, const std::vector<RecordedAccess> &pattern) {
+    const auto start = std::chrono::steady_clock::now();
+    Replay(map, pattern);
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+}
+
+template <typename MapA, typename MapB>
+void ExpectSameEntries(const MapA &map_a, const MapB &map_b) {
+    ASSERT_EQ(map_a.size(), map_b.size());
+    auto it_a = map_a.cbegin();
+    for (auto it_b = map_b.cbegin(); it_b != map_b.cend(); ++it_b, ++it_a) {
+        ASSERT_EQ(it_a->first, it_b->first);
+        ASSERT_EQ(it_a->second.tag, it_b->second.tag);
+    }
+}
+
+}  // namespace
+
+TEST(RangeMap, PooledBackendMatchesStdMap) {
+    const auto pattern = MakeAccessPattern(20000);
+
+    StdRangeMap std_map;
+    PooledRangeMap pooled_map;
+    Replay(std_map, pattern);
+    Replay(pooled_map, pattern);
+
+    ExpectSameEntries(std_map, pooled_map);
+}
+
+TEST(RangeMap, PooledBackendCopyMoveSwap) {
+    const auto pattern = MakeAccessPattern(2000);
+
+    PooledRangeMap map;
+    Replay(map, pattern);
+    const auto size = map.size();
+
+    PooledRangeMap copy(map);
+    ASSERT_EQ(size, copy.size());
+    copy.clear();
+    ASSERT_EQ(size, map.size());
+
+    PooledRangeMap moved(std::move(map));
+    ASSERT_EQ(size, moved.size());
+    // The moved-from map must still be usable
+    map.clear();
+    sparse_container::infill_update_range(map, Range(0, 16), UpdateOps<PooledRangeMap>{1});
+    ASSERT_EQ(1u, map.size());
+
+    std::swap(map, moved);
+    ASSERT_EQ(size, map.size());
+    ASSERT_EQ(1u, moved.size());
+
+    copy = map;
+    ASSERT_EQ(size, copy.size());
+    moved = std::move(copy);
+    ASSERT_EQ(size, moved.size());
+}
+
+TEST(RangeMap, PooledBackendClearReleasesPool) {
+    const auto pattern = MakeAccessPattern(2000);
+
+    PooledRangeMap map;
+    const auto allocator = map.get_implementation_map().get_allocator();
+    ASSERT_EQ(0u, allocator.GetPool().Capacity());
+    Replay(map, pattern);
+    const size_t capacity = allocator.GetPool().Capacity();
+    ASSERT_GT(capacity, 0u);
+
+    // At most the first slab stays, for the MSVC sentinel node
+    map.clear();
+    ASSERT_LT(allocator.GetPool().Capacity(), capacity);
+    Replay(map, pattern);
+    ASSERT_EQ(capacity, allocator.GetPool().Capacity());
+}
+
+TEST(RangeMap, PooledBackendMovedFromOnOtherThread) {
+    const auto pattern = MakeAccessPattern(2000);
+
+    PooledRangeMap map;
+    Replay(map, pattern);
+    PooledRangeMap moved(std::move(map));
+    ASSERT_TRUE(map.get_implementation_map().get_allocator() == moved.get_implementation_map().get_allocator());
+
+    // Both maps allocate from the same pool at the same time
+    map.clear();
+    std::thread thread([&map, &pattern]() { Replay(map, pattern); });
+    Replay(moved, pattern);
+    thread.join();
+
+    StdRangeMap std_map;
+    Replay(std_map, pattern);
+    ExpectSameEntries(std_map, map);
+}
+
+TEST(RangeMap, NodePoolAllocatorEquality) {
+    // Every default constructed allocator has its own pool, copies share it
+    vvl::node_pool_allocator<AccessValue> allocator;
+    vvl::node_pool_allocator<AccessValue> other;
+    vvl::node_pool_allocator<AccessValue> copy(allocator);
+    ASSERT_TRUE(allocator != other);
+    ASSERT_TRUE(allocator == copy);
+
+    // Allocating doesn't change equality
+    AccessValue *node = allocator.allocate(1);
+    AccessValue *second = copy.allocate(1);
+    ASSERT_TRUE(allocator != other);
+    ASSERT_TRUE(allocator == copy);
+
+    // Rebound copies share the pool, which only serves the size of its first allocation
+    vvl::node_pool_allocator<uint64_t> rebound(allocator);
+    ASSERT_TRUE(rebound == allocator);
+    const size_t capacity = allocator.GetPool().Capacity();
+    uint64_t *small = rebound.allocate(1);
+    uint64_t *array = rebound.allocate(4);
+    ASSERT_EQ(capacity, allocator.GetPool().Capacity());
+    rebound.deallocate(array, 4);
+    rebound.deallocate(small, 1);
+
+    // Freed nodes are reused
+    copy.deallocate(second, 1);
+    ASSERT_EQ(second, allocator.allocate(1));
+    allocator.deallocate(second, 1);
+    allocator.deallocate(node, 1);
+}
+
+TEST(RangeMap, NodePoolReleasesSlabs) {
+    vvl::NodePool pool;
+    std::vector<void *> nodes;
+    for (uint32_t i = 0; i < 100; ++i) {
+        nodes.push_back(pool.Allocate(sizeof(AccessValue)));
+    }
+    const size_t capacity = pool.Capacity();
+    ASSERT_GE(capacity, 100 * sizeof(AccessValue));
+
+    // Erasing keeps the slabs, freeing the last node releases them
+    for (uint32_t i = 0; i < 99; ++i) {
+        ASSERT_TRUE(pool.Free(nodes[i], sizeof(AccessValue)));
+        ASSERT_EQ(capacity, pool.Capacity());
+    }
+    ASSERT_TRUE(pool.Free(nodes[99], sizeof(AccessValue)));
+    ASSERT_EQ(0u, pool.Capacity());
+
+    // Except for the first slab while its first node, as the MSVC sentinel node would be, is still in use
+    void *first = pool.Allocate(sizeof(AccessValue));
+    const size_t first_slab = pool.Capacity();
+    for (uint32_t i = 1; i < 100; ++i) {
+        nodes[i] = pool.Allocate(sizeof(AccessValue));
+    }
+    for (uint32_t i = 1; i < 100; ++i) {
+        ASSERT_TRUE(pool.Free(nodes[i], sizeof(AccessValue)));
+    }
+    ASSERT_EQ(first_slab, pool.Capacity());
+    ASSERT_NE(first, pool.Allocate(sizeof(AccessValue)));
+
+    // Other sizes are not served
+    ASSERT_EQ(nullptr, pool.Allocate(sizeof(uint64_t)));
+    ASSERT_FALSE(pool.Free(first, sizeof(uint64_t)));
+}
+
+TEST(RangeMap, SegmentedBackendMatchesStdMap) {
+    const auto pattern = MakeAccessPattern(20000);
+
+    StdRangeMap std_map;
+    SegmentedRangeMap segmented_map;
+    Replay(std_map, pattern);
+    Replay(segmented_map, pattern);
+
+    ExpectSameEntries(std_map, segmented_map);
+
+    // Walk back from the end, crossing all the segment boundaries
+    auto std_it = std_map.cend();
+    auto segmented_it = segmented_map.cend();
+    while (segmented_it != segmented_map.cbegin()) {
+        --std_it;
+        --segmented_it;
+        ASSERT_EQ(std_it->first, segmented_it->first);
+    }
+    ASSERT_EQ(std_map.cbegin(), std_it);
+
+    // Bounds of ranges that start in one segment and end in another
+    for (uint64_t begin = 0; begin < (64ull << 16); begin += 4000) {
+        const Range range(begin, begin + 5000);
+        const auto std_lower = std_map.lower_bound(range);
+        const auto segmented_lower = segmented_map.lower_bound(range);
+        ASSERT_EQ(std_lower == std_map.end(), segmented_lower == segmented_map.end());
+        if (std_lower != std_map.end()) {
+            ASSERT_EQ(std_lower->first, segmented_lower->first);
+        }
+        const auto std_upper = std_map.upper_bound(range);
+        const auto segmented_upper = segmented_map.upper_bound(range);
+        ASSERT_EQ(std_upper == std_map.end(), segmented_upper == segmented_map.end());
+        if (std_upper != std_map.end()) {
+            ASSERT_EQ(std_upper->first, segmented_upper->first);
+        }
+    }
+}
+
+TEST(RangeMap, SegmentedBackendEraseDropsEmptySegments) {
+    SegmentedRangeMap map;
+    // One range per segment, plus one covering several segments
+    for (uint64_t i = 0; i < 8; ++i) {
+        sparse_container::infill_update_range(map, Range(i << 12, (i << 12) + 16), UpdateOps<SegmentedRangeMap>{i + 1});
+    }
+    sparse_container::infill_update_range(map, Range(16 << 12, 20 << 12), UpdateOps<SegmentedRangeMap>{100});
+    ASSERT_EQ(9u, map.size());
+    ASSERT_EQ(9u, map.get_implementation_map().segment_count());
+
+    map.erase_range(Range(2 << 12, 6 << 12));
+    ASSERT_EQ(5u, map.size());
+    ASSERT_EQ(5u, map.get_implementation_map().segment_count());
+    // The range that started in segment 16 is still found from inside the later segments it covers
+    auto found = map.find(18 << 12);
+    ASSERT_NE(map.end(), found);
+    ASSERT_EQ(100u, found->second.tag);
+
+    map.erase(map.begin(), map.end());
+    ASSERT_TRUE(map.empty());
+    ASSERT_EQ(0u, map.get_implementation_map().segment_count());
+}
+
+TEST(RangeMap, SegmentedBackendCopyOnWrite) {
+    const auto pattern = MakeAccessPattern(2000);
+
+    SegmentedRangeMap map;
+    Replay(map, pattern);
+    sparse_container::consolidate(map);
+    const auto &segments = map.get_implementation_map();
+    const size_t segment_count = segments.segment_count();
+    ASSERT_EQ(0u, segments.shared_segment_count());
+
+    SegmentedRangeMap copy(map);
+    ASSERT_EQ(segment_count, segments.shared_segment_count());
+
+    // Reading through const iterators and consolidating an already consolidated map don't copy anything
+    const SegmentedRangeMap &const_copy = copy;
+    size_t entry_count = 0;
+    for (auto it = const_copy.begin(); it != const_copy.end(); ++it) {
+        ++entry_count;
+    }
+    ASSERT_EQ(map.size(), entry_count);
+    sparse_container::consolidate(copy);
+    ASSERT_EQ(segment_count, segments.shared_segment_count());
+
+    // Only the written segment and the few around it (walked through by mutable iterators looking for the entries that
+    // overlap the write) are copied, and the original doesn't see the write
+    const Range range(3 << 16, (3 << 16) + 64);
+    sparse_container::infill_update_range(copy, range, UpdateOps<SegmentedRangeMap>{~0ull});
+    ASSERT_LT(segments.shared_segment_count(), segment_count);
+    ASSERT_LE(segment_count - segments.shared_segment_count(), 4u);
+    ASSERT_NE(~0ull, map.find(range.begin)->second.tag);
+    ASSERT_EQ(~0ull, copy.find(range.begin)->second.tag);
+
+    // Undoing the write gives the same entries back
+    SegmentedRangeMap restored(copy);
+    restored.erase_range(range);
+    for (auto it = map.cbegin(); it != map.cend(); ++it) {
+        if (it->first.intersects(range)) {
+            const auto value = it->second;
+            sparse_container::infill_update_range(restored, it->first & range, UpdateOps<SegmentedRangeMap>{value.tag});
+        }
+    }
+    sparse_container::consolidate(restored);
+    ExpectSameEntries(map, restored);
+
+    copy.clear();
+    restored.clear();
+    ASSERT_EQ(0u, segments.shared_segment_count());
+}
+
+// Not a correctness test, records how long each backend takes on the same access pattern (--gtest_output=xml to see them)
+TEST(RangeMap, BackendReplayTimings) {
+    const auto pattern = MakeAccessPattern(20000);
+
+    StdRangeMap std_map;
+    PooledRangeMap pooled_map;
+    SegmentedRangeMap segmented_map;
+    RecordProperty("std_map_us", std::to_string(TimeReplay(std_map, pattern)));
+    RecordProperty("pooled_map_us", std::to_string(TimeReplay(pooled_map, pattern)));
+    RecordProperty("segmented_map_us", std::to_string(TimeReplay(segmented_map, pattern)));
+
+    ExpectSameEntries(std_map, pooled_map);
+    ExpectSameEntries(std_map, segmented_map);
+}
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2025 The Khronos Group Inc.
+ * Copyright (c) 2025 Valve Corporation
+ * Copyright (c) 2025 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ */
+
+#include "../framework/test_common.h"
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "containers/custom_containers.h"
+#include "containers/recording_arena.h"
+
+namespace {
+
+template <typename Key>
+using ArenaSet = vvl::unordered_set<Key, vvl::hash<Key>, std::equal_to<Key>, vvl::recording_arena_allocator<Key>>;
+template <typename Key, typename T>
+using ArenaMap =
+    vvl::unordered_map<Key, T, vvl::hash<Key>, std::equal_to<Key>, vvl::recording_arena_allocator<std::pair<const Key, T>>>;
+
+template <typename Container>
+void ResetWithArena(Container &container, vvl::RecordingArena *arena) {
+    container = Container(typename Container::allocator_type(arena));
+}
+
+}  // namespace
+
+TEST(RecordingArena, Alignment) {
+    vvl::RecordingArena arena;
+    for (size_t size = 1; size < 200; size += 7) {
+        void *p = arena.Allocate(size);
+        ASSERT_EQ(0u, reinterpret_cast<uintptr_t>(p) % alignof(std::max_align_t));
+    }
+}
+
+TEST(RecordingArena, RewindReusesMemory) {
+    vvl::RecordingArena arena;
+    void *first = arena.Allocate(64);
+    arena.Allocate(128);
+    const size_t capacity = arena.Capacity();
+
+    arena.Rewind();
+    ASSERT_EQ(first, arena.Allocate(64));
+    ASSERT_EQ(capacity, arena.Capacity());
+}
+
+TEST(RecordingArena, RewindMergesChunks) {
+    vvl::RecordingArena arena;
+    // Larger than the first chunk, so this takes several
+    for (uint32_t i = 0; i < 64; ++i) {
+        arena.Allocate(1024);
+    }
+    const size_t capacity = arena.Capacity();
+    ASSERT_GE(capacity, 64u * 1024u);
+
+    // The same amount fits in the single merged chunk, so nothing more is allocated
+    arena.Rewind();
+    ASSERT_EQ(capacity, arena.Capacity());
+    for (uint32_t i = 0; i < 64; ++i) {
+        arena.Allocate(1024);
+    }
+    ASSERT_EQ(capacity, arena.Capacity());
+}
+
+TEST(RecordingArena, AllocatorWithoutArena) {
+    // Default constructed allocators, as in local copies of the container types, use the heap
+    ArenaSet<uint32_t> set;
+    for (uint32_t i = 0; i < 1000; ++i) {
+        set.insert(i);
+    }
+    ASSERT_EQ(1000u, set.size());
+}
+
+TEST(RecordingArena, ContainersAcrossRewind) {
+    vvl::RecordingArena arena;
+    ArenaSet<uint32_t> set{ArenaSet<uint32_t>::allocator_type(&arena)};
+    ArenaMap<uint32_t, std::shared_ptr<int>> map{ArenaMap<uint32_t, std::shared_ptr<int>>::allocator_type(&arena)};
+    auto value = std::make_shared<int>(7);
+
+    size_t capacity = 0;
+    for (uint32_t recording = 0; recording < 4; ++recording) {
+        for (uint32_t i = 0; i < 500; ++i) {
+            set.insert(i + recording);
+            map.emplace(i, value);
+        }
+        ASSERT_EQ(500u, set.size());
+        ASSERT_TRUE(set.count(recording));
+        ASSERT_FALSE(set.count(recording + 500));
+        ASSERT_EQ(501, value.use_count());
+
+        // Copies don't point into the arena, so they can outlive the recording
+        auto set_copy = set;
+        ASSERT_EQ(ArenaSet<uint32_t>::allocator_type(), set_copy.get_allocator());
+
+        ResetWithArena(set, nullptr);
+        ResetWithArena(map, nullptr);
+        ASSERT_EQ(1, value.use_count());
+        arena.Rewind();
+        ResetWithArena(set, &arena);
+        ResetWithArena(map, &arena);
+        ASSERT_TRUE(set.empty());
+        ASSERT_EQ(500u, set_copy.size());
+
+        // After the first recording, re-recording the same contents fits in the memory already there
+        if (recording > 0) {
+            ASSERT_EQ(capacity, arena.Capacity());
+        }
+        capacity = arena.Capacity();
+    }
+}